@@ -0,0 +1,18 @@
+# Check if dynamic loading of shared libraries is available.
+include(CheckCSourceCompiles)
+set(CMAKE_REQUIRED_LIBRARIES ${CMAKE_DL_LIBS})
+CHECK_C_SOURCE_COMPILES(
+"
+#include <dlfcn.h>
+int main ()
+{
+  void *handle = dlopen (\"libfoo.so\", RTLD_NOW | RTLD_LOCAL);
+  (void) dlsym (handle, \"foo\");
+  (void) dlerror ();
+  (void) dlclose (handle);
+  return 0;
+}
+"
+HAVE_DLOPEN
+)
+unset(CMAKE_REQUIRED_LIBRARIES)
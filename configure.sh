@@ -21,6 +21,8 @@ minisat=unknown
 picosat=unknown
 cadical=unknown
 cms=unknown
+ipasir=unknown
+only_ipasir=no
 
 gcov=no
 gprof=no
@@ -74,12 +76,14 @@ can not be found.
   --no-lingeling         do not use Lingeling
   --no-minisat           do not use MiniSAT
   --no-picosat           do not use PicoSAT
+  --no-ipasir            do not support IPASIR SAT solvers loaded at runtime
 
   --only-cadical         only use CaDiCaL
   --only-cms             only use CryptoMiniSat
   --only-lingeling       only use Lingeling
   --only-minisat         only use MiniSAT
   --only-picosat         only use PicoSAT
+  --only-ipasir          only use IPASIR SAT solvers loaded at runtime
 EOF
   exit 0
 }
@@ -142,12 +146,14 @@ do
     --no-lingeling) lingeling=no;;
     --no-minisat)   minisat=no;;
     --no-picosat)   picosat=no;;
+    --no-ipasir)    ipasir=no;;
 
     --only-cadical)   lingeling=no;minisat=no;picosat=no;cadical=yes;cms=no;;
     --only-cms)       lingeling=no;minisat=no;picosat=no;cadical=no;cms=yes;;
     --only-lingeling) lingeling=yes;minisat=no;picosat=no;cadical=no;cms=no;;
     --only-minisat)   lingeling=no;minisat=yes;picosat=no;cadical=no;cms=no;;
     --only-picosat)   lingeling=no;minisat=no;picosat=yes;cadical=no;cms=no;;
+    --only-ipasir)    only_ipasir=yes;;
 
     -*) die "invalid option '$opt' (try '-h')";;
   esac
@@ -181,6 +187,8 @@ cmake_opts="$CMAKE_OPTS"
 [ $lingeling = no ] && cmake_opts="$cmake_opts -DUSE_LINGELING=OFF"
 [ $minisat = no ] && cmake_opts="$cmake_opts -DUSE_MINISAT=OFF"
 [ $picosat = no ] && cmake_opts="$cmake_opts -DUSE_PICOSAT=OFF"
+[ $ipasir = no ] && cmake_opts="$cmake_opts -DUSE_IPASIR=OFF"
+[ $only_ipasir = yes ] && cmake_opts="$cmake_opts -DONLY_IPASIR=ON"
 
 [ $gcov = yes ] && cmake_opts="$cmake_opts -DGCOV=ON"
 [ $gprof = yes ] && cmake_opts="$cmake_opts -DGPROF=ON"
@@ -0,0 +1,62 @@
+#!/bin/bash
+
+# Compare the divider circuit and the multiplier based encoding of
+# udiv/urem (--udiv-mul-encode) on the isqrt and icbrt newton benchmarks
+# in examples/generators.
+
+die ()
+{
+  echo "*** $(basename $0): $*" 1>&2
+  exit 1
+}
+
+BOOLECTOR=""
+WIDTHS="8 12 16"
+TIMEOUT=300
+TMPFILE=/tmp/btordivbench-$$.btor
+GENDIR=$(dirname $0)/../examples/generators
+
+trap "rm -f $TMPFILE; exit 2" SIGHUP SIGINT SIGTERM
+
+while [ $# -gt 0 ]
+do
+  case $1 in
+    -h|--help)
+      echo "usage: $(basename $0) [-w <widths>] [-t <seconds>] <boolector-binary>"
+      exit 0
+      ;;
+    -w) shift; WIDTHS="$1" ;;
+    -t) shift; TIMEOUT="$1" ;;
+    -*) die "invalid option '$1'" ;;
+    *) BOOLECTOR=$1 ;;
+  esac
+  shift
+done
+
+[ -z "$BOOLECTOR" ] && die "boolector binary missing"
+[ -x "$BOOLECTOR" ] || die "'$BOOLECTOR' is not executable"
+
+printf "%-8s %6s %10s %10s\n" "bench" "width" "divider" "mul"
+for gen in isqrt/isqrt5.sh icbrt/icbrt5.sh
+do
+  for w in $WIDTHS
+  do
+    bash $GENDIR/$gen $w > $TMPFILE || die "generating '$gen' failed"
+    line=$(printf "%-8s %6s" $(basename $gen .sh) $w)
+    for enc in 0 1
+    do
+      start=$(date +%s.%N)
+      timeout $TIMEOUT $BOOLECTOR --udiv-mul-encode=$enc $TMPFILE > /dev/null
+      res=$?
+      end=$(date +%s.%N)
+      if [ $res -eq 10 -o $res -eq 20 ]
+      then
+        line="$line $(awk "BEGIN { printf \"%10.2f\", $end - $start }")"
+      else
+        line="$line $(printf "%10s" "-")"
+      fi
+    done
+    echo "$line"
+  done
+done
+rm -f $TMPFILE
@@ -0,0 +1,74 @@
+#!/bin/bash
+# integer cube root via newton iteration y' = (2y + x / y^2) / 3 starting
+# from y = 2^ceil(w/3), and a postcondition that uses both x / y^2 and
+# x % y^2
+# we show that 0 < x < 2^(w-2)   =>   y^3 <= x < (y+1)^3
+# where y^3 <= x   <=>   x / y^2 >= y
+#   and (y+1)^3 > x   <=>   (x / y^2 - y) * y^2 + x % y^2 <= 3y^2 + 3y
+# usage: icbrt5.sh [<width>] (default 16)
+
+w=${1:-16}
+
+id=1
+echo "$((id++)) var $w x"
+((idx = id - 1))
+echo "$((id++)) constd $w 3"
+((id3 = id - 1))
+echo "$((id++)) constd $w 6"
+((id6 = id - 1))
+echo "$((id++)) constd $w $((1 << ((w + 2) / 3)))"
+((idy = id - 1))
+for ((i = 0; i < w; i++))
+do
+  echo "$((id++)) mul $w $idy $idy"
+  ((idyy = id - 1))
+  echo "$((id++)) udiv $w $idx $idyy"
+  ((lastid = id - 1))
+  echo "$((id++)) add $w $idy $idy"
+  ((idy2 = id - 1))
+  echo "$((id++)) add $w $idy2 $lastid"
+  ((lastid = id - 1))
+  echo "$((id++)) udiv $w $lastid $id3"
+  ((idyn = id - 1))
+  echo "$((id++)) ult 1 $idyn $idy"
+  ((idcond = id - 1))
+  echo "$((id++)) cond $w $idcond $idyn $idy"
+  ((idy = id - 1))
+done
+echo "$((id++)) mul $w $idy $idy"
+((idyy = id - 1))
+echo "$((id++)) udiv $w $idx $idyy"
+((idq = id - 1))
+echo "$((id++)) urem $w $idx $idyy"
+((idr = id - 1))
+echo "$((id++)) ugte 1 $idq $idy"
+((idlow = id - 1))
+echo "$((id++)) sub $w $idq $idy"
+((iddiff = id - 1))
+echo "$((id++)) ulte 1 $iddiff $id6"
+((idsmall = id - 1))
+echo "$((id++)) mul $w $iddiff $idyy"
+((lastid = id - 1))
+echo "$((id++)) add $w $lastid $idr"
+((idlhs = id - 1))
+echo "$((id++)) add $w $idyy $idy"
+((lastid = id - 1))
+echo "$((id++)) mul $w $lastid $id3"
+((idrhs = id - 1))
+echo "$((id++)) ulte 1 $idlhs $idrhs"
+((idhigh = id - 1))
+echo "$((id++)) and 1 $idsmall $idhigh"
+((lastid = id - 1))
+echo "$((id++)) and 1 $idlow $lastid"
+((idpost = id - 1))
+echo "$((id++)) slice 2 $idx $((w - 1)) $((w - 2))"
+((lastid = id - 1))
+echo "$((id++)) redor 1 $lastid"
+((idlarge = id - 1))
+echo "$((id++)) redor 1 $idx"
+((idnz = id - 1))
+echo "$((id++)) and 1 -$idlarge $idnz"
+((idpre = id - 1))
+echo "$((id++)) implies 1 $idpre $idpost"
+((lastid = id - 1))
+echo "$((id++)) root 1 -$lastid"
@@ -0,0 +1,64 @@
+#!/bin/bash
+# integer square root via newton iteration y' = (y + x / y) / 2 starting
+# from y = x, and a postcondition that uses both x / y and x % y
+# we show that 0 < x < 2^(w-2)   =>   y^2 <= x < (y+1)^2
+# where y^2 <= x   <=>   x / y >= y
+#   and (y+1)^2 > x   <=>   (x / y - y) * y + x % y <= 2y
+# usage: isqrt5.sh [<width>] (default 16)
+
+w=${1:-16}
+
+id=1
+echo "$((id++)) var $w x"
+((idx = id - 1))
+echo "$((id++)) one $w"
+((id1 = id - 1))
+echo "$((id++)) constd $w 2"
+((id2 = id - 1))
+idy=$idx
+for ((i = 0; i < w; i++))
+do
+  echo "$((id++)) udiv $w $idx $idy"
+  ((lastid = id - 1))
+  echo "$((id++)) add $w $idy $lastid"
+  ((lastid = id - 1))
+  echo "$((id++)) udiv $w $lastid $id2"
+  ((idyn = id - 1))
+  echo "$((id++)) ult 1 $idyn $idy"
+  ((idcond = id - 1))
+  echo "$((id++)) cond $w $idcond $idyn $idy"
+  ((idy = id - 1))
+done
+echo "$((id++)) udiv $w $idx $idy"
+((idq = id - 1))
+echo "$((id++)) urem $w $idx $idy"
+((idr = id - 1))
+echo "$((id++)) ugte 1 $idq $idy"
+((idlow = id - 1))
+echo "$((id++)) sub $w $idq $idy"
+((iddiff = id - 1))
+echo "$((id++)) ulte 1 $iddiff $id2"
+((idsmall = id - 1))
+echo "$((id++)) mul $w $iddiff $idy"
+((lastid = id - 1))
+echo "$((id++)) add $w $lastid $idr"
+((idlhs = id - 1))
+echo "$((id++)) add $w $idy $idy"
+((idrhs = id - 1))
+echo "$((id++)) ulte 1 $idlhs $idrhs"
+((idhigh = id - 1))
+echo "$((id++)) and 1 $idsmall $idhigh"
+((lastid = id - 1))
+echo "$((id++)) and 1 $idlow $lastid"
+((idpost = id - 1))
+echo "$((id++)) slice 2 $idx $((w - 1)) $((w - 2))"
+((lastid = id - 1))
+echo "$((id++)) redor 1 $lastid"
+((idlarge = id - 1))
+echo "$((id++)) redor 1 $idx"
+((idnz = id - 1))
+echo "$((id++)) and 1 -$idlarge $idnz"
+((idpre = id - 1))
+echo "$((id++)) implies 1 $idpre $idpost"
+((lastid = id - 1))
+echo "$((id++)) root 1 -$lastid"
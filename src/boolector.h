@@ -392,6 +392,8 @@ int32_t boolector_simplify (Btor *btor);
   Currently, we support ``Lingeling``, ``PicoSAT``, and ``MiniSAT`` as string
   value of ``solver`` (case insensitive).  This is however
   only possible if the corresponding solvers were enabled at compile time.
+  Value ``IPASIR`` selects the IPASIR shared library given by environment
+  variable ``BTORIPASIRLIB``, which is loaded at runtime.
   Call this function after boolector_new.
 
   :param btor: Boolector instance
@@ -15,6 +15,7 @@
 #include "btorcore.h"
 #include "btorsat.h"
 #include "utils/btoraigmap.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btorutil.h"
 
@@ -799,6 +800,8 @@ btor_aig_mgr_new (Btor *btor)
   assert ((size_t) BTOR_AIG_FALSE == 0);
   assert ((size_t) BTOR_AIG_TRUE == 1);
   BTOR_INIT_STACK (btor->mm, amgr->cnfid2aig);
+  BTOR_INIT_STACK (btor->mm, amgr->assumption_aigs);
+  BTOR_INIT_STACK (btor->mm, amgr->assumption_roots);
   return amgr;
 }
 
@@ -822,6 +825,22 @@ clone_aig (BtorMemMgr *mm, BtorAIG *aig)
   return res;
 }
 
+static void
+clone_id_stack (BtorMemMgr *mm, BtorIntStack *clone, BtorIntStack *stack)
+{
+  size_t size = BTOR_SIZE_STACK (*stack);
+  size_t cnt  = BTOR_COUNT_STACK (*stack);
+
+  BTOR_INIT_STACK (mm, *clone);
+  if (size)
+  {
+    BTOR_NEWN (mm, clone->start, size);
+    clone->end = clone->start + size;
+    clone->top = clone->start + cnt;
+    memcpy (clone->start, stack->start, cnt * sizeof (int32_t));
+  }
+}
+
 static void
 clone_aigs (BtorAIGMgr *amgr, BtorAIGMgr *clone)
 {
@@ -873,6 +892,9 @@ clone_aigs (BtorAIGMgr *amgr, BtorAIGMgr *clone)
           == BTOR_SIZE_STACK (amgr->cnfid2aig));
   assert (BTOR_COUNT_STACK (clone->cnfid2aig)
           == BTOR_COUNT_STACK (amgr->cnfid2aig));
+
+  clone_id_stack (mm, &clone->assumption_aigs, &amgr->assumption_aigs);
+  clone_id_stack (mm, &clone->assumption_roots, &amgr->assumption_roots);
 }
 
 BtorAIGMgr *
@@ -896,6 +918,7 @@ btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr)
   res->num_cnf_vars     = amgr->num_cnf_vars;
   res->num_cnf_clauses  = amgr->num_cnf_clauses;
   res->num_cnf_literals = amgr->num_cnf_literals;
+  res->num_cnf_vars_retired = amgr->num_cnf_vars_retired;
   clone_aigs (amgr, res);
   return res;
 }
@@ -912,6 +935,9 @@ btor_aig_mgr_delete (BtorAIGMgr *amgr)
   btor_sat_mgr_delete (amgr->smgr);
   BTOR_RELEASE_STACK (amgr->id2aig);
   BTOR_RELEASE_STACK (amgr->cnfid2aig);
+  BTOR_RELEASE_STACK (amgr->assumption_aigs);
+  BTOR_RELEASE_STACK (amgr->assumption_roots);
+  if (amgr->eval_cache) btor_hashint_map_delete (amgr->eval_cache);
   BTOR_DELETE (mm, amgr);
 }
 
@@ -1341,6 +1367,114 @@ btor_aig_to_sat (BtorAIGMgr *amgr, BtorAIG *aig)
   if (!btor_aig_is_const (aig)) aig_to_sat_tseitin (amgr, aig);
 }
 
+void
+btor_aig_assumption_to_sat (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  assert (amgr);
+
+  int32_t cnf_id, maxvar, id;
+
+  if (!btor_sat_is_initialized (amgr->smgr)) return;
+  if (btor_aig_is_const (aig)) return;
+
+  maxvar = amgr->smgr->maxvar;
+  aig_to_sat_tseitin (amgr, aig);
+  if (!btor_opt_get (amgr->btor, BTOR_OPT_LAZY_ENCODE)) return;
+
+  /* Record all AIGs that got a CNF id for this assumption. Note that AIGs
+   * only referenced within the cone already released their CNF id. */
+  for (cnf_id = maxvar + 1; cnf_id <= amgr->smgr->maxvar; cnf_id++)
+  {
+    if ((size_t) cnf_id >= BTOR_SIZE_STACK (amgr->cnfid2aig)) break;
+    id = amgr->cnfid2aig.start[cnf_id];
+    if (id && btor_aig_is_and (BTOR_PEEK_STACK (amgr->id2aig, id)))
+      BTOR_PUSH_STACK (amgr->assumption_aigs, id);
+  }
+}
+
+static bool
+update_assumption_roots (BtorAIGMgr *amgr, BtorAIGPtrStack *roots)
+{
+  size_t i;
+  bool changed;
+
+  qsort (roots->start,
+         BTOR_COUNT_STACK (*roots),
+         sizeof (BtorAIG *),
+         btor_compare_aig_by_id_qsort_asc);
+
+  changed = BTOR_COUNT_STACK (*roots)
+            != BTOR_COUNT_STACK (amgr->assumption_roots);
+  for (i = 0; !changed && i < BTOR_COUNT_STACK (*roots); i++)
+    changed = BTOR_REAL_ADDR_AIG (BTOR_PEEK_STACK (*roots, i))->id
+              != BTOR_PEEK_STACK (amgr->assumption_roots, i);
+  if (!changed) return false;
+
+  BTOR_RESET_STACK (amgr->assumption_roots);
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+    BTOR_PUSH_STACK (amgr->assumption_roots,
+                     BTOR_REAL_ADDR_AIG (BTOR_PEEK_STACK (*roots, i))->id);
+  return true;
+}
+
+uint32_t
+btor_aig_retire_assumption_cones (BtorAIGMgr *amgr, BtorAIGPtrStack *roots)
+{
+  assert (amgr);
+  assert (roots);
+
+  uint32_t res;
+  size_t i, j;
+  int32_t id;
+  BtorAIG *cur;
+  BtorAIGPtrStack stack;
+  BtorIntHashTable *cone;
+
+  if (amgr->smgr->have_restore) return 0;
+  if (!update_assumption_roots (amgr, roots)) return 0;
+  if (BTOR_EMPTY_STACK (amgr->assumption_aigs)) return 0;
+
+  /* mark cone of current assumptions */
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  cone = btor_hashint_table_new (amgr->btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+    BTOR_PUSH_STACK (stack, BTOR_PEEK_STACK (*roots, i));
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_REAL_ADDR_AIG (BTOR_POP_STACK (stack));
+    if (!btor_aig_is_and (cur)) continue;
+    if (btor_hashint_table_contains (cone, cur->id)) continue;
+    btor_hashint_table_add (cone, cur->id);
+    BTOR_PUSH_STACK (stack, btor_aig_get_right_child (amgr, cur));
+    BTOR_PUSH_STACK (stack, btor_aig_get_left_child (amgr, cur));
+  }
+
+  /* Retire AIGs outside of the cone. Clauses that still refer to their
+   * (melted) CNF ids remain valid, if such an AIG is needed again it gets
+   * encoded with a fresh CNF id. */
+  res = 0;
+  for (i = 0, j = 0; i < BTOR_COUNT_STACK (amgr->assumption_aigs); i++)
+  {
+    id  = BTOR_PEEK_STACK (amgr->assumption_aigs, i);
+    cur = BTOR_PEEK_STACK (amgr->id2aig, id);
+    if (!cur || !cur->cnf_id) continue;
+    if (btor_hashint_table_contains (cone, id))
+    {
+      BTOR_POKE_STACK (amgr->assumption_aigs, j, id);
+      j++;
+      continue;
+    }
+    release_cnf_id_aig_mgr (amgr, cur);
+    res++;
+  }
+  amgr->assumption_aigs.top = amgr->assumption_aigs.start + j;
+  amgr->num_cnf_vars_retired += res;
+
+  btor_hashint_table_delete (cone);
+  BTOR_RELEASE_STACK (stack);
+  return res;
+}
+
 void
 btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
 {
@@ -1467,6 +1601,101 @@ btor_aig_get_sat_mgr (const BtorAIGMgr *amgr)
   return amgr ? amgr->smgr : 0;
 }
 
+/* Evaluate AIG without CNF id under the current assignment of the (encoded)
+ * AIGs in its cone. */
+static int32_t
+eval_aig (BtorAIGMgr *amgr, BtorAIG *root)
+{
+  assert (amgr);
+  assert (btor_aig_is_and (root));
+  assert (!root->cnf_id);
+
+  int32_t i, val[2], res;
+  bool pushed;
+  BtorAIG *cur, *child;
+  BtorAIGPtrStack stack;
+  BtorIntHashTable *cache;
+  BtorMemMgr *mm;
+
+  mm = amgr->btor->mm;
+
+  /* model generation queries every bit of every node, values are cached
+   * until the SAT solver is called again */
+  if (amgr->eval_cache && amgr->eval_satcalls != amgr->smgr->satcalls)
+  {
+    btor_hashint_map_delete (amgr->eval_cache);
+    amgr->eval_cache = 0;
+  }
+  if (!amgr->eval_cache)
+  {
+    amgr->eval_cache    = btor_hashint_map_new (mm);
+    amgr->eval_satcalls = amgr->smgr->satcalls;
+  }
+  cache = amgr->eval_cache;
+
+  if (btor_hashint_map_contains (cache, root->id))
+    return btor_hashint_map_get (cache, root->id)->as_int;
+
+  BTOR_INIT_STACK (mm, stack);
+
+  BTOR_PUSH_STACK (stack, root);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_TOP_STACK (stack);
+    assert (BTOR_IS_REGULAR_AIG (cur));
+
+    if (btor_hashint_map_contains (cache, cur->id))
+    {
+      (void) BTOR_POP_STACK (stack);
+      continue;
+    }
+
+    if (cur->cnf_id > 0 || !btor_aig_is_and (cur))
+    {
+      /* Unassigned inputs are false (-1) as in the model. This has to be
+       * fixed before the value is negated for inverted references. */
+      res = cur->cnf_id > 0 ? btor_sat_deref (amgr->smgr, cur->cnf_id) : 0;
+      if (res == 0) res = -1;
+      btor_hashint_map_add (cache, cur->id)->as_int = res;
+      (void) BTOR_POP_STACK (stack);
+      continue;
+    }
+
+    pushed = false;
+    for (i = 0; i < 2; i++)
+    {
+      child = BTOR_REAL_ADDR_AIG (btor_aig_get_by_id (amgr, cur->children[i]));
+      if (btor_aig_is_const (child)) continue;
+      if (!btor_hashint_map_contains (cache, child->id))
+      {
+        BTOR_PUSH_STACK (stack, child);
+        pushed = true;
+      }
+    }
+    if (pushed) continue;
+
+    (void) BTOR_POP_STACK (stack);
+    for (i = 0; i < 2; i++)
+    {
+      child = btor_aig_get_by_id (amgr, cur->children[i]);
+      if (btor_aig_is_const (child))
+        val[i] = child == BTOR_AIG_TRUE ? 1 : -1;
+      else
+      {
+        val[i] = btor_hashint_map_get (cache, BTOR_REAL_ADDR_AIG (child)->id)
+                     ->as_int;
+        if (BTOR_IS_INVERTED_AIG (child)) val[i] = -val[i];
+      }
+    }
+    btor_hashint_map_add (cache, cur->id)->as_int =
+        val[0] == 1 && val[1] == 1 ? 1 : -1;
+  }
+
+  res = btor_hashint_map_get (cache, root->id)->as_int;
+  BTOR_RELEASE_STACK (stack);
+  return res;
+}
+
 int32_t
 btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
 {
@@ -1485,6 +1714,11 @@ btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
       val = -1;
     }
   }
+  else if (btor_aig_is_and (BTOR_REAL_ADDR_AIG (aig))
+           && btor_opt_get (amgr->btor, BTOR_OPT_LAZY_ENCODE))
+  {
+    val = eval_aig (amgr, BTOR_REAL_ADDR_AIG (aig));
+  }
   return BTOR_IS_INVERTED_AIG (aig) ? -val : val;
 }
 
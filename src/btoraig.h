@@ -15,6 +15,7 @@
 #include "btoropt.h"
 #include "btorsat.h"
 #include "btortypes.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btormem.h"
 #include "utils/btorstack.h"
@@ -59,6 +60,13 @@ struct BtorAIGMgr
   BtorAIGPtrStack id2aig; /* id to AIG node */
   BtorIntStack cnfid2aig; /* cnf id to AIG id */
 
+  /* lazy encoding (BTOR_OPT_LAZY_ENCODE) */
+  BtorIntStack assumption_aigs;  /* ids of AIGs encoded for assumptions */
+  BtorIntStack assumption_roots; /* ids of current assumptions (sorted) */
+  BtorIntHashTable *eval_cache;  /* values of ANDs without CNF id under the
+                                    model of SAT call 'eval_satcalls' */
+  int32_t eval_satcalls;
+
   uint_least64_t cur_num_aigs;     /* current number of ANDs */
   uint_least64_t cur_num_aig_vars; /* current number of AIG variables */
 
@@ -68,6 +76,7 @@ struct BtorAIGMgr
   uint_least64_t num_cnf_vars;
   uint_least64_t num_cnf_clauses;
   uint_least64_t num_cnf_literals;
+  uint_least64_t num_cnf_vars_retired;
 };
 
 typedef struct BtorAIGMgr BtorAIGMgr;
@@ -211,6 +220,19 @@ void btor_aig_to_sat (BtorAIGMgr *amgr, BtorAIG *aig);
  */
 void btor_aig_add_toplevel_to_sat (BtorAIGMgr *, BtorAIG *);
 
+/* As 'btor_aig_to_sat' for AIGs that are only assumed. With lazy encoding
+ * enabled, the newly encoded AIGs are recorded and may later be retired
+ * by 'btor_aig_retire_assumption_cones'.
+ */
+void btor_aig_assumption_to_sat (BtorAIGMgr *amgr, BtorAIG *aig);
+
+/* Releases the CNF ids of all recorded assumption AIGs that are not in the
+ * cone of the current assumptions 'roots'. Does nothing if 'roots' did not
+ * change since the last call. Returns the number of released CNF ids.
+ */
+uint32_t btor_aig_retire_assumption_cones (BtorAIGMgr *amgr,
+                                           BtorAIGPtrStack *roots);
+
 /* Translates AIG into SAT instance in both phases.
  * The function guarantees that after finishing every reachable AIG
  * has a CNF id.
@@ -218,6 +240,8 @@ void btor_aig_add_toplevel_to_sat (BtorAIGMgr *, BtorAIG *);
 void btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *aig);
 
 /* Gets current assignment of AIG aig (in the SAT case).
+ * With lazy encoding enabled, the assignment of AIGs without CNF id is
+ * computed from the assignment of their children.
  */
 int32_t btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig);
 
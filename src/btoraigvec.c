@@ -298,260 +298,158 @@ btor_aigvec_add (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
   return result;
 }
 
+/* Shift av left by n bits if 'shift' is true, keep it if 'keep' is true,
+ * and yield 0 if both are false. */
 static BtorAIGVec *
 sll_n_bits_aigvec (BtorAIGVecMgr *avmgr,
                    BtorAIGVec *av,
                    uint32_t n,
-                   BtorAIG *shift)
+                   BtorAIG *shift,
+                   BtorAIG *keep)
 {
   BtorAIGMgr *amgr;
   BtorAIGVec *result;
-  BtorAIG *and1, *and2, *not_shift;
+  BtorAIG *and1, *and2;
   uint32_t i, j, width;
   assert (avmgr);
   assert (av);
   assert (av->width > 0);
+  assert (n > 0);
   assert (n < av->width);
-  if (n == 0) return btor_aigvec_copy (avmgr, av);
-  amgr      = avmgr->amgr;
-  width     = av->width;
-  not_shift = btor_aig_not (amgr, shift);
-  result    = new_aigvec (avmgr, width);
+  amgr   = avmgr->amgr;
+  width  = av->width;
+  result = new_aigvec (avmgr, width);
   for (i = 0; i < width - n; i++)
   {
-    and1            = btor_aig_and (amgr, av->aigs[i], not_shift);
+    and1            = btor_aig_and (amgr, av->aigs[i], keep);
     and2            = btor_aig_and (amgr, av->aigs[i + n], shift);
     result->aigs[i] = btor_aig_or (amgr, and1, and2);
     btor_aig_release (amgr, and1);
     btor_aig_release (amgr, and2);
   }
   for (j = width - n; j < width; j++)
-    result->aigs[j] = btor_aig_and (amgr, av->aigs[j], not_shift);
-  btor_aig_release (amgr, not_shift);
-  return result;
-}
-
-static BtorAIGVec *
-translate_shift (BtorAIGVecMgr *avmgr,
-                 BtorAIGVec *av1,
-                 BtorAIGVec *av2,
-                 BtorAIGVec *(*fun) (BtorAIGVecMgr *,
-                                     BtorAIGVec *,
-                                     BtorAIGVec *) )
-{
-  assert (avmgr);
-  assert (av1);
-  assert (av2);
-  assert (av1->width);
-  assert (av2->width);
-
-  BtorAIGVec *res, *av_cond, *av_then, *av_else;
-  BtorAIGVec *tmp, *zero, *upper2, *lower2, *av1_new, *av2_new;
-  uint32_t width, pow2, width_shift, delta1, delta2;
-
-  width = av1->width;
-
-  /* When represented as AIG vectors, we require that the vector to be shifted
-   * has a power of 2 width, and the shift width is log2 of this width. The
-   * given vectors av1 and av2 have the same bit-width, which is not necessarily
-   * a power of 2. Hence the requirement for translation.
-   *
-   * First, we determine the smallest power of 2 that is greater/equal than
-   * the bit-width of the given AIG vectors such that width_shift = log2 (pow2).
-   */
-  for (pow2 = 1, width_shift = 0; pow2 < width; pow2 *= 2) width_shift++;
-  assert (pow2 == (1u << width_shift));
-
-  if (width == 1)
-  {
-    assert (pow2 == 1);
-    assert (width_shift == 0);
-
-    tmp = btor_aigvec_not (avmgr, av2);
-    res = btor_aigvec_and (avmgr, av1, tmp);
-    btor_aigvec_release_delete (avmgr, tmp);
-  }
-  else
-  {
-    assert (width > 1);
-    assert (width <= pow2);
-
-    /* the delta (in # bits) for 'pow2' and 'width' */
-    delta1 = pow2 - width;
-    /* the delta (in # bits) for 'width' and 'width_shift' (= log2(pow2)) */
-    delta2 = width - width_shift;
-
-    assert (width_shift > 0);
-
-    upper2 = btor_aigvec_slice (avmgr, av2, width - 1, width - delta2);
-    lower2 = btor_aigvec_slice (avmgr, av2, width_shift - 1, 0);
-
-    assert (upper2->width == delta2);
-    assert (lower2->width == width_shift);
-
-    /**
-     * if shift width is >= bit-width, result is 0
-     * -> we translate given shift to
-     *        ite (shift width >= bit-width, 0, shift (av1_new, av2_new))
-     * where
-     *   - 'shift' is the given shift function (sll, srl) and
-     *   - 'av1_new' and 'av2_new' are the given vectors converted to the
-     *     required widths 'pow2' and 'width_shift'.
-     */
-
-    /* condition for ite */
-    if (delta2 > 1)
-    {
-      /* 0_[upper2->width] */
-      zero = btor_aigvec_zero (avmgr, delta2);
-      /* redor: ~(0_[upper2->width] = upper2) */
-      tmp     = btor_aigvec_eq (avmgr, zero, upper2);
-      av_cond = btor_aigvec_not (avmgr, tmp);
-      btor_aigvec_release_delete (avmgr, tmp);
-      btor_aigvec_release_delete (avmgr, zero);
-    }
-    else
-    {
-      av_cond = btor_aigvec_copy (avmgr, upper2);
-    }
-    btor_aigvec_release_delete (avmgr, upper2);
-
-    /* then branch for ite */
-    av_then = btor_aigvec_zero (avmgr, width);
-
-    /* else branch for ite */
-    if (!delta1)
-    {
-      av1_new = btor_aigvec_copy (avmgr, av1);
-    }
-    else
-    {
-      tmp     = btor_aigvec_zero (avmgr, delta1);
-      av1_new = btor_aigvec_concat (avmgr, tmp, av1);
-      btor_aigvec_release_delete (avmgr, tmp);
-    }
-    assert (av1_new->width == pow2);
-    av2_new = lower2;
-    av_else = fun (avmgr, av1_new, av2_new);
-    btor_aigvec_release_delete (avmgr, av1_new);
-    btor_aigvec_release_delete (avmgr, av2_new);
-    if (delta1 > 0)
-    {
-      tmp = btor_aigvec_slice (avmgr, av_else, width - 1, 0);
-      btor_aigvec_release_delete (avmgr, av_else);
-      av_else = tmp;
-    }
-
-    res = btor_aigvec_cond (avmgr, av_cond, av_then, av_else);
-
-    btor_aigvec_release_delete (avmgr, av_cond);
-    btor_aigvec_release_delete (avmgr, av_then);
-    btor_aigvec_release_delete (avmgr, av_else);
-  }
-  return res;
-}
-
-static BtorAIGVec *
-aigvec_sll (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
-{
-  assert (avmgr);
-  assert (av1);
-  assert (av2);
-  assert (av1->width);
-  assert (btor_util_is_power_of_2 (av1->width));
-  assert (btor_util_log_2 (av1->width) == av2->width);
-
-  BtorAIGVec *result, *temp;
-  uint32_t i, j, width;
-
-  width  = av2->width;
-  result = sll_n_bits_aigvec (avmgr, av1, 1, av2->aigs[av2->width - 1]);
-  for (j = 2, i = width - 2; j <= width; j++, i--)
-  {
-    temp   = result;
-    result = sll_n_bits_aigvec (
-        avmgr, temp, btor_util_pow_2 (width - i - 1), av2->aigs[i]);
-    btor_aigvec_release_delete (avmgr, temp);
-  }
+    result->aigs[j] = btor_aig_and (amgr, av->aigs[j], keep);
   return result;
 }
 
-BtorAIGVec *
-btor_aigvec_sll (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
-{
-  assert (avmgr);
-  assert (av1);
-  assert (av2);
-  assert (av1->width);
-  assert (av1->width == av2->width);
-  return translate_shift (avmgr, av1, av2, aigvec_sll);
-}
-
+/* Shift av right by n bits if 'shift' is true, keep it if 'keep' is true,
+ * and yield 0 if both are false. */
 static BtorAIGVec *
 srl_n_bits_aigvec (BtorAIGVecMgr *avmgr,
                    BtorAIGVec *av,
                    uint32_t n,
-                   BtorAIG *shift)
+                   BtorAIG *shift,
+                   BtorAIG *keep)
 {
   BtorAIGMgr *amgr;
   BtorAIGVec *result;
-  BtorAIG *and1, *and2, *not_shift;
+  BtorAIG *and1, *and2;
   uint32_t i, width;
   assert (avmgr);
   assert (av);
   assert (av->width > 0);
+  assert (n > 0);
   assert (n < av->width);
-  if (n == 0) return btor_aigvec_copy (avmgr, av);
-  amgr      = avmgr->amgr;
-  width     = av->width;
-  not_shift = btor_aig_not (amgr, shift);
-  result    = new_aigvec (avmgr, width);
+  amgr   = avmgr->amgr;
+  width  = av->width;
+  result = new_aigvec (avmgr, width);
   for (i = 0; i < n; i++)
-    result->aigs[i] = btor_aig_and (amgr, av->aigs[i], not_shift);
+    result->aigs[i] = btor_aig_and (amgr, av->aigs[i], keep);
   for (i = n; i < width; i++)
   {
-    and1            = btor_aig_and (amgr, av->aigs[i], not_shift);
+    and1            = btor_aig_and (amgr, av->aigs[i], keep);
     and2            = btor_aig_and (amgr, av->aigs[i - n], shift);
     result->aigs[i] = btor_aig_or (amgr, and1, and2);
     btor_aig_release (amgr, and1);
     btor_aig_release (amgr, and2);
   }
-  btor_aig_release (amgr, not_shift);
   return result;
 }
 
+/* Logarithmic barrel shifter for arbitrary bit-widths. Stage i shifts by
+ * 2^i if bit i of av2 is set, for all 2^i < width. Since every stage
+ * zero-fills, the k stages already yield 0 for shift amounts in
+ * [width, 2^k). Larger amounts are detected by a single comparator
+ * (av2 >= 2^k), which is folded into the selects of the last stage. */
 static BtorAIGVec *
-aigvec_srl (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
+shift_aigvec (BtorAIGVecMgr *avmgr,
+              BtorAIGVec *av1,
+              BtorAIGVec *av2,
+              bool is_left)
 {
-  BtorAIGVec *result, *temp;
-  uint32_t i, j, width;
   assert (avmgr);
   assert (av1);
   assert (av2);
   assert (av1->width);
-  assert (btor_util_is_power_of_2 (av1->width));
-  assert (btor_util_log_2 (av1->width) == av2->width);
-  width  = av2->width;
-  result = srl_n_bits_aigvec (avmgr, av1, 1, av2->aigs[av2->width - 1]);
-  for (j = 2, i = width - 2; j <= width; j++, i--)
+  assert (av1->width == av2->width);
+
+  BtorAIGMgr *amgr;
+  BtorAIGVec *result, *temp;
+  BtorAIG *in_range, *shift, *keep, *tmp;
+  uint64_t n;
+  uint32_t i, k, width;
+
+  amgr  = avmgr->amgr;
+  width = av1->width;
+
+  for (k = 0, n = 1; n < width; k++, n *= 2)
+    ;
+
+  /* in_range: av2 < 2^k */
+  in_range = BTOR_AIG_TRUE;
+  for (i = 0; i < width - k; i++)
+  {
+    tmp = btor_aig_and (amgr, in_range, BTOR_INVERT_AIG (av2->aigs[i]));
+    btor_aig_release (amgr, in_range);
+    in_range = tmp;
+  }
+
+  if (k == 0)
+  {
+    assert (width == 1);
+    result          = new_aigvec (avmgr, 1);
+    result->aigs[0] = btor_aig_and (amgr, av1->aigs[0], in_range);
+    btor_aig_release (amgr, in_range);
+    return result;
+  }
+
+  result = btor_aigvec_copy (avmgr, av1);
+  for (i = 0, n = 1; i < k; i++, n *= 2)
   {
-    temp   = result;
-    result = srl_n_bits_aigvec (
-        avmgr, temp, btor_util_pow_2 (width - i - 1), av2->aigs[i]);
+    if (i + 1 < k)
+    {
+      shift = btor_aig_copy (amgr, av2->aigs[width - 1 - i]);
+      keep  = btor_aig_not (amgr, shift);
+    }
+    else
+    {
+      shift = btor_aig_and (amgr, av2->aigs[width - 1 - i], in_range);
+      keep  = btor_aig_and (
+          amgr, BTOR_INVERT_AIG (av2->aigs[width - 1 - i]), in_range);
+    }
+    temp = result;
+    if (is_left)
+      result = sll_n_bits_aigvec (avmgr, temp, n, shift, keep);
+    else
+      result = srl_n_bits_aigvec (avmgr, temp, n, shift, keep);
     btor_aigvec_release_delete (avmgr, temp);
+    btor_aig_release (amgr, shift);
+    btor_aig_release (amgr, keep);
   }
+  btor_aig_release (amgr, in_range);
   return result;
 }
 
+BtorAIGVec *
+btor_aigvec_sll (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
+{
+  return shift_aigvec (avmgr, av1, av2, true);
+}
+
 BtorAIGVec *
 btor_aigvec_srl (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
 {
-  assert (avmgr);
-  assert (av1);
-  assert (av2);
-  assert (av1->width);
-  assert (av1->width == av2->width);
-  return translate_shift (avmgr, av1, av2, aigvec_srl);
+  return shift_aigvec (avmgr, av1, av2, false);
 }
 
 static BtorAIGVec *
@@ -725,17 +623,107 @@ udiv_urem_aigvec (BtorAIGVecMgr *avmgr,
   *Rptr = R;
 }
 
-BtorAIGVec *
-btor_aigvec_udiv (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
+/* Encode x / y and x % y with fresh variables q and r constrained by
+ *
+ *   y != 0 -> q * y + r = x /\ r < y
+ *   y == 0 -> q = ~0 /\ r = x
+ *
+ * where q * y + r is computed with double width to rule out overflows.
+ * Since the constraint uniquely defines q and r, it is added permanently as
+ * top level constraint to the SAT solver. */
+static void
+udiv_urem_mul_aigvec (BtorAIGVecMgr *avmgr,
+                      BtorAIGVec *x,
+                      BtorAIGVec *y,
+                      BtorAIGVec **Qptr,
+                      BtorAIGVec **Rptr)
+{
+  BtorAIGVec *Q, *R, *zero, *ones, *xx, *yy, *qq, *rr, *prod, *sum;
+  BtorAIGVec *eq_sum, *lt_r, *eq_y, *eq_q, *eq_r;
+  BtorAIG *div, *div_zero, *constraint;
+  BtorAIGMgr *amgr;
+  uint32_t width;
+
+  width = x->width;
+  assert (width > 0);
+  assert (width == y->width);
+
+  amgr = btor_aigvec_get_aig_mgr (avmgr);
+  assert (btor_sat_is_initialized (amgr->smgr));
+
+  Q    = btor_aigvec_var (avmgr, width);
+  R    = btor_aigvec_var (avmgr, width);
+  zero = btor_aigvec_zero (avmgr, width);
+  ones = btor_aigvec_not (avmgr, zero);
+
+  xx   = btor_aigvec_concat (avmgr, zero, x);
+  yy   = btor_aigvec_concat (avmgr, zero, y);
+  qq   = btor_aigvec_concat (avmgr, zero, Q);
+  rr   = btor_aigvec_concat (avmgr, zero, R);
+  prod = mul_aigvec (avmgr, qq, yy);
+  sum  = btor_aigvec_add (avmgr, prod, rr);
+
+  eq_sum = btor_aigvec_eq (avmgr, sum, xx);
+  lt_r   = btor_aigvec_ult (avmgr, R, y);
+  eq_y   = btor_aigvec_eq (avmgr, y, zero);
+  eq_q   = btor_aigvec_eq (avmgr, Q, ones);
+  eq_r   = btor_aigvec_eq (avmgr, R, x);
+
+  div        = btor_aig_and (amgr, eq_sum->aigs[0], lt_r->aigs[0]);
+  div_zero   = btor_aig_and (amgr, eq_q->aigs[0], eq_r->aigs[0]);
+  constraint = btor_aig_cond (amgr, eq_y->aigs[0], div_zero, div);
+  btor_aig_add_toplevel_to_sat (amgr, constraint);
+
+  btor_aig_release (amgr, constraint);
+  btor_aig_release (amgr, div_zero);
+  btor_aig_release (amgr, div);
+  btor_aigvec_release_delete (avmgr, eq_r);
+  btor_aigvec_release_delete (avmgr, eq_q);
+  btor_aigvec_release_delete (avmgr, eq_y);
+  btor_aigvec_release_delete (avmgr, lt_r);
+  btor_aigvec_release_delete (avmgr, eq_sum);
+  btor_aigvec_release_delete (avmgr, sum);
+  btor_aigvec_release_delete (avmgr, prod);
+  btor_aigvec_release_delete (avmgr, rr);
+  btor_aigvec_release_delete (avmgr, qq);
+  btor_aigvec_release_delete (avmgr, yy);
+  btor_aigvec_release_delete (avmgr, xx);
+  btor_aigvec_release_delete (avmgr, ones);
+  btor_aigvec_release_delete (avmgr, zero);
+
+  *Qptr = Q;
+  *Rptr = R;
+}
+
+void
+btor_aigvec_udiv_urem (BtorAIGVecMgr *avmgr,
+                       BtorAIGVec *av1,
+                       BtorAIGVec *av2,
+                       BtorAIGVec **quotient,
+                       BtorAIGVec **remainder)
 {
-  BtorAIGVec *quotient  = 0;
-  BtorAIGVec *remainder = 0;
   assert (avmgr);
   assert (av1);
   assert (av2);
   assert (av1->width == av2->width);
   assert (av1->width > 0);
-  udiv_urem_aigvec (avmgr, av1, av2, &quotient, &remainder);
+  assert (quotient);
+  assert (remainder);
+
+  /* the multiplier based encoding relies on constraints in the SAT solver,
+   * hence we fall back to the divider circuit if there is none */
+  if (btor_opt_get (avmgr->btor, BTOR_OPT_UDIV_MUL_ENCODE)
+      && btor_sat_is_initialized (avmgr->amgr->smgr))
+    udiv_urem_mul_aigvec (avmgr, av1, av2, quotient, remainder);
+  else
+    udiv_urem_aigvec (avmgr, av1, av2, quotient, remainder);
+}
+
+BtorAIGVec *
+btor_aigvec_udiv (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
+{
+  BtorAIGVec *quotient, *remainder;
+  btor_aigvec_udiv_urem (avmgr, av1, av2, &quotient, &remainder);
   btor_aigvec_release_delete (avmgr, remainder);
   return quotient;
 }
@@ -744,12 +732,7 @@ BtorAIGVec *
 btor_aigvec_urem (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
 {
   BtorAIGVec *quotient, *remainder;
-  assert (avmgr);
-  assert (av1);
-  assert (av2);
-  assert (av1->width == av2->width);
-  assert (av1->width > 0);
-  udiv_urem_aigvec (avmgr, av1, av2, &quotient, &remainder);
+  btor_aigvec_udiv_urem (avmgr, av1, av2, &quotient, &remainder);
   btor_aigvec_release_delete (avmgr, quotient);
   return remainder;
 }
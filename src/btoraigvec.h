@@ -124,8 +124,7 @@ BtorAIGVec *btor_aigvec_add (BtorAIGVecMgr *avmgr,
                              BtorAIGVec *av2);
 /**
  * Create an AIG vector representing av1 shift left logical by av2.
- * is_power_of_2(width(av1))
- * width(av2) = log2(width(av1))
+ * width(av1) = width(av2)
  * width(result) = width(av1)
  */
 BtorAIGVec *btor_aigvec_sll (BtorAIGVecMgr *avmgr,
@@ -133,8 +132,7 @@ BtorAIGVec *btor_aigvec_sll (BtorAIGVecMgr *avmgr,
                              BtorAIGVec *av2);
 /**
  * Create an AIG vector representing av1 shift right logical by av2.
- * is_power_of_2(width(av1))
- * width(av2) = log2(width(av1))
+ * width(av1) = width(av2)
  * width(result) = width(av1)
  */
 BtorAIGVec *btor_aigvec_srl (BtorAIGVecMgr *avmgr,
@@ -164,6 +162,17 @@ BtorAIGVec *btor_aigvec_udiv (BtorAIGVecMgr *avmgr,
 BtorAIGVec *btor_aigvec_urem (BtorAIGVecMgr *avmgr,
                               BtorAIGVec *av1,
                               BtorAIGVec *av2);
+/**
+ * Create AIG vectors representing av1 / av2 and av1 % av2 (unsigned) with
+ * one shared divider.
+ * width(av1) = width(av2)
+ * width(quotient) = width(remainder) = width(av1) = width(av2)
+ */
+void btor_aigvec_udiv_urem (BtorAIGVecMgr *avmgr,
+                            BtorAIGVec *av1,
+                            BtorAIGVec *av2,
+                            BtorAIGVec **quotient,
+                            BtorAIGVec **remainder);
 /**
  * Create an AIG vector representing the concatenation av1.av2.
  * width(result) = width(av1) + width(av2)
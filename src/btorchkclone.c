@@ -231,6 +231,7 @@ chkclone_stats (Btor *btor, Btor *clone)
 #ifndef NDEBUG
   BtorPtrHashTableIterator it, cit;
   BtorHashTableData *data, *cdata;
+  BtorRwRuleProfile *prof, *cprof;
   char *key, *ckey;
 #endif
 
@@ -287,6 +288,26 @@ chkclone_stats (Btor *btor, Btor *clone)
     assert (data->as_int == cdata->as_int);
   }
   assert (!btor_iter_hashptr_has_next (&cit));
+
+  assert (btor->stats.rw_rules_profile && clone->stats.rw_rules_profile);
+  assert (btor->stats.rw_rules_profile->count
+          == clone->stats.rw_rules_profile->count);
+  btor_iter_hashptr_init (&it, btor->stats.rw_rules_profile);
+  btor_iter_hashptr_init (&cit, clone->stats.rw_rules_profile);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    assert (btor_iter_hashptr_has_next (&cit));
+    prof  = it.bucket->data.as_ptr;
+    cprof = cit.bucket->data.as_ptr;
+    key   = (char *) btor_iter_hashptr_next (&it);
+    ckey  = (char *) btor_iter_hashptr_next (&cit);
+    assert (!strcmp (key, ckey));
+    assert (prof != cprof);
+    assert (prof->attempts == cprof->attempts);
+    assert (prof->hits == cprof->hits);
+    assert (prof->bound == cprof->bound);
+  }
+  assert (!btor_iter_hashptr_has_next (&cit));
 #endif
 
   BTOR_CHKCLONE_STATS (expressions);
@@ -1086,6 +1107,8 @@ chkclone_slv (Btor *btor, Btor *clone)
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, beta_reduction_conflicts);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, extensionality_lemmas);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_size_sum);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemma_prems_dropped);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_subsumed);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_failed_vars);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_assumed_vars);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_failed_applies);
@@ -1095,6 +1118,12 @@ chkclone_slv (Btor *btor, Btor *clone)
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, eval_exp_calls);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, propagations);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, propagations_down);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, apps_rechecked);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, apps_replayed);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, args_interned);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, store_chain_skips);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, betap_cache_hits);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, betap_cache_misses);
   }
   else if (btor->slv->kind == BTOR_SLS_SOLVER_KIND)
   {
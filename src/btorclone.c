@@ -260,6 +260,24 @@ btor_clone_data_as_bv_ptr_htable (BtorMemMgr *mm,
                                                   map);
 }
 
+static void
+clone_data_as_rw_rule_profile (BtorMemMgr *mm,
+                               const void *map,
+                               BtorHashTableData *data,
+                               BtorHashTableData *cloned_data)
+{
+  assert (mm);
+  assert (data);
+  assert (cloned_data);
+
+  BtorRwRuleProfile *res;
+
+  (void) map;
+  BTOR_NEW (mm, res);
+  *res                = *((BtorRwRuleProfile *) data->as_ptr);
+  cloned_data->as_ptr = res;
+}
+
 /*------------------------------------------------------------------------*/
 
 static void
@@ -876,11 +894,12 @@ clone_aux_btor (Btor *btor,
   BtorNodeMap *emap = 0;
   BtorMemMgr *mm;
   double start, delta;
-  uint32_t i, len;
+  uint32_t i, j, len;
   char *prefix, *clone_prefix;
   BtorNode *exp, *cloned_exp;
   BtorPtrHashTableIterator pit;
   BtorNodePtrStack rhos;
+  BtorUCDef ucdef;
 #ifndef NDEBUG
   uint32_t h;
   size_t allocated;
@@ -943,9 +962,11 @@ clone_aux_btor (Btor *btor,
      * it is the memcpy-ied pointer of btor->stats.rw_rules_applied */
     clone->stats.rw_rules_applied = 0;
 #endif
+    clone->stats.rw_rules_profile = 0;
     btor_reset_stats (clone);
 #ifndef NDEBUG
     allocated += MEM_PTR_HASH_TABLE (clone->stats.rw_rules_applied);
+    allocated += MEM_PTR_HASH_TABLE (clone->stats.rw_rules_profile);
     assert (allocated == clone->mm->allocated);
 #endif
   }
@@ -1038,23 +1059,34 @@ clone_aux_btor (Btor *btor,
           /* unique table chain */
           + amgr->table.size * sizeof (int32_t)
           + BTOR_SIZE_STACK (amgr->id2aig) * sizeof (BtorAIG *)
-          + BTOR_SIZE_STACK (amgr->cnfid2aig) * sizeof (int32_t);
+          + BTOR_SIZE_STACK (amgr->cnfid2aig) * sizeof (int32_t)
+          + BTOR_SIZE_STACK (amgr->assumption_aigs) * sizeof (int32_t)
+          + BTOR_SIZE_STACK (amgr->assumption_roots) * sizeof (int32_t);
 #ifdef BTOR_USE_LINGELING
-      assert (strcmp (amgr->smgr->name, "Lingeling") == 0
-              || strcmp (amgr->smgr->name, "DIMACS Printer") == 0);
-      assert (strcmp (amgr->smgr->name, "DIMACS Printer") != 0
-              || strcmp (((BtorCnfPrinter *) amgr->smgr->solver)->smgr->name,
-                         "Lingeling")
-                     == 0);
+      BtorSATMgr *wrapped_smgr = amgr->smgr;
       allocated += amgr->smgr->solver ? sizeof (BtorLGL) : 0;
-      if (strcmp (amgr->smgr->name, "DIMACS Printer") == 0)
+      if (strcmp (wrapped_smgr->name, "DIMACS Printer") == 0)
       {
         BtorCnfPrinter *cnf_printer = ((BtorCnfPrinter *) amgr->smgr->solver);
         allocated +=
             sizeof (BtorCnfPrinter) + sizeof (BtorSATMgr)
             + BTOR_SIZE_STACK (cnf_printer->clauses) * sizeof (int32_t)
             + BTOR_SIZE_STACK (cnf_printer->assumptions) * sizeof (int32_t);
+        wrapped_smgr = cnf_printer->smgr;
+      }
+      if (strcmp (wrapped_smgr->name, "Cube Solver") == 0)
+      {
+        BtorCubeSolver *cube_solver = ((BtorCubeSolver *) wrapped_smgr->solver);
+        allocated +=
+            sizeof (BtorCubeSolver) + sizeof (BtorSATMgr)
+            + BTOR_SIZE_STACK (cube_solver->clauses) * sizeof (int32_t)
+            + BTOR_SIZE_STACK (cube_solver->assumptions) * sizeof (int32_t)
+            + BTOR_SIZE_STACK (cube_solver->melted) * sizeof (int32_t)
+            + BTOR_SIZE_STACK (cube_solver->cube_vars) * sizeof (int32_t)
+            + 2 * cube_solver->size * sizeof (int8_t);
+        wrapped_smgr = cube_solver->smgr;
       }
+      assert (strcmp (wrapped_smgr->name, "Lingeling") == 0);
 #endif
       assert (allocated == clone->mm->allocated);
 #endif
@@ -1228,6 +1260,23 @@ clone_aux_btor (Btor *btor,
            BTOR_SIZE_STACK (btor->assertions_trail) * sizeof (uint32_t))
           == clone->mm->allocated);
 
+  BTOR_INIT_STACK (clone->mm, clone->ucdefs);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->ucdefs); i++)
+  {
+    ucdef     = BTOR_PEEK_STACK (btor->ucdefs, i);
+    ucdef.var = btor_nodemap_mapped (emap, ucdef.var);
+    assert (ucdef.var);
+    for (j = 0; j < ucdef.arity; j++)
+    {
+      ucdef.e[j] = btor_nodemap_mapped (emap, ucdef.e[j]);
+      assert (ucdef.e[j]);
+    }
+    BTOR_PUSH_STACK (clone->ucdefs, ucdef);
+  }
+  BTOR_ADJUST_STACK (btor->ucdefs, clone->ucdefs);
+  assert ((allocated += BTOR_SIZE_STACK (btor->ucdefs) * sizeof (BtorUCDef))
+          == clone->mm->allocated);
+
   if (btor->bv_model)
   {
     clone->bv_model = btor_model_clone_bv (clone, btor->bv_model, false);
@@ -1260,6 +1309,20 @@ clone_aux_btor (Btor *btor,
             == clone->mm->allocated);
   }
 #endif
+  if (!exp_layer_only)
+  {
+    clone->stats.rw_rules_profile =
+        btor_hashptr_table_clone (mm,
+                                  btor->stats.rw_rules_profile,
+                                  btor_clone_key_as_static_str,
+                                  clone_data_as_rw_rule_profile,
+                                  0,
+                                  0);
+    assert ((allocated += MEM_PTR_HASH_TABLE (btor->stats.rw_rules_profile)
+                          + btor->stats.rw_rules_profile->count
+                                * sizeof (BtorRwRuleProfile))
+            == clone->mm->allocated);
+  }
   if (btor->fun_model)
   {
     clone->fun_model = btor_model_clone_fun (clone, btor->fun_model, false);
@@ -1376,6 +1439,12 @@ clone_aux_btor (Btor *btor,
   allocated += btor->rw_cache->cache->count * sizeof (BtorRwCacheTuple);
   allocated += MEM_PTR_HASH_TABLE (btor->rw_cache->cache);
 #endif
+  clone->rw_deferred = btor_hashint_table_clone (mm, btor->rw_deferred);
+#ifndef NDEBUG
+  allocated += MEM_INT_HASH_TABLE (btor->rw_deferred);
+#endif
+  /* results of components are not cloned */
+  clone->components_cache = 0;
 
   /* move synthesized constraints to unsynthesized if we only clone the exp
    * layer */
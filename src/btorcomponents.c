@@ -0,0 +1,683 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorcomponents.h"
+
+#include "btorbeta.h"
+#include "btorclone.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btormodel.h"
+#include "btoropt.h"
+#include "btorslvfun.h"
+#include "utils/btorhashint.h"
+#include "utils/btorhashptr.h"
+#include "utils/btornodemap.h"
+#include "utils/btorunionfind.h"
+#include "utils/btorutil.h"
+
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+#include <stdlib.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Result of a component, cached over incremental calls. A component is
+ * identified by its constraints (sorted by id). */
+struct BtorComponentResult
+{
+  BtorNodePtrStack roots;       /* constraints of the component */
+  BtorSolverResult result;
+  BtorNodePtrStack vars;        /* bit-vector variables of the component */
+  BtorBitVectorPtrStack values; /* assignments of 'vars' if sat */
+};
+
+typedef struct BtorComponentResult BtorComponentResult;
+
+struct BtorComponent
+{
+  Btor *btor;              /* instance the component is solved in */
+  BtorNodeMap *exp_map;    /* maps nodes of the parent instance */
+  BtorNodePtrStack roots;  /* constraints of the component */
+  uint32_t size;           /* number of nodes of the component */
+  BtorSolverResult result;
+  BtorComponentResult *cached; /* result if solved or taken from cache */
+};
+
+typedef struct BtorComponent BtorComponent;
+
+BTOR_DECLARE_STACK (BtorComponentPtr, BtorComponent *);
+
+/*------------------------------------------------------------------------*/
+
+static uint32_t
+hash_component_result (BtorComponentResult *r)
+{
+  uint32_t i, res;
+
+  res = 0;
+  for (i = 0; i < BTOR_COUNT_STACK (r->roots); i++)
+    res = res * 7334147u + btor_node_get_id (BTOR_PEEK_STACK (r->roots, i));
+  return res;
+}
+
+static int32_t
+compare_component_result (BtorComponentResult *a, BtorComponentResult *b)
+{
+  uint32_t i;
+
+  if (BTOR_COUNT_STACK (a->roots) != BTOR_COUNT_STACK (b->roots)) return 1;
+  for (i = 0; i < BTOR_COUNT_STACK (a->roots); i++)
+    if (BTOR_PEEK_STACK (a->roots, i) != BTOR_PEEK_STACK (b->roots, i))
+      return 1;
+  return 0;
+}
+
+static void
+delete_component_result (Btor *btor, BtorComponentResult *r)
+{
+  while (!BTOR_EMPTY_STACK (r->roots))
+    btor_node_release (btor, BTOR_POP_STACK (r->roots));
+  BTOR_RELEASE_STACK (r->roots);
+  while (!BTOR_EMPTY_STACK (r->vars))
+    btor_node_release (btor, BTOR_POP_STACK (r->vars));
+  BTOR_RELEASE_STACK (r->vars);
+  while (!BTOR_EMPTY_STACK (r->values))
+    btor_bv_free (btor->mm, BTOR_POP_STACK (r->values));
+  BTOR_RELEASE_STACK (r->values);
+  BTOR_DELETE (btor->mm, r);
+}
+
+/* Record the result of the solved component 'comp' and the assignments of
+ * its bit-vector variables. */
+static BtorComponentResult *
+new_component_result (Btor *btor, BtorComponent *comp)
+{
+  uint32_t i;
+  BtorNode *cur, *clone;
+  BtorNodeMapIterator it;
+  BtorComponentResult *res;
+
+  BTOR_CNEW (btor->mm, res);
+  BTOR_INIT_STACK (btor->mm, res->roots);
+  BTOR_INIT_STACK (btor->mm, res->vars);
+  BTOR_INIT_STACK (btor->mm, res->values);
+  for (i = 0; i < BTOR_COUNT_STACK (comp->roots); i++)
+    BTOR_PUSH_STACK (res->roots,
+                     btor_node_copy (btor, BTOR_PEEK_STACK (comp->roots, i)));
+  res->result = comp->result;
+
+  if (res->result == BTOR_RESULT_SAT
+      && btor_opt_get (comp->btor, BTOR_OPT_MODEL_GEN))
+  {
+    btor_iter_nodemap_init (&it, comp->exp_map);
+    while (btor_iter_nodemap_has_next (&it))
+    {
+      clone = it.it.bucket->data.as_ptr;
+      cur   = btor_iter_nodemap_next (&it);
+      if (!btor_node_is_bv_var (cur)) continue;
+      BTOR_PUSH_STACK (res->vars, btor_node_copy (btor, cur));
+      BTOR_PUSH_STACK (
+          res->values,
+          btor_bv_copy (btor->mm, btor_model_get_bv (comp->btor, clone)));
+    }
+  }
+  return res;
+}
+
+void
+btor_components_delete_cache (Btor *btor)
+{
+  assert (btor);
+
+  BtorPtrHashTableIterator it;
+
+  if (!btor->components_cache) return;
+  btor_iter_hashptr_init (&it, btor->components_cache);
+  while (btor_iter_hashptr_has_next (&it))
+    delete_component_result (btor, btor_iter_hashptr_next (&it));
+  btor_hashptr_table_delete (btor->components_cache);
+  btor->components_cache = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+static BtorComponent *
+new_component (Btor *btor)
+{
+  BtorComponent *res;
+
+  BTOR_CNEW (btor->mm, res);
+  BTOR_INIT_STACK (btor->mm, res->roots);
+  res->result = BTOR_RESULT_UNKNOWN;
+  return res;
+}
+
+static void
+delete_component (Btor *btor, BtorComponent *comp)
+{
+  while (!BTOR_EMPTY_STACK (comp->roots))
+    btor_node_release (btor, BTOR_POP_STACK (comp->roots));
+  BTOR_RELEASE_STACK (comp->roots);
+  if (comp->exp_map) btor_nodemap_delete (comp->exp_map);
+  if (comp->btor) btor_delete (comp->btor);
+  BTOR_DELETE (btor->mm, comp);
+}
+
+static int32_t
+compare_node_id (const void *p1, const void *p2)
+{
+  return btor_node_get_id (*((BtorNode **) p1))
+         - btor_node_get_id (*((BtorNode **) p2));
+}
+
+static int32_t
+compare_component_size (const void *p1, const void *p2)
+{
+  BtorComponent *a, *b;
+
+  a = *((BtorComponent **) p1);
+  b = *((BtorComponent **) p2);
+  if (a->size < b->size) return -1;
+  if (a->size > b->size) return 1;
+  return 0;
+}
+
+/* Partition the constraints into variable-disjoint components. Two
+ * constraints belong to the same component if they share a non-constant
+ * node. The components are sorted by size (smallest first). */
+static void
+compute_components (Btor *btor,
+                    BtorNodePtrStack *roots,
+                    BtorComponentPtrStack *comps)
+{
+  uint32_t i, j, size;
+  BtorMemMgr *mm;
+  BtorNode *root, *cur, *e, *repr;
+  BtorNodePtrStack visit;
+  BtorUIntStack sizes;
+  BtorIntHashTable *mark;
+  BtorUnionFind *ufind;
+  BtorPtrHashTable *repr2comp;
+  BtorPtrHashBucket *b;
+  BtorComponent *comp;
+
+  mm        = btor->mm;
+  mark      = btor_hashint_table_new (mm);
+  ufind     = btor_ufind_new (mm);
+  repr2comp = btor_hashptr_table_new (mm,
+                                      (BtorHashPtr) btor_node_hash_by_id,
+                                      (BtorCmpPtr) btor_node_compare_by_id);
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_INIT_STACK (mm, sizes);
+
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+  {
+    root = btor_node_real_addr (BTOR_PEEK_STACK (*roots, i));
+    btor_ufind_add (ufind, root);
+    size = 0;
+    BTOR_PUSH_STACK (visit, root);
+    while (!BTOR_EMPTY_STACK (visit))
+    {
+      cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+      if (btor_hashint_table_contains (mark, cur->id)) continue;
+      btor_hashint_table_add (mark, cur->id);
+      size++;
+      for (j = 0; j < cur->arity; j++)
+      {
+        e = btor_node_real_addr (cur->e[j]);
+        if (btor_node_is_bv_const (e)) continue;
+        btor_ufind_merge (ufind, cur, e);
+        BTOR_PUSH_STACK (visit, e);
+      }
+    }
+    BTOR_PUSH_STACK (sizes, size);
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+  {
+    root = BTOR_PEEK_STACK (*roots, i);
+    repr = btor_ufind_get_repr (ufind, btor_node_real_addr (root));
+    if ((b = btor_hashptr_table_get (repr2comp, repr)))
+      comp = b->data.as_ptr;
+    else
+    {
+      comp = new_component (btor);
+      btor_hashptr_table_add (repr2comp, repr)->data.as_ptr = comp;
+      BTOR_PUSH_STACK (*comps, comp);
+    }
+    BTOR_PUSH_STACK (comp->roots, btor_node_copy (btor, root));
+    comp->size += BTOR_PEEK_STACK (sizes, i);
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (*comps); i++)
+  {
+    comp = BTOR_PEEK_STACK (*comps, i);
+    qsort (comp->roots.start,
+           BTOR_COUNT_STACK (comp->roots),
+           sizeof (BtorNode *),
+           compare_node_id);
+  }
+  qsort (comps->start,
+         BTOR_COUNT_STACK (*comps),
+         sizeof (BtorComponent *),
+         compare_component_size);
+
+  BTOR_RELEASE_STACK (sizes);
+  BTOR_RELEASE_STACK (visit);
+  btor_hashptr_table_delete (repr2comp);
+  btor_ufind_delete (ufind);
+  btor_hashint_table_delete (mark);
+}
+
+/* Components are terminated if 'btor' (passed as 'state') is terminated. */
+static int32_t
+component_terminate (void *state)
+{
+  return btor_terminate ((Btor *) state);
+}
+
+/* Create a new instance for 'comp' with the options of 'btor' and assert
+ * the constraints of 'comp'. */
+static void
+setup_component (Btor *btor, BtorComponent *comp, uint32_t id)
+{
+  uint32_t i;
+  char prefix[32];
+  BtorNode *root, *clone;
+
+  comp->btor = btor_new ();
+  btor_opt_delete_opts (comp->btor);
+  btor_opt_clone_opts (btor, comp->btor);
+  sprintf (prefix, "comp%u", id);
+  btor_set_msg_prefix (comp->btor, prefix);
+  btor_set_term (comp->btor, component_terminate, btor);
+
+  btor_opt_set (comp->btor, BTOR_OPT_COMPONENTS, 0);
+  btor_opt_set (comp->btor, BTOR_OPT_INCREMENTAL, 0);
+  /* models of the components are combined into the model of 'btor' */
+  if (!btor_opt_get (btor, BTOR_OPT_UCOPT)
+      || btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
+    btor_opt_set (comp->btor, BTOR_OPT_MODEL_GEN, 1);
+
+  comp->exp_map = btor_nodemap_new (btor);
+  for (i = 0; i < BTOR_COUNT_STACK (comp->roots); i++)
+  {
+    root  = BTOR_PEEK_STACK (comp->roots, i);
+    clone = btor_clone_recursively_rebuild_exp (
+        btor,
+        comp->btor,
+        root,
+        comp->exp_map,
+        btor_opt_get (comp->btor, BTOR_OPT_REWRITE_LEVEL));
+    btor_assert_exp (comp->btor, clone);
+    btor_node_release (comp->btor, clone);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+#ifdef BTOR_HAVE_PTHREADS
+struct BtorComponentWorkers
+{
+  Btor *btor;
+  BtorComponent **comps;
+  uint32_t ncomps;
+  uint32_t next; /* next component to be solved */
+  bool done;     /* found unsatisfiable component or 'btor' terminated */
+  pthread_mutex_t mutex;
+};
+
+typedef struct BtorComponentWorkers BtorComponentWorkers;
+
+/* The termination callback of 'btor' is queried under the lock, since the
+ * workers may query it concurrently. */
+static int32_t
+component_worker_terminate (void *state)
+{
+  BtorComponentWorkers *workers = state;
+  bool done;
+
+  pthread_mutex_lock (&workers->mutex);
+  if (!workers->done && btor_terminate (workers->btor)) workers->done = true;
+  done = workers->done;
+  pthread_mutex_unlock (&workers->mutex);
+  return done;
+}
+
+static void *
+component_worker (void *state)
+{
+  BtorComponentWorkers *workers = state;
+  BtorComponent *comp;
+
+  for (;;)
+  {
+    pthread_mutex_lock (&workers->mutex);
+    comp = 0;
+    if (!workers->done && workers->next < workers->ncomps)
+      comp = workers->comps[workers->next++];
+    pthread_mutex_unlock (&workers->mutex);
+    if (!comp) break;
+
+    comp->result = btor_check_sat (comp->btor, -1, -1);
+
+    if (comp->result == BTOR_RESULT_UNSAT)
+    {
+      pthread_mutex_lock (&workers->mutex);
+      workers->done = true;
+      pthread_mutex_unlock (&workers->mutex);
+    }
+  }
+  return NULL;
+}
+
+static void
+solve_parallel (Btor *btor, BtorComponentPtrStack *comps, uint32_t nthreads)
+{
+  uint32_t i, nstarted;
+  pthread_t *threads;
+  BtorComponentWorkers workers;
+
+  workers.btor   = btor;
+  workers.comps  = comps->start;
+  workers.ncomps = BTOR_COUNT_STACK (*comps);
+  workers.next   = 0;
+  workers.done   = false;
+  pthread_mutex_init (&workers.mutex, 0);
+
+  for (i = 0; i < workers.ncomps; i++)
+    btor_set_term (
+        workers.comps[i]->btor, component_worker_terminate, &workers);
+
+  BTOR_NEWN (btor->mm, threads, nthreads);
+  for (nstarted = 0; nstarted < nthreads; nstarted++)
+    if (pthread_create (&threads[nstarted], 0, component_worker, &workers))
+      break;
+  for (i = 0; i < nstarted; i++) pthread_join (threads[i], 0);
+  BTOR_DELETEN (btor->mm, threads, nthreads);
+  /* solve the remaining components if not all threads could be started */
+  component_worker (&workers);
+
+  pthread_mutex_destroy (&workers.mutex);
+}
+#endif
+
+static void
+solve_sequential (Btor *btor, BtorComponentPtrStack *comps)
+{
+  uint32_t i;
+  BtorComponent *comp;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*comps); i++)
+  {
+    if (btor_terminate (btor)) break;
+    comp         = BTOR_PEEK_STACK (*comps, i);
+    comp->result = btor_check_sat (comp->btor, -1, -1);
+    if (comp->result == BTOR_RESULT_UNSAT) break;
+  }
+}
+
+/* Add the assignments of the bit-vector variables of all components to the
+ * model of 'btor'. The values of all other nodes are computed from these
+ * assignments when the model is generated. */
+static void
+combine_models (Btor *btor, BtorComponentPtrStack *comps)
+{
+  uint32_t i, j;
+  BtorComponentResult *r;
+
+  btor_model_init_bv (btor, &btor->bv_model);
+  for (i = 0; i < BTOR_COUNT_STACK (*comps); i++)
+  {
+    r = BTOR_PEEK_STACK (*comps, i)->cached;
+    for (j = 0; j < BTOR_COUNT_STACK (r->vars); j++)
+      btor_model_add_to_bv (btor,
+                            btor->bv_model,
+                            BTOR_PEEK_STACK (r->vars, j),
+                            BTOR_PEEK_STACK (r->values, j));
+  }
+}
+
+/* Assertions of context levels > 0 are assumed on every call. Returns true
+ * if there are no other assumptions. */
+static bool
+only_assertions_assumed (Btor *btor)
+{
+  bool res;
+  uint32_t i;
+  BtorIntHashTable *assertions;
+  BtorPtrHashTableIterator it;
+
+  if (btor->orig_assumptions->count == 0) return true;
+
+  assertions = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions); i++)
+    btor_hashint_table_add (
+        assertions, btor_node_get_id (BTOR_PEEK_STACK (btor->assertions, i)));
+  res = true;
+  btor_iter_hashptr_init (&it, btor->orig_assumptions);
+  while (res && btor_iter_hashptr_has_next (&it))
+    res = btor_hashint_table_contains (
+        assertions, btor_node_get_id (btor_iter_hashptr_next (&it)));
+  btor_hashint_table_delete (assertions);
+  return res;
+}
+
+/* Add the results of the components of the current call to the cache of
+ * 'btor'. Cached results are kept as long as all their constraints are
+ * still asserted (i.e., are constraints of the current call). */
+static void
+update_cache (Btor *btor,
+              BtorNodePtrStack *roots,
+              BtorComponentPtrStack *comps)
+{
+  uint32_t i;
+  bool keep;
+  BtorComponentResult *r;
+  BtorPtrHashTable *cache;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *asserted;
+
+  cache = btor_hashptr_table_new (btor->mm,
+                                  (BtorHashPtr) hash_component_result,
+                                  (BtorCmpPtr) compare_component_result);
+  for (i = 0; i < BTOR_COUNT_STACK (*comps); i++)
+  {
+    r = BTOR_PEEK_STACK (*comps, i)->cached;
+    if (r)
+    {
+      btor_hashptr_table_add (cache, r);
+      BTOR_PEEK_STACK (*comps, i)->cached = 0;
+    }
+  }
+
+  if (btor->components_cache)
+  {
+    asserted = btor_hashint_table_new (btor->mm);
+    for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+      btor_hashint_table_add (asserted,
+                              btor_node_get_id (BTOR_PEEK_STACK (*roots, i)));
+
+    btor_iter_hashptr_init (&it, btor->components_cache);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      r = btor_iter_hashptr_next (&it);
+      if (btor_hashptr_table_get (cache, r)) continue;
+      keep = true;
+      for (i = 0; keep && i < BTOR_COUNT_STACK (r->roots); i++)
+        keep = btor_hashint_table_contains (
+            asserted, btor_node_get_id (BTOR_PEEK_STACK (r->roots, i)));
+      if (keep)
+        btor_hashptr_table_add (cache, r);
+      else
+        delete_component_result (btor, r);
+    }
+    btor_hashint_table_delete (asserted);
+    btor_hashptr_table_delete (btor->components_cache);
+  }
+  btor->components_cache = cache;
+}
+
+/*------------------------------------------------------------------------*/
+
+BtorSolverResult
+btor_components_check_sat (Btor *btor)
+{
+  assert (btor);
+  assert (btor_opt_get (btor, BTOR_OPT_COMPONENTS));
+
+  uint32_t i, nthreads, num_sat;
+  double start, delta;
+  bool incremental;
+  BtorNode *cur;
+  BtorNodePtrStack roots;
+  BtorComponentPtrStack comps, solve;
+  BtorComponent *comp;
+  BtorComponentResult key;
+  BtorPtrHashTableIterator it;
+  BtorPtrHashBucket *b;
+  BtorIntHashTable *mark;
+  BtorSolverResult res;
+  bool cached_unsat;
+
+  if (btor->inconsistent || btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS)
+      || btor->quantifiers->count > 0 || btor->ufs->count > 0
+      || btor->feqs->count > 0 || !only_assertions_assumed (btor))
+    return BTOR_RESULT_UNKNOWN;
+
+  start       = btor_util_time_stamp ();
+  res         = BTOR_RESULT_UNKNOWN;
+  incremental = btor_opt_get (btor, BTOR_OPT_INCREMENTAL);
+
+  /* lambdas are eliminated since they may be shared between components */
+  BTOR_INIT_STACK (btor->mm, roots);
+  mark = btor_hashint_table_new (btor->mm);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    if (btor->lambdas->count > 0)
+      cur = btor_beta_reduce_full (btor, cur, 0);
+    else
+      cur = btor_node_copy (btor, cur);
+    if (btor_node_is_bv_const (cur)
+        || btor_hashint_table_contains (mark, btor_node_get_id (cur)))
+    {
+      btor_node_release (btor, cur);
+      continue;
+    }
+    btor_hashint_table_add (mark, btor_node_get_id (cur));
+    BTOR_PUSH_STACK (roots, cur);
+  }
+  btor_hashint_table_delete (mark);
+
+  BTOR_INIT_STACK (btor->mm, comps);
+  BTOR_INIT_STACK (btor->mm, solve);
+  compute_components (btor, &roots, &comps);
+  btor->stats.components = BTOR_COUNT_STACK (comps);
+
+  BTOR_MSG (btor->msg,
+            1,
+            "found %u variable-disjoint components",
+            BTOR_COUNT_STACK (comps));
+
+  if (BTOR_COUNT_STACK (comps) > 1)
+  {
+    /* reuse results of components solved in previous incremental calls,
+     * a cached unsatisfiable component decides the call */
+    cached_unsat = false;
+    for (i = 0; i < BTOR_COUNT_STACK (comps); i++)
+    {
+      comp      = BTOR_PEEK_STACK (comps, i);
+      key.roots = comp->roots;
+      if (btor->components_cache
+          && (b = btor_hashptr_table_get (btor->components_cache, &key)))
+      {
+        comp->cached = b->key;
+        comp->result = comp->cached->result;
+        btor->stats.components_cached++;
+        if (comp->result == BTOR_RESULT_UNSAT) cached_unsat = true;
+      }
+      else
+        BTOR_PUSH_STACK (solve, comp);
+    }
+    if (cached_unsat) BTOR_RESET_STACK (solve);
+
+    for (i = 0; i < BTOR_COUNT_STACK (solve); i++)
+      setup_component (btor, BTOR_PEEK_STACK (solve, i), i);
+
+    nthreads = btor_opt_get (btor, BTOR_OPT_COMPONENTS);
+    if (nthreads > BTOR_COUNT_STACK (solve))
+      nthreads = BTOR_COUNT_STACK (solve);
+#ifdef BTOR_HAVE_PTHREADS
+    if (nthreads > 1)
+      solve_parallel (btor, &solve, nthreads);
+    else
+#endif
+      solve_sequential (btor, &solve);
+
+    for (i = 0; i < BTOR_COUNT_STACK (solve); i++)
+    {
+      comp = BTOR_PEEK_STACK (solve, i);
+      if (comp->result != BTOR_RESULT_UNKNOWN)
+        comp->cached = new_component_result (btor, comp);
+    }
+
+    num_sat = 0;
+    for (i = 0; i < BTOR_COUNT_STACK (comps); i++)
+    {
+      comp = BTOR_PEEK_STACK (comps, i);
+      if (comp->result == BTOR_RESULT_UNSAT)
+      {
+        res = BTOR_RESULT_UNSAT;
+        break;
+      }
+      if (comp->result == BTOR_RESULT_SAT) num_sat++;
+    }
+    if (num_sat == BTOR_COUNT_STACK (comps))
+    {
+      res = BTOR_RESULT_SAT;
+      if (!btor_opt_get (btor, BTOR_OPT_UCOPT)
+          || btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
+        combine_models (btor, &comps);
+      /* the model is generated and printed via the core solver */
+      if (!btor->slv) btor->slv = btor_new_fun_solver (btor);
+    }
+
+    BTOR_MSG (btor->msg,
+              1,
+              "solved %u of %u components, result: %d",
+              BTOR_COUNT_STACK (solve),
+              BTOR_COUNT_STACK (comps),
+              res);
+
+    if (incremental) update_cache (btor, &roots, &comps);
+  }
+
+  while (!BTOR_EMPTY_STACK (comps))
+  {
+    comp = BTOR_POP_STACK (comps);
+    if (comp->cached) delete_component_result (btor, comp->cached);
+    delete_component (btor, comp);
+  }
+  BTOR_RELEASE_STACK (comps);
+  BTOR_RELEASE_STACK (solve);
+  while (!BTOR_EMPTY_STACK (roots))
+    btor_node_release (btor, BTOR_POP_STACK (roots));
+  BTOR_RELEASE_STACK (roots);
+
+  delta = btor_util_time_stamp () - start;
+  btor->time.components += delta;
+  return res;
+}
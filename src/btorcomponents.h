@@ -0,0 +1,27 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORCOMPONENTS_H_INCLUDED
+#define BTORCOMPONENTS_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Split the constraints into variable-disjoint components, simplify and
+ * solve each component in a separate Boolector instance (on worker threads if
+ * pthreads are available) and combine the results and models.
+ * In incremental mode, the results of the components are cached and reused
+ * by subsequent calls as long as the constraints of a component do not change.
+ * Returns BTOR_RESULT_UNKNOWN if the formula does not decompose or if the
+ * components could not be decided, in which case the formula is solved as
+ * a whole. */
+BtorSolverResult btor_components_check_sat (Btor *btor);
+
+/* Delete the results of components cached over incremental calls. */
+void btor_components_delete_cache (Btor *btor);
+
+#endif
@@ -11,6 +11,7 @@
 
 #include "btorcore.h"
 
+#include <inttypes.h>
 #include <limits.h>
 
 #include "btorabort.h"
@@ -19,6 +20,7 @@
 #include "btorchkmodel.h"
 #endif
 #include "btorclone.h"
+#include "btorcomponents.h"
 #include "btorconfig.h"
 #include "btordbg.h"
 #include "btorexp.h"
@@ -33,6 +35,7 @@
 #include "btorslvsls.h"
 #include "btorsubst.h"
 #include "preprocess/btorpreprocess.h"
+#include "preprocess/btorunconstrained.h"
 #include "preprocess/btorvarsubst.h"
 #include "utils/btorhashint.h"
 #include "utils/btornodeiter.h"
@@ -283,6 +286,26 @@ btor_reset_time (Btor *btor)
   BTOR_CLR (&btor->time);
 }
 
+static void
+delete_rw_rules_profile (Btor *btor)
+{
+  assert (btor);
+  assert (btor->stats.rw_rules_profile);
+
+  BtorPtrHashTableIterator it;
+  BtorRwRuleProfile *p;
+
+  btor_iter_hashptr_init (&it, btor->stats.rw_rules_profile);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    p = it.bucket->data.as_ptr;
+    (void) btor_iter_hashptr_next (&it);
+    BTOR_DELETE (btor->mm, p);
+  }
+  btor_hashptr_table_delete (btor->stats.rw_rules_profile);
+  btor->stats.rw_rules_profile = 0;
+}
+
 void
 btor_reset_stats (Btor *btor)
 {
@@ -291,12 +314,15 @@ btor_reset_stats (Btor *btor)
   if (btor->stats.rw_rules_applied)
     btor_hashptr_table_delete (btor->stats.rw_rules_applied);
 #endif
+  if (btor->stats.rw_rules_profile) delete_rw_rules_profile (btor);
   BTOR_CLR (&btor->stats);
 #ifndef NDEBUG
   assert (!btor->stats.rw_rules_applied);
   btor->stats.rw_rules_applied = btor_hashptr_table_new (
       btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
 #endif
+  btor->stats.rw_rules_profile = btor_hashptr_table_new (
+      btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
 }
 
 static uint32_t
@@ -403,6 +429,97 @@ percent (double a, double b)
 }
 #endif
 
+static int32_t
+compare_rw_rule_profile (const void *p1, const void *p2)
+{
+  BtorRwRuleProfile *a, *b;
+
+  a = *((BtorRwRuleProfile **) p1);
+  b = *((BtorRwRuleProfile **) p2);
+  if (a->cycles != b->cycles) return a->cycles < b->cycles ? 1 : -1;
+  return strcmp (a->name, b->name);
+}
+
+/* Print rewrite rule profile sorted by cycles, as a table (rw-profile=1) or
+ * as one JSON object per rule and line on stdout (rw-profile=2). */
+static void
+print_rw_rules_profile (Btor *btor)
+{
+  assert (btor);
+
+  BtorPtrHashTableIterator it;
+  BtorRwRuleProfile **rules, *p;
+  uint32_t i, n;
+  uint_least64_t bound;
+
+  n = btor->stats.rw_rules_profile->count;
+  BTOR_NEWN (btor->mm, rules, n ? n : 1);
+  i = 0;
+  btor_iter_hashptr_init (&it, btor->stats.rw_rules_profile);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    rules[i++] = it.bucket->data.as_ptr;
+    (void) btor_iter_hashptr_next (&it);
+  }
+  assert (i == n);
+  qsort (rules, n, sizeof (*rules), compare_rw_rule_profile);
+
+  for (i = 0, bound = 0; i < n; i++) bound += rules[i]->bound;
+
+  if (btor_opt_get (btor, BTOR_OPT_RW_PROFILE) == 2)
+  {
+    /* no message prefix, every line is a JSON object */
+    for (i = 0; i < n; i++)
+    {
+      p = rules[i];
+      fprintf (stdout,
+               "{\"rule\": \"%s\", \"attempts\": %" PRIu64
+               ", \"hits\": %" PRIu64 ", \"bound\": %" PRIu64
+               ", \"cycles\": %" PRIu64 ", \"nodes\": %" PRId64 "}\n",
+               p->name,
+               p->attempts,
+               p->hits,
+               p->bound,
+               p->cycles,
+               p->nodes);
+    }
+    fprintf (stdout, "{\"rec_rw_bound\": %" PRIu64 "}\n", bound);
+    fflush (stdout);
+  }
+  else
+  {
+    BTOR_MSG (btor->msg, 1, "rewriting rules profile:");
+    BTOR_MSG (btor->msg,
+              1,
+              "  %10s %10s %8s %14s %9s %s",
+              "attempts",
+              "hits",
+              "bound",
+              "cycles",
+              "nodes",
+              "rule");
+    for (i = 0; i < n; i++)
+    {
+      p = rules[i];
+      BTOR_MSG (btor->msg,
+                1,
+                "  %10" PRIu64 " %10" PRIu64 " %8" PRIu64 " %14" PRIu64
+                " %9" PRId64 " %s",
+                p->attempts,
+                p->hits,
+                p->bound,
+                p->cycles,
+                p->nodes,
+                p->name);
+    }
+    BTOR_MSG (btor->msg,
+              1,
+              "  %" PRIu64 " attempts failed at recursive rewriting bound",
+              bound);
+  }
+  BTOR_DELETEN (btor->mm, rules, n ? n : 1);
+}
+
 void
 btor_print_stats (Btor *btor)
 {
@@ -457,6 +574,10 @@ btor_print_stats (Btor *btor)
               1,
               "%5d unconstrained parameterized props",
               btor->stats.param_uc_props);
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d unconstrained terms restored",
+              btor->stats.uc_restored);
   }
   BTOR_MSG (btor->msg,
             1,
@@ -497,6 +618,36 @@ btor_print_stats (Btor *btor)
       btor->msg, 1, "%5d add normalizations", btor->stats.adds_normalized);
   BTOR_MSG (
       btor->msg, 1, "%5d mul normalizations", btor->stats.muls_normalized);
+  if (btor_opt_get (btor, BTOR_OPT_RW_DEFERRED))
+    BTOR_MSG (btor->msg,
+              1,
+              "%5lld deferred nodes re-rewritten in %u rounds",
+              btor->stats.rw_deferred_nodes,
+              btor->stats.rw_deferred_rounds);
+  if (btor_opt_get (btor, BTOR_OPT_EGRAPH))
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d constraints substituted in %u equality saturation rounds",
+              btor->stats.egraph_substitutions,
+              btor->stats.egraph_rounds);
+  if (btor_opt_get (btor, BTOR_OPT_KNOWN_BITS))
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d variables split and %u terms substituted by known bits",
+              btor->stats.known_bits_vars,
+              btor->stats.known_bits_substs);
+  if (btor_opt_get (btor, BTOR_OPT_BV_REDUCE))
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d terms with reduced bit-width (%llu AIG nodes saved)",
+              btor->stats.bv_reduced,
+              btor->stats.bv_reduce_aigs);
+  if (btor_opt_get (btor, BTOR_OPT_COMPONENTS))
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d variable-disjoint components (%u results reused)",
+              btor->stats.components,
+              btor->stats.components_cached);
   BTOR_MSG (btor->msg, 1, "%5lld lambdas merged", btor->stats.lambdas_merged);
   BTOR_MSG (btor->msg,
             1,
@@ -543,6 +694,8 @@ btor_print_stats (Btor *btor)
   }
 #endif
 
+  if (btor_opt_get (btor, BTOR_OPT_RW_PROFILE)) print_rw_rules_profile (btor);
+
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg, 1, "bit blasting statistics:");
   BTOR_MSG (btor->msg,
@@ -571,6 +724,11 @@ btor_print_stats (Btor *btor)
             1,
             "  %7lld CNF literals",
             btor->avmgr ? btor->avmgr->amgr->num_cnf_literals : 0);
+  if (btor_opt_get (btor, BTOR_OPT_LAZY_ENCODE))
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld CNF variables retired",
+              btor->avmgr ? btor->avmgr->amgr->num_cnf_vars_retired : 0);
 
   if (btor->slv) btor->slv->api.print_stats (btor->slv);
 
@@ -596,6 +754,11 @@ btor_print_stats (Btor *btor)
 
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg, 1, "%.2f seconds solving", btor->time.sat);
+  if (btor_opt_get (btor, BTOR_OPT_COMPONENTS))
+    BTOR_MSG (btor->msg,
+              1,
+              "  %.2f seconds independent components",
+              btor->time.components);
   BTOR_MSG (
       btor->msg, 1, "  %.2f seconds rewriting engine", btor->time.simplify);
   BTOR_MSG (btor->msg,
@@ -613,6 +776,34 @@ btor_print_stats (Btor *btor)
             btor->time.embedded,
             percent (btor->time.embedded, btor->time.simplify));
 
+  if (btor_opt_get (btor, BTOR_OPT_RW_DEFERRED))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds deferred rewriting (%.0f%%)",
+              btor->time.rw_deferred,
+              percent (btor->time.rw_deferred, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_EGRAPH))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds equality saturation (%.0f%%)",
+              btor->time.egraph,
+              percent (btor->time.egraph, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_KNOWN_BITS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds known bits propagation (%.0f%%)",
+              btor->time.known_bits,
+              percent (btor->time.known_bits, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_BV_REDUCE))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds bit-width reduction (%.0f%%)",
+              btor->time.bv_reduce,
+              percent (btor->time.bv_reduce, btor->time.simplify));
+
   if (btor_opt_get (btor, BTOR_OPT_ELIMINATE_SLICES))
     BTOR_MSG (btor->msg,
               1,
@@ -769,16 +960,20 @@ btor_new (void)
   BTOR_INIT_STACK (mm, btor->assertions);
   BTOR_INIT_STACK (mm, btor->assertions_trail);
   btor->assertions_cache = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, btor->ucdefs);
 
 #ifndef NDEBUG
   btor->stats.rw_rules_applied = btor_hashptr_table_new (
       mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
 #endif
+  btor->stats.rw_rules_profile = btor_hashptr_table_new (
+      mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
 
   btor->true_exp = btor_exp_true (btor);
 
   BTOR_CNEW (mm, btor->rw_cache);
   btor_rw_cache_init (btor->rw_cache, btor);
+  btor->rw_deferred = btor_hashint_table_new (mm);
 
   return btor;
 }
@@ -946,6 +1141,8 @@ btor_delete (Btor *btor)
   BTOR_RELEASE_STACK (btor->assertions_trail);
   btor_hashint_table_delete (btor->assertions_cache);
 
+  btor_components_delete_cache (btor);
+  btor_delete_unconstrained_defs (btor);
   btor_model_delete (btor);
   btor_node_release (btor, btor->true_exp);
 
@@ -1049,12 +1246,14 @@ btor_delete (Btor *btor)
 #ifndef NDEBUG
   btor_hashptr_table_delete (btor->stats.rw_rules_applied);
 #endif
+  delete_rw_rules_profile (btor);
 
   if (btor->avmgr) btor_aigvec_mgr_delete (btor->avmgr);
   btor_opt_delete_opts (btor);
 
   btor_rw_cache_delete (btor->rw_cache);
   BTOR_DELETE (mm, btor->rw_cache);
+  btor_hashint_table_delete (btor->rw_deferred);
 
   assert (btor->rec_rw_calls == 0);
   btor_msg_delete (btor->msg);
@@ -2469,6 +2668,53 @@ btor_substitute_node (Btor *btor,
 
 /*------------------------------------------------------------------------*/
 
+/* Synthesize udiv and urem nodes over the same children with one shared
+ * divider. If the sibling of 'exp' (urem for udiv and vice versa) exists but
+ * is not synthesized yet, it gets the other output of the divider. */
+static void
+synthesize_udiv_urem (
+    Btor *btor, BtorNode *exp, BtorAIGVec *av0, BtorAIGVec *av1, bool encode)
+{
+  assert (btor_node_is_regular (exp));
+  assert (btor_node_is_bv_udiv (exp) || btor_node_is_bv_urem (exp));
+
+  BtorNode *sibling;
+  BtorNodeKind kind;
+  BtorAIGVec *quotient, *remainder;
+
+  kind    = btor_node_is_bv_udiv (exp) ? BTOR_BV_UREM_NODE : BTOR_BV_UDIV_NODE;
+  sibling = btor_node_get_bv_exp (btor, kind, exp->e, 2);
+  btor_aigvec_udiv_urem (btor->avmgr, av0, av1, &quotient, &remainder);
+
+  if (sibling && !btor_node_is_synth (sibling)
+      && !btor_node_is_simplified (sibling))
+  {
+    assert (!sibling->parameterized);
+    if (btor_node_is_bv_udiv (exp))
+    {
+      exp->av     = quotient;
+      sibling->av = remainder;
+    }
+    else
+    {
+      exp->av     = remainder;
+      sibling->av = quotient;
+    }
+    BTORLOG (2, "  synthesized: %s", btor_util_node2string (sibling));
+    if (encode) btor_aigvec_to_sat_tseitin (btor->avmgr, sibling->av);
+  }
+  else if (btor_node_is_bv_udiv (exp))
+  {
+    exp->av = quotient;
+    btor_aigvec_release_delete (btor->avmgr, remainder);
+  }
+  else
+  {
+    exp->av = remainder;
+    btor_aigvec_release_delete (btor->avmgr, quotient);
+  }
+}
+
 /* bit vector skeleton is always encoded, i.e., if btor_node_is_synth is true,
  * then it is also encoded. with option lazy_synthesize enabled,
  * 'btor_synthesize_exp' stops at feq and apply nodes */
@@ -2493,7 +2739,7 @@ btor_synthesize_exp (Btor *btor,
   bool invert_av1 = false;
   bool invert_av2 = false;
   double start;
-  bool restart, opt_lazy_synth;
+  bool restart, opt_lazy_synth, opt_lazy_encode;
   BtorIntHashTable *cache;
 
   assert (btor);
@@ -2505,6 +2751,7 @@ btor_synthesize_exp (Btor *btor,
   count          = 0;
   cache          = btor_hashint_table_new (mm);
   opt_lazy_synth = btor_opt_get (btor, BTOR_OPT_FUN_LAZY_SYNTHESIZE) == 1;
+  opt_lazy_encode = btor_opt_get (btor, BTOR_OPT_LAZY_ENCODE) == 1;
 
   BTOR_INIT_STACK (mm, exp_stack);
   BTOR_PUSH_STACK (exp_stack, exp);
@@ -2684,10 +2931,9 @@ btor_synthesize_exp (Btor *btor,
             cur->av = btor_aigvec_srl (avmgr, av0, av1);
             break;
           case BTOR_BV_UDIV_NODE:
-            cur->av = btor_aigvec_udiv (avmgr, av0, av1);
-            break;
           case BTOR_BV_UREM_NODE:
-            cur->av = btor_aigvec_urem (avmgr, av0, av1);
+            synthesize_udiv_urem (
+                btor, cur, av0, av1, !opt_lazy_synth && !opt_lazy_encode);
             break;
           default:
             assert (cur->kind == BTOR_BV_CONCAT_NODE);
@@ -2705,7 +2951,8 @@ btor_synthesize_exp (Btor *btor,
           if (invert_av0) btor_aigvec_invert (avmgr, av0);
           if (invert_av1) btor_aigvec_invert (avmgr, av1);
         }
-        if (!opt_lazy_synth) btor_aigvec_to_sat_tseitin (avmgr, cur->av);
+        if (!opt_lazy_synth && !opt_lazy_encode)
+          btor_aigvec_to_sat_tseitin (avmgr, cur->av);
       }
       else
       {
@@ -2754,7 +3001,10 @@ btor_synthesize_exp (Btor *btor,
       }
       assert (cur->av);
       BTORLOG (2, "  synthesized: %s", btor_util_node2string (cur));
-      btor_aigvec_to_sat_tseitin (avmgr, cur->av);
+      /* with lazy encoding, only the cones of constraints and assumptions
+       * are encoded (see btor_aig_add_toplevel_to_sat and
+       * btor_add_again_assumptions) */
+      if (!opt_lazy_encode) btor_aigvec_to_sat_tseitin (avmgr, cur->av);
     }
   }
   BTOR_RELEASE_STACK (exp_stack);
@@ -2783,11 +3033,17 @@ btor_add_again_assumptions (Btor *btor)
   BtorSATMgr *smgr;
   BtorAIGMgr *amgr;
   BtorIntHashTable *mark;
+  BtorAIGPtrStack roots;
+  bool opt_lazy_encode;
+  uint32_t retired;
 
   amgr = btor_get_aig_mgr (btor);
   smgr = btor_get_sat_mgr (btor);
 
+  opt_lazy_encode = btor_opt_get (btor, BTOR_OPT_LAZY_ENCODE) == 1;
+
   BTOR_INIT_STACK (btor->mm, stack);
+  BTOR_INIT_STACK (btor->mm, roots);
   mark = btor_hashint_table_new (btor->mm);
 
   assumptions = btor_hashptr_table_new (btor->mm,
@@ -2834,16 +3090,30 @@ btor_add_again_assumptions (Btor *btor)
     assert (btor_node_bv_get_width (btor, cur) == 1);
     assert (!btor_node_is_simplified (cur));
     aig = exp_to_aig (btor, cur);
-    btor_aig_to_sat (amgr, aig);
+    btor_aig_assumption_to_sat (amgr, aig);
     if (aig == BTOR_AIG_TRUE) continue;
     if (btor_sat_is_initialized (smgr))
     {
       assert (btor_aig_get_cnf_id (aig) != 0);
       btor_sat_assume (smgr, btor_aig_get_cnf_id (aig));
     }
-    btor_aig_release (amgr, aig);
+    if (opt_lazy_encode && !btor_aig_is_const (aig))
+      BTOR_PUSH_STACK (roots, aig);
+    else
+      btor_aig_release (amgr, aig);
   }
 
+  /* retire encoded cones of previous assumptions */
+  if (opt_lazy_encode)
+  {
+    retired = btor_aig_retire_assumption_cones (amgr, &roots);
+    if (retired)
+      BTOR_MSG (btor->msg, 2, "retired %u CNF variables", retired);
+    while (!BTOR_EMPTY_STACK (roots))
+      btor_aig_release (amgr, BTOR_POP_STACK (roots));
+  }
+
+  BTOR_RELEASE_STACK (roots);
   BTOR_RELEASE_STACK (stack);
   btor_hashptr_table_delete (assumptions);
   btor_hashint_table_delete (mark);
@@ -2886,6 +3156,7 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
   double start, delta;
   BtorSolverResult res;
   uint32_t engine;
+  bool solved = false;
 
   start = btor_util_time_stamp ();
 
@@ -2972,9 +3243,20 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
     btor_opt_set (btor, BTOR_OPT_BETA_REDUCE, BTOR_BETA_REDUCE_ALL);
   }
 
-  res = btor_simplify (btor);
+  /* terms eliminated as unconstrained in previous calls have to be restored
+   * before splitting the formula into components if their inputs occur in
+   * new constraints or assumptions */
+  if (BTOR_COUNT_STACK (btor->ucdefs) > 0) btor_restore_unconstrained (btor);
+
+  if (btor_opt_get (btor, BTOR_OPT_COMPONENTS))
+  {
+    res    = btor_components_check_sat (btor);
+    solved = res != BTOR_RESULT_UNKNOWN;
+  }
+
+  if (!solved) res = btor_simplify (btor);
 
-  if (res != BTOR_RESULT_UNSAT)
+  if (!solved && res != BTOR_RESULT_UNSAT)
   {
     engine = btor_opt_get (btor, BTOR_OPT_ENGINE);
 
@@ -3053,6 +3335,8 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
         btor->slv->api.generate_model (
             btor->slv, btor_opt_get (btor, BTOR_OPT_MODEL_GEN) == 2, true);
     }
+    if (BTOR_COUNT_STACK (btor->ucdefs) > 0)
+      btor_extend_model_unconstrained (btor);
   }
 
 #ifndef NDEBUG
@@ -3069,7 +3353,9 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   if (chkmodel)
   {
-    if (res == BTOR_RESULT_SAT && !btor_opt_get (btor, BTOR_OPT_UCOPT))
+    if (res == BTOR_RESULT_SAT
+        && (!btor_opt_get (btor, BTOR_OPT_UCOPT)
+            || btor_opt_get (btor, BTOR_OPT_MODEL_GEN)))
     {
       btor_check_model (chkmodel);
     }
@@ -3078,7 +3364,7 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 #endif
 
 #ifndef NDEBUG
-  if (check && btor_opt_get (btor, BTOR_OPT_CHK_FAILED_ASSUMPTIONS)
+  if (check && !solved && btor_opt_get (btor, BTOR_OPT_CHK_FAILED_ASSUMPTIONS)
       && !btor->inconsistent && btor->last_sat_result == BTOR_RESULT_UNSAT)
     btor_check_failed_assumptions (btor);
 #endif
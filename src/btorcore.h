@@ -61,6 +61,39 @@ struct BtorNodeUniqueTable
 
 typedef struct BtorNodeUniqueTable BtorNodeUniqueTable;
 
+/* Rewrite rule profile (see option BTOR_OPT_RW_PROFILE), cycles and node
+ * delta include the rewrites triggered recursively by the rule. */
+struct BtorRwRuleProfile
+{
+  const char *name;
+  uint_least64_t attempts; /* number of applicability checks */
+  uint_least64_t hits;     /* number of successful applications */
+  uint_least64_t bound;    /* attempts failed due to BTOR_REC_RW_BOUND */
+  uint_least64_t cycles;   /* cycles spent in checking and applying */
+  int_least64_t nodes;     /* net change of the number of unique nodes */
+};
+
+typedef struct BtorRwRuleProfile BtorRwRuleProfile;
+
+/* Definition of a term that was substituted by a fresh variable by the
+ * unconstrained optimization in incremental mode or with model generation
+ * (see btorunconstrained.c). */
+struct BtorUCDef
+{
+  BtorNode *var;   /* fresh variable substituted for the term */
+  BtorNodeKind kind;
+  uint32_t upper;  /* slice indices */
+  uint32_t lower;
+  uint32_t arity;
+  BtorNode *e[3];  /* children of the term */
+  bool uc[3];      /* unconstrained children */
+  bool restored;   /* definition asserted as constraint */
+};
+
+typedef struct BtorUCDef BtorUCDef;
+
+BTOR_DECLARE_STACK (BtorUCDef, BtorUCDef);
+
 struct BtorCallbacks
 {
   struct
@@ -127,6 +160,11 @@ struct Btor
   uint32_t rec_rw_calls; /* calls for recursive rewriting */
   uint32_t valid_assignments;
   BtorRwCache *rw_cache;
+  BtorIntHashTable *rw_deferred; /* ids of nodes created at the recursive
+                                    rewriting bound */
+  BtorPtrHashTable *components_cache; /* results of variable-disjoint
+                                         components of the last call */
+  BtorUCDefStack ucdefs; /* definitions of eliminated unconstrained terms */
 
   int32_t vis_idx; /* file index for visualizing expressions */
 
@@ -193,12 +231,23 @@ struct Btor
     uint32_t adds_normalized;       /* number of add chains normalizations */
     uint32_t ands_normalized;       /* number of and chains normalizations */
     uint32_t muls_normalized;       /* number of mul chains normalizations */
+    uint32_t rw_deferred_rounds;    /* rounds of deferred re-rewriting */
+    uint_least64_t rw_deferred_nodes; /* number of re-rewritten nodes */
+    uint32_t egraph_rounds;           /* equality saturation rounds */
+    uint32_t egraph_substitutions;    /* constraints substituted by e-graph */
+    uint32_t components;              /* variable-disjoint components */
+    uint32_t known_bits_vars;         /* variables split by known bits */
+    uint32_t known_bits_substs;       /* terms substituted by known bits */
+    uint32_t bv_reduced;              /* terms with reduced bit-width */
+    uint_least64_t bv_reduce_aigs;    /* AIG nodes saved by bv_reduced */
+    uint32_t components_cached;       /* component results reused */
     uint32_t ackermann_constraints;
     uint_least64_t prop_apply_lambda; /* number of static props over lambdas */
     uint_least64_t prop_apply_update; /* number of static props over updates */
     uint32_t bv_uc_props;
     uint32_t fun_uc_props;
     uint32_t param_uc_props;
+    uint32_t uc_restored; /* unconstrained terms restored as constraints */
     uint_least64_t lambdas_merged;
     BtorConstraintStats constraints;
     BtorConstraintStats oldconstraints;
@@ -210,6 +259,7 @@ struct Btor
 #ifndef NDEBUG
     BtorPtrHashTable *rw_rules_applied;
 #endif
+    BtorPtrHashTable *rw_rules_profile; /* maps rule names to profiles */
     uint_least64_t rewrite_synth;
   } stats;
 
@@ -221,6 +271,11 @@ struct Btor
     double subst_rebuild;
     double elimapplies;
     double embedded;
+    double rw_deferred;
+    double egraph;
+    double known_bits;
+    double bv_reduce;
+    double components;
     double slicing;
     double skel;
     double propagate;
@@ -14,6 +14,7 @@
 #include "btorcore.h"
 #include "btordbg.h"
 #include "btorrewrite.h"
+#include "utils/btorutil.h"
 
 #include <limits.h>
 
@@ -1185,10 +1186,9 @@ exp_rotate (Btor *btor, BtorNode *e0, BtorNode *e1, bool left)
   assert (btor == btor_node_real_addr (e0)->btor);
   assert (btor == btor_node_real_addr (e1)->btor);
 
-  uint32_t width;
-  BtorNode *w, *nbits, *dbits, *cond, *zero, *lshift, *rshift, *rot;
-  BtorNode *res;
-  BtorSortId sort;
+  uint32_t i, width;
+  uint64_t n;
+  BtorNode *w, *nbits, *bit, *rot, *tmp, *res;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -1198,39 +1198,34 @@ exp_rotate (Btor *btor, BtorNode *e0, BtorNode *e1, bool left)
   assert (width > 0);
   if (width == 1) return btor_node_copy (btor, e0);
 
-  /* actual number of bits to rotate is e1 % width */
-  sort  = btor_node_get_sort_id (e0);
-  w     = btor_exp_bv_unsigned (btor, width, sort);
-  nbits = btor_exp_bv_urem (btor, e1, w);
-  dbits = btor_exp_bv_sub (btor, w, nbits); /* width - nbits */
-
-  /* rotate left: (e0 << nbits) | (e0 >> (dbits))
-   * rotate right: (e0 >> nbits) | (e0 << (dbits)) */
-  if (left)
+  /* actual number of bits to rotate is e1 % width, which for power of 2
+   * widths is given by the lower log2(width) bits of e1 */
+  if (btor_util_is_power_of_2 (width))
   {
-    lshift = btor_exp_bv_sll (btor, e0, nbits);
-    rshift = btor_exp_bv_srl (btor, e0, dbits);
+    nbits = btor_node_copy (btor, e1);
   }
   else
   {
-    lshift = btor_exp_bv_sll (btor, e0, dbits);
-    rshift = btor_exp_bv_srl (btor, e0, nbits);
+    w     = btor_exp_bv_unsigned (btor, width, btor_node_get_sort_id (e0));
+    nbits = btor_exp_bv_urem (btor, e1, w);
+    btor_node_release (btor, w);
   }
-  rot = btor_exp_bv_or (btor, lshift, rshift);
-
-  /* if nbits == 0 -> exp, else we have to rotate */
-  zero = btor_exp_bv_zero (btor, sort);
-  cond = btor_exp_eq (btor, nbits, zero);
-  res  = btor_exp_cond (btor, cond, e0, rot);
 
-  btor_node_release (btor, rot);
-  btor_node_release (btor, rshift);
-  btor_node_release (btor, lshift);
-  btor_node_release (btor, zero);
-  btor_node_release (btor, cond);
-  btor_node_release (btor, dbits);
+  /* logarithmic rotator: stage i rotates by 2^i if bit i of nbits is set,
+   * where rotating by a constant is a concatenation of slices */
+  res = btor_node_copy (btor, e0);
+  for (i = 0, n = 1; n < width; i++, n *= 2)
+  {
+    bit = btor_exp_bv_slice (btor, nbits, i, i);
+    rot = left ? btor_exp_bv_roli (btor, res, n)
+               : btor_exp_bv_rori (btor, res, n);
+    tmp = btor_exp_cond (btor, bit, rot, res);
+    btor_node_release (btor, bit);
+    btor_node_release (btor, rot);
+    btor_node_release (btor, res);
+    res = tmp;
+  }
   btor_node_release (btor, nbits);
-  btor_node_release (btor, w);
   return res;
 }
 
@@ -2747,6 +2747,9 @@ btormbt_state_opt (BtorMBT *mbt)
     /* pick SAT engine randomly */
     btoropt->val =
         btor_rng_pick_rand (&mbt->round.rng, btoropt->min, btoropt->max);
+    /* IPASIR solvers can only be used if a library is given */
+    if (btoropt->val == BTOR_SAT_ENGINE_IPASIR && !getenv ("BTORIPASIRLIB"))
+      btoropt->val = BTOR_SAT_ENGINE_DFLT;
   }
 
   if (btor_rng_pick_with_prob (&mbt->round.rng, 500))
@@ -2765,6 +2768,8 @@ btormbt_state_opt (BtorMBT *mbt)
       boolector_set_sat_solver (mbt->btor, "minisat");
     else if (btoropt->val == BTOR_SAT_ENGINE_CMS)
       boolector_set_sat_solver (mbt->btor, "cryptominisat");
+    else if (btoropt->val == BTOR_SAT_ENGINE_IPASIR)
+      boolector_set_sat_solver (mbt->btor, "ipasir");
     else
       boolector_set_sat_solver (mbt->btor, "picosat");
   }
@@ -2836,23 +2841,8 @@ btormbt_state_opt (BtorMBT *mbt)
     }
 
     /* avoid invalid option combinations */
-    // FIXME remove as soon as ucopt works with mgen
-    /* do not enable unconstrained optimization if either model
-     * generation or incremental is enabled */
-    if (btoropt->kind == BTOR_OPT_UCOPT
-        && (boolector_get_opt (mbt->btor, BTOR_OPT_MODEL_GEN)
-            || boolector_get_opt (mbt->btor, BTOR_OPT_INCREMENTAL)))
-    {
-      continue;
-    }
-    else if ((btoropt->kind == BTOR_OPT_MODEL_GEN
-              || btoropt->kind == BTOR_OPT_INCREMENTAL)
-             && boolector_get_opt (mbt->btor, BTOR_OPT_UCOPT))
-    {
-      continue;
-    }
     /* do not enable justification if dual propagation is enabled */
-    else if (btoropt->kind == BTOR_OPT_FUN_JUST
+    if (btoropt->kind == BTOR_OPT_FUN_JUST
              && boolector_get_opt (mbt->btor, BTOR_OPT_FUN_DUAL_PROP))
     {
       continue;
@@ -126,7 +126,7 @@ btor_model_remove_from_bv (Btor *btor,
   btor_node_release (btor, exp);
   if (btor_hashint_map_contains (bv_model, -id))
   {
-    btor_hashint_map_remove (bv_model, id, &d);
+    btor_hashint_map_remove (bv_model, -id, &d);
     btor_bv_free (btor->mm, d.as_ptr);
     btor_node_release (btor, exp);
   }
@@ -423,6 +423,11 @@ recursively_compute_function_model (Btor *btor,
   }
 }
 
+static void ensure_model (Btor *btor,
+                          BtorIntHashTable *bv_model,
+                          BtorIntHashTable *fun_model,
+                          BtorNode *exp);
+
 const BtorPtrHashTable *
 btor_model_get_fun_aux (Btor *btor,
                         BtorIntHashTable *bv_model,
@@ -450,9 +455,15 @@ btor_model_get_fun_aux (Btor *btor,
   /* if exp has no assignment, regenerate model in case that it is an exp
    * that previously existed but was simplified (i.e. the original exp is now
    * a proxy and was therefore regenerated when querying it's assignment via
-   * get-value in SMT-LIB v2) */
-  if (!d) recursively_compute_function_model (btor, bv_model, fun_model, exp);
-  d = btor_hashint_map_get (fun_model, exp->id);
+   * get-value in SMT-LIB v2), or if the model is generated lazily.
+   * Note: we compute the model of all terms below exp in ascending id order
+   * (as btor_model_generate does) to make sure that the model of a function
+   * is complete and not only populated by the applies evaluated so far */
+  if (!d)
+  {
+    ensure_model (btor, bv_model, fun_model, exp);
+    d = btor_hashint_map_get (fun_model, exp->id);
+  }
   if (!d) return 0;
 
   return (BtorPtrHashTable *) d->as_ptr;
@@ -501,6 +512,20 @@ compute_model_values (Btor *btor,
   }
 }
 
+static void
+push_rho (BtorNodePtrStack *visit, BtorPtrHashTable *rho)
+{
+  BtorPtrHashTableIterator it;
+
+  if (!rho) return;
+  btor_iter_hashptr_init (&it, rho);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    BTOR_PUSH_STACK (*visit, it.bucket->data.as_ptr);
+    BTOR_PUSH_STACK (*visit, btor_iter_hashptr_next (&it));
+  }
+}
+
 /* Ensure that all terms in 'exp' have a model value. Collect all terms in
  * 'exp' that don't have a model value and call corresponding
  * recursively_compute_* functions. */
@@ -545,6 +570,17 @@ ensure_model (Btor *btor,
     {
       BTOR_PUSH_STACK (visit, cur->e[i]);
     }
+
+    /* The model of a function is computed from its rho, whose arguments
+     * and values are not below the function. Evaluating them may add values
+     * of applies to the models of other functions, which therefore have to
+     * be computed in the same pass in order to be complete. */
+    if (btor_node_is_fun (cur) && !cur->parameterized)
+    {
+      push_rho (&visit, cur->rho);
+      if (btor_node_is_lambda (cur))
+        push_rho (&visit, btor_node_lambda_get_static_rho (cur));
+    }
   } while (!BTOR_EMPTY_STACK (visit));
   BTOR_RELEASE_STACK (visit);
   btor_hashint_table_delete (cache);
@@ -1586,6 +1586,25 @@ find_bv_exp (Btor *btor, BtorNodeKind kind, BtorNode *e[], uint32_t arity)
   return result;
 }
 
+BtorNode *
+btor_node_get_bv_exp (Btor *btor,
+                      BtorNodeKind kind,
+                      BtorNode *e[],
+                      uint32_t arity)
+{
+  assert (btor);
+  assert (e);
+  assert (arity > 0);
+  assert (arity <= 3);
+
+  uint32_t i;
+  BtorNode *ee[3];
+
+  /* do not let find_bv_exp reorder the caller's children */
+  for (i = 0; i < arity; i++) ee[i] = e[i];
+  return *find_bv_exp (btor, kind, ee, arity);
+}
+
 static int32_t compare_binder_exp (Btor *btor,
                                    BtorNode *param,
                                    BtorNode *body,
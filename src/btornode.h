@@ -640,6 +640,14 @@ int32_t btor_node_get_btor_id (BtorNode *exp);
  *       will return an inverted node */
 BtorNode *btor_node_get_by_id (Btor *btor, int32_t id);
 
+/* Get the bit-vector exp (belonging to instance 'btor') of given kind and
+ * children if it exists, and 0 otherwise.
+ * Note: does NOT increase the reference counter */
+BtorNode *btor_node_get_bv_exp (Btor *btor,
+                                BtorNodeKind kind,
+                                BtorNode *e[],
+                                uint32_t arity);
+
 /* Retrieve the exp (belonging to instance 'btor') that matches given id.
  * Note: increases ref counter of returned match!
  * Note: 'id' must be greater 0
@@ -28,6 +28,7 @@ const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1] = {
     [BTOR_SAT_ENGINE_MINISAT]   = "MiniSat",
     [BTOR_SAT_ENGINE_CADICAL]   = "CaDiCaL",
     [BTOR_SAT_ENGINE_CMS]       = "CryptoMiniSat",
+    [BTOR_SAT_ENGINE_IPASIR]    = "IPASIR",
 };
 
 /*------------------------------------------------------------------------*/
@@ -341,6 +342,12 @@ btor_opt_init_opts (Btor *btor)
                 "picosat",
                 BTOR_SAT_ENGINE_PICOSAT,
                 "use picosat as back end SAT solver");
+  add_opt_help (mm,
+                opts,
+                "ipasir",
+                BTOR_SAT_ENGINE_IPASIR,
+                "use IPASIR library given by environment variable "
+                "BTORIPASIRLIB as back end SAT solver");
   btor->options[BTOR_OPT_SAT_ENGINE].options = opts;
 
   init_opt (btor,
@@ -1361,6 +1368,19 @@ btor_opt_init_opts (Btor *btor)
             1,
             UINT32_MAX,
             "number of threads to use in the SAT solver");
+  init_opt (btor,
+            BTOR_OPT_SAT_ENGINE_CUBES,
+            true,
+            false,
+            "sat-engine-cubes",
+            0,
+            0,
+            0,
+            16,
+            "split unlimited SAT calls into 2^n cubes solved by "
+            "sat-engine-n-threads workers (cube-and-conquer), the CNF is "
+            "copied into every worker in addition to the main SAT solver and "
+            "the clause buffer of the workers");
   init_opt (btor,
             BTOR_OPT_SIMP_NORMAMLIZE_ADDERS,
             true,
@@ -1412,6 +1432,203 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "enable non-destructive term substitutions");
+  init_opt (btor,
+            BTOR_OPT_LAZY_ENCODE,
+            true,
+            true,
+            "lazy-encode",
+            0,
+            0,
+            0,
+            1,
+            "encode only the cones of constraints and current assumptions "
+            "and retire cones of previous assumptions");
+  init_opt (btor,
+            BTOR_OPT_UDIV_MUL_ENCODE,
+            true,
+            true,
+            "udiv-mul-encode",
+            0,
+            0,
+            0,
+            1,
+            "encode udiv/urem via q * y + r = x and r < y instead of a "
+            "divider circuit");
+  init_opt (btor,
+            BTOR_OPT_FUN_INC_CHECK,
+            true,
+            true,
+            "fun-inc-check",
+            0,
+            0,
+            0,
+            1,
+            "re-check only applies with changed assignments in consecutive "
+            "refinement rounds");
+  init_opt (btor,
+            BTOR_OPT_FUN_STORE_CHAINS,
+            true,
+            true,
+            "fun-store-chains",
+            0,
+            0,
+            0,
+            1,
+            "propagate reads over store chains via index sets instead of "
+            "store by store");
+  init_opt (btor,
+            BTOR_OPT_FUN_BETAP_CACHE,
+            true,
+            true,
+            "fun-betap-cache",
+            0,
+            0,
+            0,
+            1,
+            "cache partial beta reduction results of lambdas across "
+            "refinement rounds and SAT calls");
+  init_opt (btor,
+            BTOR_OPT_FUN_LEMMA_MIN,
+            true,
+            true,
+            "fun-lemma-min",
+            0,
+            0,
+            0,
+            1,
+            "drop lemma premises implied by the formula and remove lemmas "
+            "subsumed by other lemmas of the same refinement round");
+  init_opt (btor,
+            BTOR_OPT_MODEL_LAZY,
+            true,
+            true,
+            "model-lazy",
+            0,
+            0,
+            0,
+            1,
+            "compute model values on demand when queried instead of "
+            "generating the model after each satisfiable call");
+  init_opt (btor,
+            BTOR_OPT_MODEL_RANGES,
+            true,
+            true,
+            "model-ranges",
+            0,
+            0,
+            0,
+            1,
+            "print models of arrays and unary functions in SMT-LIB format "
+            "as index ranges over a default value");
+  init_opt (btor,
+            BTOR_OPT_FUN_DUAL_PROP_AIG,
+            true,
+            true,
+            "fun-dual-prop-aig",
+            0,
+            0,
+            0,
+            1,
+            "dual propagation via justification on the AIG layer of the SAT "
+            "assignment (no clone, takes precedence over --fun-just)");
+  init_opt (btor,
+            BTOR_OPT_RW_PROFILE,
+            true,
+            true,
+            "rw-profile",
+            0,
+            0,
+            0,
+            2,
+            "profile rewrite rules (attempts, hits, cycles, node delta), "
+            "print statistics as table (1) or JSON lines (2)");
+  init_opt (btor,
+            BTOR_OPT_RW_DEFERRED,
+            true,
+            true,
+            "rw-deferred",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "max. number of rounds for re-rewriting nodes created at the "
+            "recursive rewriting bound (0: disable)");
+  init_opt (btor,
+            BTOR_OPT_EGRAPH,
+            true,
+            true,
+            "egraph",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "max. number of equality saturation rounds on an e-graph of the "
+            "bit-vector constraints (0: disable)");
+  init_opt (btor,
+            BTOR_OPT_EGRAPH_NODES,
+            true,
+            true,
+            "egraph-nodes",
+            0,
+            20000,
+            1,
+            UINT32_MAX,
+            "max. number of e-graph nodes for equality saturation");
+  init_opt (btor,
+            BTOR_OPT_EGRAPH_TIME,
+            true,
+            true,
+            "egraph-time",
+            0,
+            1000,
+            0,
+            UINT32_MAX,
+            "time limit for equality saturation in milliseconds (0: no limit)");
+  init_opt (btor,
+            BTOR_OPT_COMPONENTS,
+            true,
+            true,
+            "components",
+            0,
+            0,
+            0,
+            64,
+            "simplify and solve variable-disjoint components of the formula "
+            "in separate instances with given number of threads (0: disable)");
+  init_opt (btor,
+            BTOR_OPT_INCREMENTAL_PREPROC,
+            true,
+            true,
+            "incremental-preproc",
+            0,
+            0,
+            0,
+            1,
+            "enable slice elimination on variables not yet encoded into the "
+            "SAT solver and skip redundant skeleton preprocessing in "
+            "incremental mode");
+  init_opt (btor,
+            BTOR_OPT_KNOWN_BITS,
+            true,
+            true,
+            "known-bits",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "max. number of forward/backward sweeps of known bits propagation "
+            "(0: disable)");
+  init_opt (btor,
+            BTOR_OPT_BV_REDUCE,
+            true,
+            true,
+            "bv-reduce",
+            0,
+            0,
+            0,
+            1,
+            "reduce the bit-width of add, mul and ult over zero or sign "
+            "extended operands");
 }
 
 void
@@ -1614,27 +1831,6 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
   else if (opt == BTOR_OPT_MODEL_GEN)
   {
     if (!val && btor_opt_get (btor, opt)) btor_model_delete (btor);
-    if (val && btor_opt_get (btor, BTOR_OPT_UCOPT))
-    {
-      btor_opt_set (btor, BTOR_OPT_UCOPT, 0);
-      BTOR_MSG (btor->msg,
-                1,
-                "Disabling unconstrained optimization since model generation "
-                "is enabled");
-    }
-    assert (!val || !btor_opt_get (btor, BTOR_OPT_UCOPT));
-  }
-  else if (opt == BTOR_OPT_UCOPT)
-  {
-    if (val && btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
-    {
-      BTOR_MSG (btor->msg,
-                1,
-                "Disabling unconstrained optimization since model generation "
-                "is enabled");
-      val = 0;
-    }
-    assert (!val || !btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
   }
   else if (opt == BTOR_OPT_SAT_ENGINE)
   {
@@ -1653,6 +1849,9 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
 #endif
 #ifndef BTOR_USE_CMS
         || val == BTOR_SAT_ENGINE_CMS
+#endif
+#ifndef BTOR_USE_IPASIR
+        || val == BTOR_SAT_ENGINE_IPASIR
 #endif
     )
     {
@@ -69,9 +69,10 @@ enum BtorOptSatEngine
   BTOR_SAT_ENGINE_MINISAT,
   BTOR_SAT_ENGINE_CADICAL,
   BTOR_SAT_ENGINE_CMS,
+  BTOR_SAT_ENGINE_IPASIR,
 };
 #define BTOR_SAT_ENGINE_MIN BTOR_SAT_ENGINE_LINGELING
-#define BTOR_SAT_ENGINE_MAX BTOR_SAT_ENGINE_CMS
+#define BTOR_SAT_ENGINE_MAX BTOR_SAT_ENGINE_IPASIR
 #ifdef BTOR_USE_CADICAL
 #define BTOR_SAT_ENGINE_DFLT BTOR_SAT_ENGINE_CADICAL
 #elif BTOR_USE_LINGELING
@@ -82,6 +83,8 @@ enum BtorOptSatEngine
 #define BTOR_SAT_ENGINE_DFLT BTOR_SAT_ENGINE_MINISAT
 #elif BTOR_USE_CMS
 #define BTOR_SAT_ENGINE_DFLT BTOR_SAT_ENGINE_CMS
+#elif BTOR_USE_IPASIR
+#define BTOR_SAT_ENGINE_DFLT BTOR_SAT_ENGINE_IPASIR
 #endif
 
 typedef enum BtorOptSatEngine BtorOptSatEngine;
@@ -210,6 +210,221 @@ print_param_smt2 (char *symbol,
   fprintf (file, ")");
 }
 
+/*------------------------------------------------------------------------*/
+/* Fun model ranges (--model-ranges)                                      */
+/*------------------------------------------------------------------------*/
+
+/* Compact view of the model of a unary function (e.g., an array) as a
+ * default value and a list of disjoint index ranges sorted by lower bound.
+ * Consecutive indices with the same value are merged into one range,
+ * indices that map to the default value are omitted. */
+struct BtorFunModelRange
+{
+  BtorBitVector *lo;
+  BtorBitVector *hi;
+  BtorBitVector *value;
+};
+typedef struct BtorFunModelRange BtorFunModelRange;
+
+BTOR_DECLARE_STACK (BtorFunModelRange, BtorFunModelRange);
+
+struct BtorFunModelRanges
+{
+  BtorBitVector *default_value;
+  BtorFunModelRangeStack ranges;
+};
+typedef struct BtorFunModelRanges BtorFunModelRanges;
+
+static int32_t
+compare_fun_model_ranges (const void *a, const void *b)
+{
+  return btor_bv_compare (((BtorFunModelRange *) a)->lo,
+                          ((BtorFunModelRange *) b)->lo);
+}
+
+/* Select the value with the most indices as default value. */
+static BtorBitVector *
+get_most_frequent_value (Btor *btor,
+                         BtorFunModelRange *entries,
+                         uint32_t num_entries)
+{
+  uint32_t i;
+  int32_t max;
+  BtorBitVector *res;
+  BtorPtrHashTable *counts;
+  BtorPtrHashBucket *b;
+
+  counts = btor_hashptr_table_new (
+      btor->mm, (BtorHashPtr) btor_bv_hash, (BtorCmpPtr) btor_bv_compare);
+  res = 0;
+  max = 0;
+  for (i = 0; i < num_entries; i++)
+  {
+    if (!(b = btor_hashptr_table_get (counts, entries[i].value)))
+      b = btor_hashptr_table_add (counts, entries[i].value);
+    b->data.as_int += 1;
+    if (b->data.as_int > max)
+    {
+      max = b->data.as_int;
+      res = entries[i].value;
+    }
+  }
+  btor_hashptr_table_delete (counts);
+  assert (res);
+  return btor_bv_copy (btor->mm, res);
+}
+
+static BtorFunModelRanges *
+get_fun_model_ranges (Btor *btor, BtorNode *exp)
+{
+  assert (btor);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+  assert (btor_node_is_fun (exp));
+
+  uint32_t i, n;
+  BtorMemMgr *mm;
+  BtorBitVector *value, *next;
+  BtorBitVectorTuple *args;
+  const BtorPtrHashTable *fun_model;
+  BtorPtrHashTableIterator it;
+  BtorFunModelRange *entries, *last;
+  BtorFunModelRanges *res;
+
+  if (btor_node_fun_get_arity (btor, exp) != 1) return 0;
+  fun_model = btor_model_get_fun (btor, exp);
+  if (!fun_model) return 0;
+
+  mm = btor->mm;
+  BTOR_CNEW (mm, res);
+  BTOR_INIT_STACK (mm, res->ranges);
+  BTOR_NEWN (mm, entries, fun_model->count);
+
+  /* index-value pairs, the 0-arity tuple maps to the default value of
+   * constant arrays (see recursively_compute_function_model) */
+  n = 0;
+  btor_iter_hashptr_init (&it, (BtorPtrHashTable *) fun_model);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    value = it.bucket->data.as_ptr;
+    args  = btor_iter_hashptr_next (&it);
+    if (args->arity == 0)
+    {
+      res->default_value = btor_bv_copy (mm, value);
+      continue;
+    }
+    assert (args->arity == 1);
+    entries[n].lo    = args->bv[0];
+    entries[n].hi    = args->bv[0];
+    entries[n].value = value;
+    n++;
+  }
+  qsort (entries, n, sizeof (BtorFunModelRange), compare_fun_model_ranges);
+
+  if (!res->default_value)
+  {
+    if (n > 0)
+      res->default_value = get_most_frequent_value (btor, entries, n);
+    else
+      res->default_value =
+          btor_bv_new (mm, btor_node_fun_get_width (btor, exp));
+  }
+
+  /* merge consecutive indices with the same value */
+  last = 0;
+  for (i = 0; i < n; i++)
+  {
+    if (!btor_bv_compare (entries[i].value, res->default_value))
+    {
+      last = 0;
+      continue;
+    }
+    if (last && !btor_bv_is_ones (last->hi)
+        && !btor_bv_compare (entries[i].value, last->value))
+    {
+      next = btor_bv_inc (mm, last->hi);
+      if (!btor_bv_compare (next, entries[i].lo))
+      {
+        btor_bv_free (mm, last->hi);
+        last->hi = next;
+        continue;
+      }
+      btor_bv_free (mm, next);
+    }
+    BTOR_PUSH_STACK (res->ranges, entries[i]);
+    last        = res->ranges.top - 1;
+    last->lo    = btor_bv_copy (mm, entries[i].lo);
+    last->hi    = btor_bv_copy (mm, entries[i].hi);
+    last->value = btor_bv_copy (mm, entries[i].value);
+  }
+  BTOR_DELETEN (mm, entries, fun_model->count);
+
+  return res;
+}
+
+static void
+delete_fun_model_ranges (Btor *btor, BtorFunModelRanges *ranges)
+{
+  assert (btor);
+  assert (ranges);
+
+  BtorFunModelRange r;
+
+  while (!BTOR_EMPTY_STACK (ranges->ranges))
+  {
+    r = BTOR_POP_STACK (ranges->ranges);
+    btor_bv_free (btor->mm, r.lo);
+    btor_bv_free (btor->mm, r.hi);
+    btor_bv_free (btor->mm, r.value);
+  }
+  BTOR_RELEASE_STACK (ranges->ranges);
+  btor_bv_free (btor->mm, ranges->default_value);
+  BTOR_DELETE (btor->mm, ranges);
+}
+
+/* Print model of unary function as ite chain over index ranges. */
+static uint32_t
+print_fun_model_ranges_smt2 (Btor *btor,
+                             char *symbol,
+                             BtorFunModelRanges *ranges,
+                             uint32_t base,
+                             FILE *file)
+{
+  assert (btor);
+  assert (symbol);
+  assert (ranges);
+  assert (file);
+
+  uint32_t i;
+  BtorFunModelRange *r;
+
+  for (i = 0; i < BTOR_COUNT_STACK (ranges->ranges); i++)
+  {
+    r = ranges->ranges.start + i;
+    fprintf (file, "%4c(ite ", ' ');
+    if (!btor_bv_compare (r->lo, r->hi))
+    {
+      fprintf (file, "(= %s_x0 ", symbol);
+      btor_dumpsmt_dump_const_value (btor, r->lo, base, file);
+      fprintf (file, ")");
+    }
+    else
+    {
+      fprintf (file, "(and (bvuge %s_x0 ", symbol);
+      btor_dumpsmt_dump_const_value (btor, r->lo, base, file);
+      fprintf (file, ") (bvule %s_x0 ", symbol);
+      btor_dumpsmt_dump_const_value (btor, r->hi, base, file);
+      fprintf (file, "))");
+    }
+    fprintf (file, " ");
+    btor_dumpsmt_dump_const_value (btor, r->value, base, file);
+    fprintf (file, "\n");
+  }
+  fprintf (file, "%6c", ' ');
+  btor_dumpsmt_dump_const_value (btor, ranges->default_value, base, file);
+  return i;
+}
+
 static void
 print_fun_model_smt2 (Btor *btor, BtorNode *node, uint32_t base, FILE *file)
 {
@@ -225,6 +440,7 @@ print_fun_model_smt2 (Btor *btor, BtorNode *node, uint32_t base, FILE *file)
   BtorPtrHashTableIterator it;
   BtorBitVectorTuple *args;
   BtorBitVector *assignment, *default_value;
+  BtorFunModelRanges *ranges;
   BtorSortId sort;
   BtorTupleSortIterator iit;
 
@@ -273,6 +489,12 @@ print_fun_model_smt2 (Btor *btor, BtorNode *node, uint32_t base, FILE *file)
     btor_dumpsmt_dump_const_value (
         btor, btor_model_get_bv (btor, node->e[1]), base, file);
   }
+  else if (btor_opt_get (btor, BTOR_OPT_MODEL_RANGES)
+           && (ranges = get_fun_model_ranges (btor, node)))
+  {
+    nparens = print_fun_model_ranges_smt2 (btor, s, ranges, base, file);
+    delete_fun_model_ranges (btor, ranges);
+  }
   else
   {
     /* fun model as ite over args and assignments */
@@ -87,37 +87,161 @@
     (btor)->rec_rw_calls--;            \
   } while (0)
 
+#ifndef NDEBUG
+#define BTOR_RW_RULE_APPLIED(rw_rule)                                        \
+  do                                                                         \
+  {                                                                          \
+    if (btor->stats.rw_rules_applied)                                        \
+    {                                                                        \
+      BtorPtrHashBucket *b =                                                 \
+          btor_hashptr_table_get (btor->stats.rw_rules_applied, #rw_rule);   \
+      if (!b)                                                                \
+        b = btor_hashptr_table_add (btor->stats.rw_rules_applied, #rw_rule); \
+      b->data.as_int += 1;                                                   \
+    }                                                                        \
+  } while (0)
+#else
+#define BTOR_RW_RULE_APPLIED(rw_rule) \
+  do                                  \
+  {                                   \
+  } while (0)
+#endif
+
+/* Profiling costs a branch on the option value and one on 'rw_prof' if
+ * disabled. Rules are identified by name, a rule added to several rewrite
+ * functions is profiled in one entry. */
+#define BTOR_RW_PROFILE(btor) ((btor)->options[BTOR_OPT_RW_PROFILE].val)
+
 // TODO: special_const_binary rewriting may return 0, hence the check if
 //       (result), may be obsolete if special_const_binary will be split
-#ifndef NDEBUG
-#define ADD_RW_RULE(rw_rule, ...)                                              \
-  if (applies_##rw_rule (btor, __VA_ARGS__))                                   \
-  {                                                                            \
-    assert (!result);                                                          \
-    result = apply_##rw_rule (btor, __VA_ARGS__);                              \
-    if (result)                                                                \
-    {                                                                          \
-      if (btor->stats.rw_rules_applied)                                        \
-      {                                                                        \
-        BtorPtrHashBucket *b =                                                 \
-            btor_hashptr_table_get (btor->stats.rw_rules_applied, #rw_rule);   \
-        if (!b)                                                                \
-          b = btor_hashptr_table_add (btor->stats.rw_rules_applied, #rw_rule); \
-        b->data.as_int += 1;                                                   \
-      }                                                                        \
-      goto DONE;                                                               \
-    }                                                                          \
+#define ADD_RW_RULE(rw_rule, ...)                                           \
+  {                                                                         \
+    BtorRwRuleProfile *rw_prof = 0;                                         \
+    uint64_t rw_cycles         = 0;                                         \
+    uint32_t rw_nodes          = 0;                                         \
+    if (BTOR_RW_PROFILE (btor))                                             \
+    {                                                                       \
+      rw_prof   = get_rw_rule_profile (btor, #rw_rule);                     \
+      rw_cycles = btor_util_cycle_count ();                                 \
+      rw_nodes  = btor->nodes_unique_table.num_elements;                    \
+      rw_prof->attempts += 1;                                               \
+    }                                                                       \
+    if (applies_##rw_rule (btor, __VA_ARGS__))                              \
+    {                                                                       \
+      assert (!result);                                                     \
+      result = apply_##rw_rule (btor, __VA_ARGS__);                         \
+    }                                                                       \
+    if (rw_prof)                                                            \
+    {                                                                       \
+      rw_prof->cycles += btor_util_cycle_count () - rw_cycles;              \
+      rw_prof->nodes += (int64_t) btor->nodes_unique_table.num_elements     \
+                        - (int64_t) rw_nodes;                               \
+      if (result)                                                           \
+        rw_prof->hits += 1;                                                 \
+      else if (btor->rec_rw_calls >= BTOR_REC_RW_BOUND)                     \
+      {                                                                     \
+        /* check if the rule only failed due to the recursion bound */      \
+        uint32_t rw_rec_calls = btor->rec_rw_calls;                         \
+        btor->rec_rw_calls    = 0;                                          \
+        if (applies_##rw_rule (btor, __VA_ARGS__)) rw_prof->bound += 1;     \
+        btor->rec_rw_calls = rw_rec_calls;                                  \
+      }                                                                     \
+    }                                                                       \
+    if (result)                                                             \
+    {                                                                       \
+      BTOR_RW_RULE_APPLIED (rw_rule);                                       \
+      goto DONE;                                                            \
+    }                                                                       \
   }
+//{fprintf (stderr, "apply: %s (%s)\n", #rw_rule, __FUNCTION__);
+
+/* -------------------------------------------------------------------------- */
+/* rewrite rule tables
+ *
+ * The rules of the slice and binary bit-vector rewrite functions are given
+ * as tables (see BTOR_RW_RULES_* below), one entry per rule:
+ *
+ *   RULE (<pattern e0>, [<pattern e1>,] <rw_rule>, <arguments>)
+ *
+ * A pattern is the set of node classes an operand must belong to for
+ * applies_<rw_rule> to hold, where the class of a node is given by the kind
+ * of its real address and its polarity.  The operands are classified once
+ * per rewrite call.  Since patterns are constants, a table expands to a
+ * sequence of bit tests, and only rules that may match are checked.
+ * Patterns must be necessary conditions of applies_<rw_rule> (RWP_ANY if
+ * there is none), which is checked in debug mode.
+ */
+
+/* node classes: bit <kind> if regular, bit 32 + <kind> if inverted */
+#define RWP_REG(k) (((uint64_t) 1) << BTOR_##k##_NODE)
+#define RWP_INV(k) (RWP_REG (k) << 32)
+#define RWP_KIND(k) (RWP_REG (k) | RWP_INV (k))
+#define RWP_ANY (~((uint64_t) 0))
+#define RWP_CONST RWP_KIND (BV_CONST)
+#define RWP_NON_CONST (~RWP_CONST)
+
+static inline uint64_t
+rw_class (BtorNode *exp)
+{
+  assert (BTOR_NUM_OPS_NODE <= 32);
+  if (btor_node_is_inverted (exp))
+    return ((uint64_t) 1) << (32 + btor_node_real_addr (exp)->kind);
+  return ((uint64_t) 1) << exp->kind;
+}
+
+#ifndef NDEBUG
+#define BTOR_RW_RULE_NO_MATCH(rw_rule, ...) \
+  assert (!applies_##rw_rule (btor, __VA_ARGS__))
 #else
-#define ADD_RW_RULE(rw_rule, ...)                 \
-  if (applies_##rw_rule (btor, __VA_ARGS__))      \
-  {                                               \
-    assert (!result);                             \
-    result = apply_##rw_rule (btor, __VA_ARGS__); \
-    if (result) goto DONE;                        \
-  }
+#define BTOR_RW_RULE_NO_MATCH(rw_rule, ...) \
+  do                                        \
+  {                                         \
+  } while (0)
 #endif
-//{fprintf (stderr, "apply: %s (%s)\n", #rw_rule, __FUNCTION__);
+
+/* match rule against class 'rw_class0' of the operand of a unary rule */
+#define MATCH_RW_RULE1(p0, rw_rule, ...)           \
+  if (rw_class0 & (p0))                            \
+  {                                                \
+    ADD_RW_RULE (rw_rule, __VA_ARGS__)             \
+  }                                                \
+  else                                             \
+  {                                                \
+    BTOR_RW_RULE_NO_MATCH (rw_rule, __VA_ARGS__);  \
+  }
+
+/* match rule against classes 'rw_class0' and 'rw_class1' of the operands of
+ * a binary rule */
+#define MATCH_RW_RULE2(p0, p1, rw_rule, ...)         \
+  if ((rw_class0 & (p0)) && (rw_class1 & (p1)))      \
+  {                                                  \
+    ADD_RW_RULE (rw_rule, __VA_ARGS__)               \
+  }                                                  \
+  else                                               \
+  {                                                  \
+    BTOR_RW_RULE_NO_MATCH (rw_rule, __VA_ARGS__);    \
+  }
+
+/* -------------------------------------------------------------------------- */
+/* rewrite rule profile */
+
+static BtorRwRuleProfile *
+get_rw_rule_profile (Btor *btor, const char *rule)
+{
+  assert (btor);
+  assert (rule);
+
+  BtorPtrHashBucket *b;
+  BtorRwRuleProfile *res;
+
+  b = btor_hashptr_table_get (btor->stats.rw_rules_profile, rule);
+  if (b) return b->data.as_ptr;
+  BTOR_CNEW (btor->mm, res);
+  res->name = rule;
+  b = btor_hashptr_table_add (btor->stats.rw_rules_profile, (void *) rule);
+  b->data.as_ptr = res;
+  return res;
+}
 
 /* -------------------------------------------------------------------------- */
 /* rewrite cache */
@@ -1337,7 +1461,8 @@ btor_rewrite_linear_term (Btor *btor,
  * where the first one determines if <rw_rule> is applicable, and the second
  * one applies the rule.
  *
- * for adding rw rules to a rewrite function use the ADD_RW_RULE macro.
+ * for adding rw rules to a rewrite function add them to its rule table
+ * (BTOR_RW_RULES_*) or, if it has none, use the ADD_RW_RULE macro.
  */
 
 
@@ -6438,14 +6563,305 @@ normalize_cond (Btor *btor, BtorNode **cond, BtorNode **left, BtorNode **right)
   *right = e2;
 }
 
+/* -------------------------------------------------------------------------- */
+/* rewrite rule tables                                                        */
+/* -------------------------------------------------------------------------- */
+
+/* rules of rewrite_slice_exp */
+#define BTOR_RW_RULES_SLICE(RULE)                                      \
+  RULE (RWP_ANY, full_slice, e, upper, lower)                          \
+  RULE (RWP_CONST, const_slice, e, upper, lower)                       \
+  RULE (RWP_KIND (BV_SLICE), slice_slice, e, upper, lower)             \
+  RULE (RWP_KIND (BV_CONCAT), concat_lower_slice, e, upper, lower)     \
+  RULE (RWP_KIND (BV_CONCAT), concat_upper_slice, e, upper, lower)     \
+  RULE (RWP_KIND (BV_CONCAT), concat_rec_upper_slice, e, upper, lower) \
+  RULE (RWP_KIND (BV_CONCAT), concat_rec_lower_slice, e, upper, lower) \
+  RULE (RWP_KIND (BV_CONCAT), concat_rec_slice, e, upper, lower)       \
+  RULE (RWP_KIND (BV_AND), and_slice, e, upper, lower)                 \
+  RULE (RWP_KIND (COND), bcond_slice, e, upper, lower)                 \
+  RULE (RWP_KIND (BV_MUL) | RWP_KIND (BV_ADD),                         \
+        zero_lower_slice,                                              \
+        e,                                                             \
+        upper,                                                         \
+        lower)
+
+/* rules of rewrite_eq_exp (first operand order only)
+ *
+ * We do not rewrite eq in the boolean case, as we cannot extract the
+ * resulting XNOR on top level again and would therefore lose substitutions.
+ *
+ * Additionally, we do not rewrite eq in the boolean case, as we rewrite
+ * a != b to a = ~b and substitute.
+ */
+#define BTOR_RW_RULES_EQ_ONCE(RULE)                           \
+  RULE (RWP_CONST, RWP_CONST, const_binary_exp, kind, e0, e1) \
+  RULE (RWP_ANY, RWP_ANY, true_eq, e0, e1)                    \
+  RULE (RWP_ANY, RWP_ANY, false_eq, e0, e1)                   \
+  RULE (RWP_KIND (COND), RWP_KIND (COND), bcond_eq, e0, e1)   \
+  RULE (RWP_CONST,                                            \
+        RWP_NON_CONST,                                        \
+        special_const_lhs_binary_exp,                         \
+        kind,                                                 \
+        e0,                                                   \
+        e1)                                                   \
+  RULE (RWP_NON_CONST,                                        \
+        RWP_CONST,                                            \
+        special_const_rhs_binary_exp,                         \
+        kind,                                                 \
+        e0,                                                   \
+        e1)
+
+/* rules of rewrite_eq_exp */
+#define BTOR_RW_RULES_EQ(RULE)                                          \
+  RULE (RWP_REG (BV_ADD), RWP_ANY, add_left_eq, e0, e1)                 \
+  RULE (RWP_REG (BV_ADD), RWP_ANY, add_right_eq, e0, e1)                \
+  RULE (RWP_REG (BV_ADD), RWP_REG (BV_ADD), add_add_1_eq, e0, e1)       \
+  RULE (RWP_REG (BV_ADD), RWP_REG (BV_ADD), add_add_2_eq, e0, e1)       \
+  RULE (RWP_REG (BV_ADD), RWP_REG (BV_ADD), add_add_3_eq, e0, e1)       \
+  RULE (RWP_REG (BV_ADD), RWP_REG (BV_ADD), add_add_4_eq, e0, e1)       \
+  RULE (RWP_ANY, RWP_REG (BV_ADD), sub_eq, e0, e1)                      \
+  RULE (RWP_REG (COND), RWP_ANY, bcond_uneq_if_eq, e0, e1)              \
+  RULE (RWP_REG (COND), RWP_ANY, bcond_uneq_else_eq, e0, e1)            \
+  RULE (RWP_ANY, RWP_KIND (COND), bcond_if_eq, e0, e1)                  \
+  RULE (RWP_ANY, RWP_KIND (COND), bcond_else_eq, e0, e1)                \
+  RULE (RWP_REG (BV_MUL), RWP_REG (BV_ADD), distrib_add_mul_eq, e0, e1) \
+  RULE (RWP_KIND (BV_CONCAT), RWP_ANY, concat_eq, e0, e1)
+
+/* rules of rewrite_ult_exp */
+#define BTOR_RW_RULES_ULT(RULE)                                             \
+  RULE (RWP_CONST, RWP_CONST, const_binary_exp, BTOR_BV_ULT_NODE, e0, e1)   \
+  RULE (RWP_CONST,                                                          \
+        RWP_NON_CONST,                                                      \
+        special_const_lhs_binary_exp,                                       \
+        BTOR_BV_ULT_NODE,                                                   \
+        e0,                                                                 \
+        e1)                                                                 \
+  RULE (RWP_NON_CONST,                                                      \
+        RWP_CONST,                                                          \
+        special_const_rhs_binary_exp,                                       \
+        BTOR_BV_ULT_NODE,                                                   \
+        e0,                                                                 \
+        e1)                                                                 \
+  RULE (RWP_ANY, RWP_ANY, false_ult, e0, e1)                                \
+  RULE (RWP_ANY, RWP_ANY, bool_ult, e0, e1)                                 \
+  RULE (RWP_REG (BV_CONCAT), RWP_REG (BV_CONCAT), concat_upper_ult, e0, e1) \
+  RULE (RWP_REG (BV_CONCAT), RWP_REG (BV_CONCAT), concat_lower_ult, e0, e1) \
+  RULE (RWP_KIND (COND), RWP_KIND (COND), bcond_ult, e0, e1)
+
+/* rules of rewrite_and_exp (first operand order only) */
+#define BTOR_RW_RULES_AND_ONCE(RULE)                                      \
+  RULE (RWP_CONST, RWP_CONST, const_binary_exp, BTOR_BV_AND_NODE, e0, e1) \
+  RULE (RWP_CONST,                                                        \
+        RWP_NON_CONST,                                                    \
+        special_const_lhs_binary_exp,                                     \
+        BTOR_BV_AND_NODE,                                                 \
+        e0,                                                               \
+        e1)                                                               \
+  RULE (RWP_NON_CONST,                                                    \
+        RWP_CONST,                                                        \
+        special_const_rhs_binary_exp,                                     \
+        BTOR_BV_AND_NODE,                                                 \
+        e0,                                                               \
+        e1)                                                               \
+  RULE (RWP_ANY, RWP_ANY, idem1_and, e0, e1)                              \
+  RULE (RWP_ANY, RWP_ANY, contr1_and, e0, e1)                             \
+  RULE (RWP_REG (BV_AND), RWP_REG (BV_AND), contr2_and, e0, e1)           \
+  RULE (RWP_REG (BV_AND), RWP_REG (BV_AND), idem2_and, e0, e1)            \
+  RULE (RWP_REG (BV_AND), RWP_REG (BV_AND), comm_and, e0, e1)             \
+  RULE (RWP_INV (BV_AND), RWP_INV (BV_AND), bool_xnor_and, e0, e1)        \
+  RULE (RWP_INV (BV_AND), RWP_INV (BV_AND), resol1_and, e0, e1)           \
+  RULE (RWP_INV (BV_AND), RWP_INV (BV_AND), resol2_and, e0, e1)           \
+  RULE (RWP_REG (BV_ULT), RWP_REG (BV_ULT), ult_false_and, e0, e1)        \
+  RULE (RWP_INV (BV_ULT), RWP_INV (BV_ULT), ult_and, e0, e1)              \
+  RULE (RWP_ANY, RWP_ANY, contr_rec_and, e0, e1)
+
+/* rules of rewrite_and_exp */
+#define BTOR_RW_RULES_AND(RULE)                                         \
+  RULE (RWP_REG (BV_AND), RWP_INV (BV_AND), subsum1_and, e0, e1)        \
+  RULE (RWP_REG (BV_AND), RWP_INV (BV_AND), subst1_and, e0, e1)         \
+  RULE (RWP_REG (BV_AND), RWP_INV (BV_AND), subst2_and, e0, e1)         \
+  RULE (RWP_INV (BV_AND), RWP_ANY, subsum2_and, e0, e1)                 \
+  RULE (RWP_INV (BV_AND), RWP_ANY, subst3_and, e0, e1)                  \
+  RULE (RWP_INV (BV_AND), RWP_ANY, subst4_and, e0, e1)                  \
+  RULE (RWP_REG (BV_AND), RWP_ANY, contr3_and, e0, e1)                  \
+  RULE (RWP_REG (BV_AND), RWP_ANY, idem3_and, e0, e1)                   \
+  RULE (RWP_REG (BV_AND), RWP_CONST, const1_and, e0, e1)                \
+  RULE (RWP_REG (BV_AND), RWP_CONST, const2_and, e0, e1)                \
+  RULE (RWP_KIND (BV_CONCAT), RWP_KIND (BV_CONCAT), concat_and, e0, e1)
+
+/* rules of rewrite_add_exp (first operand order only) */
+#define BTOR_RW_RULES_ADD_ONCE(RULE)                                      \
+  RULE (RWP_CONST, RWP_CONST, const_binary_exp, BTOR_BV_ADD_NODE, e0, e1) \
+  RULE (RWP_CONST,                                                        \
+        RWP_NON_CONST,                                                    \
+        special_const_lhs_binary_exp,                                     \
+        BTOR_BV_ADD_NODE,                                                 \
+        e0,                                                               \
+        e1)                                                               \
+  RULE (RWP_NON_CONST,                                                    \
+        RWP_CONST,                                                        \
+        special_const_rhs_binary_exp,                                     \
+        BTOR_BV_ADD_NODE,                                                 \
+        e0,                                                               \
+        e1)                                                               \
+  RULE (RWP_ANY, RWP_ANY, bool_add, e0, e1)                               \
+  RULE (RWP_ANY, RWP_ANY, mult_add, e0, e1)                               \
+  RULE (RWP_ANY, RWP_ANY, not_add, e0, e1)                                \
+  RULE (RWP_KIND (COND), RWP_KIND (COND), bcond_add, e0, e1)              \
+  RULE (RWP_ANY, RWP_ANY, urem_add, e0, e1)
+
+/* rules of rewrite_add_exp */
+#define BTOR_RW_RULES_ADD(RULE)                               \
+  RULE (RWP_ANY, RWP_REG (BV_ADD), neg_add, e0, e1)           \
+  RULE (RWP_CONST, RWP_ANY, zero_add, e0, e1)                 \
+  RULE (RWP_CONST, RWP_REG (BV_ADD), const_lhs_add, e0, e1)   \
+  RULE (RWP_CONST, RWP_REG (BV_ADD), const_rhs_add, e0, e1)   \
+  RULE (RWP_INV (BV_MUL), RWP_ANY, const_neg_lhs_add, e0, e1) \
+  RULE (RWP_INV (BV_MUL), RWP_ANY, const_neg_rhs_add, e0, e1) \
+  RULE (RWP_REG (COND), RWP_ANY, push_ite_add, e0, e1)
+
+/* rules of rewrite_mul_exp (first operand order only) */
+#define BTOR_RW_RULES_MUL_ONCE(RULE)                                      \
+  RULE (RWP_CONST, RWP_CONST, const_binary_exp, BTOR_BV_MUL_NODE, e0, e1) \
+  RULE (RWP_CONST,                                                        \
+        RWP_NON_CONST,                                                    \
+        special_const_lhs_binary_exp,                                     \
+        BTOR_BV_MUL_NODE,                                                 \
+        e0,                                                               \
+        e1)                                                               \
+  RULE (RWP_NON_CONST,                                                    \
+        RWP_CONST,                                                        \
+        special_const_rhs_binary_exp,                                     \
+        BTOR_BV_MUL_NODE,                                                 \
+        e0,                                                               \
+        e1)                                                               \
+  RULE (RWP_ANY, RWP_ANY, bool_mul, e0, e1)
+
+/* rules of rewrite_mul_exp */
+#define BTOR_RW_RULES_MUL(RULE)                             \
+  RULE (RWP_CONST, RWP_REG (BV_MUL), const_lhs_mul, e0, e1) \
+  RULE (RWP_CONST, RWP_REG (BV_MUL), const_rhs_mul, e0, e1) \
+  RULE (RWP_CONST, RWP_REG (BV_ADD), const_mul, e0, e1)     \
+  RULE (RWP_REG (COND), RWP_ANY, push_ite_mul, e0, e1)      \
+  RULE (RWP_REG (BV_SLL), RWP_ANY, sll_mul, e0, e1)         \
+  RULE (RWP_ANY, RWP_ANY, neg_mul, e0, e1)
+
+/* rules of rewrite_udiv_exp */
+#define BTOR_RW_RULES_UDIV(RULE)                                           \
+  RULE (RWP_CONST, RWP_CONST, const_binary_exp, BTOR_BV_UDIV_NODE, e0, e1) \
+  RULE (RWP_CONST,                                                         \
+        RWP_NON_CONST,                                                     \
+        special_const_lhs_binary_exp,                                      \
+        BTOR_BV_UDIV_NODE,                                                 \
+        e0,                                                                \
+        e1)                                                                \
+  RULE (RWP_NON_CONST,                                                     \
+        RWP_CONST,                                                         \
+        special_const_rhs_binary_exp,                                      \
+        BTOR_BV_UDIV_NODE,                                                 \
+        e0,                                                                \
+        e1)                                                                \
+  RULE (RWP_ANY, RWP_ANY, bool_udiv, e0, e1)                               \
+  RULE (RWP_ANY, RWP_REG (BV_CONST), power2_udiv, e0, e1)                  \
+  RULE (RWP_ANY, RWP_ANY, one_udiv, e0, e1)                                \
+  RULE (RWP_KIND (COND), RWP_KIND (COND), bcond_udiv, e0, e1)
+
+/* rules of rewrite_urem_exp */
+#define BTOR_RW_RULES_UREM(RULE)                                           \
+  RULE (RWP_CONST, RWP_CONST, const_binary_exp, BTOR_BV_UREM_NODE, e0, e1) \
+  RULE (RWP_CONST,                                                         \
+        RWP_NON_CONST,                                                     \
+        special_const_lhs_binary_exp,                                      \
+        BTOR_BV_UREM_NODE,                                                 \
+        e0,                                                                \
+        e1)                                                                \
+  RULE (RWP_NON_CONST,                                                     \
+        RWP_CONST,                                                         \
+        special_const_rhs_binary_exp,                                      \
+        BTOR_BV_UREM_NODE,                                                 \
+        e0,                                                                \
+        e1)                                                                \
+  RULE (RWP_ANY, RWP_ANY, bool_urem, e0, e1)                               \
+  RULE (RWP_ANY, RWP_ANY, zero_urem, e0, e1)
+
+/* rules of rewrite_concat_exp */
+#define BTOR_RW_RULES_CONCAT(RULE)                                           \
+  RULE (RWP_CONST, RWP_CONST, const_binary_exp, BTOR_BV_CONCAT_NODE, e0, e1) \
+  RULE (RWP_CONST,                                                           \
+        RWP_NON_CONST,                                                       \
+        special_const_lhs_binary_exp,                                        \
+        BTOR_BV_CONCAT_NODE,                                                 \
+        e0,                                                                  \
+        e1)                                                                  \
+  RULE (RWP_NON_CONST,                                                       \
+        RWP_CONST,                                                           \
+        special_const_rhs_binary_exp,                                        \
+        BTOR_BV_CONCAT_NODE,                                                 \
+        e0,                                                                  \
+        e1)                                                                  \
+  RULE (RWP_KIND (BV_CONCAT), RWP_CONST, const_concat, e0, e1)               \
+  RULE (RWP_KIND (BV_SLICE), RWP_KIND (BV_SLICE), slice_concat, e0, e1)      \
+  RULE (RWP_KIND (BV_AND), RWP_ANY, and_lhs_concat, e0, e1)                  \
+  RULE (RWP_ANY, RWP_KIND (BV_AND), and_rhs_concat, e0, e1)
+
+/* rules of rewrite_sll_exp */
+#define BTOR_RW_RULES_SLL(RULE)                                           \
+  RULE (RWP_CONST, RWP_CONST, const_binary_exp, BTOR_BV_SLL_NODE, e0, e1) \
+  RULE (RWP_CONST,                                                        \
+        RWP_NON_CONST,                                                    \
+        special_const_lhs_binary_exp,                                     \
+        BTOR_BV_SLL_NODE,                                                 \
+        e0,                                                               \
+        e1)                                                               \
+  RULE (RWP_NON_CONST,                                                    \
+        RWP_CONST,                                                        \
+        special_const_rhs_binary_exp,                                     \
+        BTOR_BV_SLL_NODE,                                                 \
+        e0,                                                               \
+        e1)                                                               \
+  RULE (RWP_ANY, RWP_CONST, const_sll, e0, e1)
+
+/* rules of rewrite_srl_exp */
+#define BTOR_RW_RULES_SRL(RULE)                                           \
+  RULE (RWP_CONST, RWP_CONST, const_binary_exp, BTOR_BV_SRL_NODE, e0, e1) \
+  RULE (RWP_CONST,                                                        \
+        RWP_NON_CONST,                                                    \
+        special_const_lhs_binary_exp,                                     \
+        BTOR_BV_SRL_NODE,                                                 \
+        e0,                                                               \
+        e1)                                                               \
+  RULE (RWP_NON_CONST,                                                    \
+        RWP_CONST,                                                        \
+        special_const_rhs_binary_exp,                                     \
+        BTOR_BV_SRL_NODE,                                                 \
+        e0,                                                               \
+        e1)                                                               \
+  RULE (RWP_ANY, RWP_CONST, const_srl, e0, e1)
+
 /* -------------------------------------------------------------------------- */
 /* term rewriting functions                                                   */
 /* -------------------------------------------------------------------------- */
 
+/* Remember nodes that were created without rewriting because the recursion
+ * bound was hit. They are rewritten again by btor_rewrite_deferred. */
+static inline void
+rw_defer (Btor *btor, BtorNode *exp)
+{
+  int32_t id;
+
+  if (btor->rec_rw_calls < BTOR_REC_RW_BOUND) return;
+  if (!btor_opt_get (btor, BTOR_OPT_RW_DEFERRED)) return;
+
+  id = btor_node_get_id (btor_node_real_addr (exp));
+  if (!btor_hashint_table_contains (btor->rw_deferred, id))
+    btor_hashint_table_add (btor->rw_deferred, id);
+}
+
 static BtorNode *
 rewrite_slice_exp (Btor *btor, BtorNode *e, uint32_t upper, uint32_t lower)
 {
   BtorNode *result = 0;
+  uint64_t rw_class0;
 
   e = btor_simplify_exp (btor, e);
   assert (btor_dbg_precond_slice_exp (btor, e, upper, lower));
@@ -6455,22 +6871,14 @@ rewrite_slice_exp (Btor *btor, BtorNode *e, uint32_t upper, uint32_t lower)
 
   if (!result)
   {
-    ADD_RW_RULE (full_slice, e, upper, lower);
-    ADD_RW_RULE (const_slice, e, upper, lower);
-    ADD_RW_RULE (slice_slice, e, upper, lower);
-    ADD_RW_RULE (concat_lower_slice, e, upper, lower);
-    ADD_RW_RULE (concat_upper_slice, e, upper, lower);
-    ADD_RW_RULE (concat_rec_upper_slice, e, upper, lower);
-    ADD_RW_RULE (concat_rec_lower_slice, e, upper, lower);
-    ADD_RW_RULE (concat_rec_slice, e, upper, lower);
-    ADD_RW_RULE (and_slice, e, upper, lower);
-    ADD_RW_RULE (bcond_slice, e, upper, lower);
-    ADD_RW_RULE (zero_lower_slice, e, upper, lower);
+    rw_class0 = rw_class (e);
+    BTOR_RW_RULES_SLICE (MATCH_RW_RULE1)
 
     assert (!result);
     if (!result)
     {
       result = btor_node_create_bv_slice (btor, e, upper, lower);
+      rw_defer (btor, result);
     }
     else
     {
@@ -6494,6 +6902,7 @@ rewrite_eq_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  uint64_t rw_class0, rw_class1;
   BtorNodeKind kind;
 
   e0 = btor_simplify_exp (btor, e0);
@@ -6511,35 +6920,13 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_class0 = rw_class (e0);
+    rw_class1 = rw_class (e1);
     if (!swap_ops)
     {
-      ADD_RW_RULE (const_binary_exp, kind, e0, e1);
-      /* We do not rewrite eq in the boolean case, as we cannot extract the
-       * resulting XNOR on top level again and would therefore lose
-       * substitutions.
-       *
-       * Additionally, we do not rewrite eq in the boolean case, as we rewrite
-       * a != b to a = ~b and substitute.
-       */
-      ADD_RW_RULE (true_eq, e0, e1);
-      ADD_RW_RULE (false_eq, e0, e1);
-      ADD_RW_RULE (bcond_eq, e0, e1);
-      ADD_RW_RULE (special_const_lhs_binary_exp, kind, e0, e1);
-      ADD_RW_RULE (special_const_rhs_binary_exp, kind, e0, e1);
+      BTOR_RW_RULES_EQ_ONCE (MATCH_RW_RULE2)
     }
-    ADD_RW_RULE (add_left_eq, e0, e1);
-    ADD_RW_RULE (add_right_eq, e0, e1);
-    ADD_RW_RULE (add_add_1_eq, e0, e1);
-    ADD_RW_RULE (add_add_2_eq, e0, e1);
-    ADD_RW_RULE (add_add_3_eq, e0, e1);
-    ADD_RW_RULE (add_add_4_eq, e0, e1);
-    ADD_RW_RULE (sub_eq, e0, e1);
-    ADD_RW_RULE (bcond_uneq_if_eq, e0, e1);
-    ADD_RW_RULE (bcond_uneq_else_eq, e0, e1);
-    ADD_RW_RULE (bcond_if_eq, e0, e1);
-    ADD_RW_RULE (bcond_else_eq, e0, e1);
-    ADD_RW_RULE (distrib_add_mul_eq, e0, e1);
-    ADD_RW_RULE (concat_eq, e0, e1);
+    BTOR_RW_RULES_EQ (MATCH_RW_RULE2)
 #if 0
     ADD_RW_RULE (zero_eq_and_eq, e0, e1);
 #endif
@@ -6556,6 +6943,7 @@ SWAP_OPERANDS:
     if (!result)
     {
       result = btor_node_create_eq (btor, e1, e0);
+      rw_defer (btor, result);
     }
     else
     {
@@ -6579,6 +6967,7 @@ static BtorNode *
 rewrite_ult_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  uint64_t rw_class0, rw_class1;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6593,19 +6982,15 @@ rewrite_ult_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
-    ADD_RW_RULE (const_binary_exp, BTOR_BV_ULT_NODE, e0, e1);
-    ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_ULT_NODE, e0, e1);
-    ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_ULT_NODE, e0, e1);
-    ADD_RW_RULE (false_ult, e0, e1);
-    ADD_RW_RULE (bool_ult, e0, e1);
-    ADD_RW_RULE (concat_upper_ult, e0, e1);
-    ADD_RW_RULE (concat_lower_ult, e0, e1);
-    ADD_RW_RULE (bcond_ult, e0, e1);
+    rw_class0 = rw_class (e0);
+    rw_class1 = rw_class (e1);
+    BTOR_RW_RULES_ULT (MATCH_RW_RULE2)
 
     assert (!result);
     if (!result)
     {
       result = btor_node_create_bv_ult (btor, e0, e1);
+      rw_defer (btor, result);
     }
     else
     {
@@ -6630,6 +7015,7 @@ rewrite_and_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  uint64_t rw_class0, rw_class1;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6645,34 +7031,13 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_class0 = rw_class (e0);
+    rw_class1 = rw_class (e1);
     if (!swap_ops)
     {
-      ADD_RW_RULE (const_binary_exp, BTOR_BV_AND_NODE, e0, e1);
-      ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_AND_NODE, e0, e1);
-      ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_AND_NODE, e0, e1);
-      ADD_RW_RULE (idem1_and, e0, e1);
-      ADD_RW_RULE (contr1_and, e0, e1);
-      ADD_RW_RULE (contr2_and, e0, e1);
-      ADD_RW_RULE (idem2_and, e0, e1);
-      ADD_RW_RULE (comm_and, e0, e1);
-      ADD_RW_RULE (bool_xnor_and, e0, e1);
-      ADD_RW_RULE (resol1_and, e0, e1);
-      ADD_RW_RULE (resol2_and, e0, e1);
-      ADD_RW_RULE (ult_false_and, e0, e1);
-      ADD_RW_RULE (ult_and, e0, e1);
-      ADD_RW_RULE (contr_rec_and, e0, e1);
+      BTOR_RW_RULES_AND_ONCE (MATCH_RW_RULE2)
     }
-    ADD_RW_RULE (subsum1_and, e0, e1);
-    ADD_RW_RULE (subst1_and, e0, e1);
-    ADD_RW_RULE (subst2_and, e0, e1);
-    ADD_RW_RULE (subsum2_and, e0, e1);
-    ADD_RW_RULE (subst3_and, e0, e1);
-    ADD_RW_RULE (subst4_and, e0, e1);
-    ADD_RW_RULE (contr3_and, e0, e1);
-    ADD_RW_RULE (idem3_and, e0, e1);
-    ADD_RW_RULE (const1_and, e0, e1);
-    ADD_RW_RULE (const2_and, e0, e1);
-    ADD_RW_RULE (concat_and, e0, e1);
+    BTOR_RW_RULES_AND (MATCH_RW_RULE2)
     // ADD_RW_RULE (push_ite_and, e0, e1);
 
     assert (!result);
@@ -6688,6 +7053,7 @@ SWAP_OPERANDS:
     if (!result)
     {
       result = btor_node_create_bv_and (btor, e1, e0);
+      rw_defer (btor, result);
     }
     else
     {
@@ -6712,6 +7078,7 @@ rewrite_add_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  uint64_t rw_class0, rw_class1;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6727,24 +7094,13 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_class0 = rw_class (e0);
+    rw_class1 = rw_class (e1);
     if (!swap_ops)
     {
-      ADD_RW_RULE (const_binary_exp, BTOR_BV_ADD_NODE, e0, e1);
-      ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_ADD_NODE, e0, e1);
-      ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_ADD_NODE, e0, e1);
-      ADD_RW_RULE (bool_add, e0, e1);
-      ADD_RW_RULE (mult_add, e0, e1);
-      ADD_RW_RULE (not_add, e0, e1);
-      ADD_RW_RULE (bcond_add, e0, e1);
-      ADD_RW_RULE (urem_add, e0, e1);
+      BTOR_RW_RULES_ADD_ONCE (MATCH_RW_RULE2)
     }
-    ADD_RW_RULE (neg_add, e0, e1);
-    ADD_RW_RULE (zero_add, e0, e1);
-    ADD_RW_RULE (const_lhs_add, e0, e1);
-    ADD_RW_RULE (const_rhs_add, e0, e1);
-    ADD_RW_RULE (const_neg_lhs_add, e0, e1);
-    ADD_RW_RULE (const_neg_rhs_add, e0, e1);
-    ADD_RW_RULE (push_ite_add, e0, e1);
+    BTOR_RW_RULES_ADD (MATCH_RW_RULE2)
     // TODO: enable when same bw shift is merged
     //ADD_RW_RULE (sll_add, e0, e1);
 
@@ -6761,6 +7117,7 @@ SWAP_OPERANDS:
     if (!result)
     {
       result = btor_node_create_bv_add (btor, e1, e0);
+      rw_defer (btor, result);
     }
     else
     {
@@ -6785,6 +7142,7 @@ rewrite_mul_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  uint64_t rw_class0, rw_class1;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6800,23 +7158,17 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_class0 = rw_class (e0);
+    rw_class1 = rw_class (e1);
     if (!swap_ops)
     {
-      ADD_RW_RULE (const_binary_exp, BTOR_BV_MUL_NODE, e0, e1);
-      ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_MUL_NODE, e0, e1);
-      ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_MUL_NODE, e0, e1);
-      ADD_RW_RULE (bool_mul, e0, e1);
+      BTOR_RW_RULES_MUL_ONCE (MATCH_RW_RULE2)
 #if 0
       // TODO (ma): this increases mul nodes in the general case, needs restriction
       ADD_RW_RULE (bcond_mul, e0, e1);
 #endif
     }
-    ADD_RW_RULE (const_lhs_mul, e0, e1);
-    ADD_RW_RULE (const_rhs_mul, e0, e1);
-    ADD_RW_RULE (const_mul, e0, e1);
-    ADD_RW_RULE (push_ite_mul, e0, e1);
-    ADD_RW_RULE (sll_mul, e0, e1);
-    ADD_RW_RULE (neg_mul, e0, e1);
+    BTOR_RW_RULES_MUL (MATCH_RW_RULE2)
 
     assert (!result);
 
@@ -6831,6 +7183,7 @@ SWAP_OPERANDS:
     if (!result)
     {
       result = btor_node_create_bv_mul (btor, e1, e0);
+      rw_defer (btor, result);
     }
     else
     {
@@ -6854,6 +7207,7 @@ static BtorNode *
 rewrite_udiv_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  uint64_t rw_class0, rw_class1;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6871,18 +7225,15 @@ rewrite_udiv_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
     // TODO what about non powers of 2, like divisor 3, which means that
     // some upper bits are 0 ...
 
-    ADD_RW_RULE (const_binary_exp, BTOR_BV_UDIV_NODE, e0, e1);
-    ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_UDIV_NODE, e0, e1);
-    ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_UDIV_NODE, e0, e1);
-    ADD_RW_RULE (bool_udiv, e0, e1);
-    ADD_RW_RULE (power2_udiv, e0, e1);
-    ADD_RW_RULE (one_udiv, e0, e1);
-    ADD_RW_RULE (bcond_udiv, e0, e1);
+    rw_class0 = rw_class (e0);
+    rw_class1 = rw_class (e1);
+    BTOR_RW_RULES_UDIV (MATCH_RW_RULE2)
 
     assert (!result);
     if (!result)
     {
       result = btor_node_create_bv_udiv (btor, e0, e1);
+      rw_defer (btor, result);
     }
     else
     {
@@ -6906,6 +7257,7 @@ static BtorNode *
 rewrite_urem_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  uint64_t rw_class0, rw_class1;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6925,16 +7277,15 @@ rewrite_urem_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
     // TODO what about non powers of 2, like modulo 3, which means that
     // all but the last two bits are zero
 
-    ADD_RW_RULE (const_binary_exp, BTOR_BV_UREM_NODE, e0, e1);
-    ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_UREM_NODE, e0, e1);
-    ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_UREM_NODE, e0, e1);
-    ADD_RW_RULE (bool_urem, e0, e1);
-    ADD_RW_RULE (zero_urem, e0, e1);
+    rw_class0 = rw_class (e0);
+    rw_class1 = rw_class (e1);
+    BTOR_RW_RULES_UREM (MATCH_RW_RULE2)
 
     assert (!result);
     if (!result)
     {
       result = btor_node_create_bv_urem (btor, e0, e1);
+      rw_defer (btor, result);
     }
     else
     {
@@ -6958,6 +7309,7 @@ static BtorNode *
 rewrite_concat_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  uint64_t rw_class0, rw_class1;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6972,18 +7324,15 @@ rewrite_concat_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
-    ADD_RW_RULE (const_binary_exp, BTOR_BV_CONCAT_NODE, e0, e1);
-    ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_CONCAT_NODE, e0, e1);
-    ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_CONCAT_NODE, e0, e1);
-    ADD_RW_RULE (const_concat, e0, e1);
-    ADD_RW_RULE (slice_concat, e0, e1);
-    ADD_RW_RULE (and_lhs_concat, e0, e1);
-    ADD_RW_RULE (and_rhs_concat, e0, e1);
+    rw_class0 = rw_class (e0);
+    rw_class1 = rw_class (e1);
+    BTOR_RW_RULES_CONCAT (MATCH_RW_RULE2)
 
     assert (!result);
     if (!result)
     {
       result = btor_node_create_bv_concat (btor, e0, e1);
+      rw_defer (btor, result);
     }
     else
     {
@@ -7007,6 +7356,7 @@ static BtorNode *
 rewrite_sll_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  uint64_t rw_class0, rw_class1;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7017,15 +7367,15 @@ rewrite_sll_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
-    ADD_RW_RULE (const_binary_exp, BTOR_BV_SLL_NODE, e0, e1);
-    ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_SLL_NODE, e0, e1);
-    ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_SLL_NODE, e0, e1);
-    ADD_RW_RULE (const_sll, e0, e1);
+    rw_class0 = rw_class (e0);
+    rw_class1 = rw_class (e1);
+    BTOR_RW_RULES_SLL (MATCH_RW_RULE2)
 
     assert (!result);
     if (!result)
     {
       result = btor_node_create_bv_sll (btor, e0, e1);
+      rw_defer (btor, result);
     }
     else
     {
@@ -7047,6 +7397,7 @@ static BtorNode *
 rewrite_srl_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  uint64_t rw_class0, rw_class1;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7057,16 +7408,16 @@ rewrite_srl_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
-    ADD_RW_RULE (const_binary_exp, BTOR_BV_SRL_NODE, e0, e1);
-    ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_SRL_NODE, e0, e1);
-    ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_SRL_NODE, e0, e1);
-    ADD_RW_RULE (const_srl, e0, e1);
+    rw_class0 = rw_class (e0);
+    rw_class1 = rw_class (e1);
+    BTOR_RW_RULES_SRL (MATCH_RW_RULE2)
     //ADD_RW_RULE (zero_srl, e0, e1);
 
     assert (!result);
     if (!result)
     {
       result = btor_node_create_bv_srl (btor, e0, e1);
+      rw_defer (btor, result);
     }
     else
     {
@@ -7108,6 +7459,7 @@ rewrite_apply_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
     if (!result)
     {
       result = btor_node_create_apply (btor, e0, e1);
+      rw_defer (btor, result);
     }
     else
     {
@@ -7272,6 +7624,7 @@ rewrite_cond_exp (Btor *btor, BtorNode *e0, BtorNode *e1, BtorNode *e2)
     if (!result)
     {
       result = btor_node_create_cond (btor, e0, e1, e2);
+      rw_defer (btor, result);
     }
     else
     {
@@ -21,6 +21,7 @@
 #include "btorcore.h"
 #include "sat/btorcadical.h"
 #include "sat/btorcms.h"
+#include "sat/btoripasir.h"
 #include "sat/btorlgl.h"
 #include "sat/btorminisat.h"
 #include "sat/btorpicosat.h"
@@ -30,11 +31,12 @@
 
 #if !defined(BTOR_USE_LINGELING) && !defined(BTOR_USE_PICOSAT)  \
     && !defined(BTOR_USE_MINISAT) && !defined(BTOR_USE_CADICAL) \
-    && !defined(BTOR_USE_CMS)
+    && !defined(BTOR_USE_CMS) && !defined(BTOR_USE_IPASIR)
 #error "no SAT solver configured"
 #endif
 
 static bool enable_dimacs_printer (BtorSATMgr *smgr);
+static bool enable_cube_solver (BtorSATMgr *smgr);
 
 /*------------------------------------------------------------------------*/
 /* wrapper functions for SAT solver API                                   */
@@ -314,6 +316,9 @@ btor_sat_enable_solver (BtorSATMgr *smgr)
 #endif
 #ifdef BTOR_USE_CMS
     case BTOR_SAT_ENGINE_CMS: btor_sat_enable_cms (smgr); break;
+#endif
+#ifdef BTOR_USE_IPASIR
+    case BTOR_SAT_ENGINE_IPASIR: btor_sat_enable_ipasir (smgr); break;
 #endif
     default: BTOR_ABORT (1, "no sat solver configured");
   }
@@ -324,6 +329,12 @@ btor_sat_enable_solver (BtorSATMgr *smgr)
             smgr->name,
             smgr->api.assume ? "both incremental and " : "");
 
+  if (btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_CUBES)
+      && btor_sat_mgr_has_incremental_support (smgr))
+  {
+    enable_cube_solver (smgr);
+  }
+
   if (btor_opt_get (smgr->btor, BTOR_OPT_PRINT_DIMACS))
   {
     enable_dimacs_printer (smgr);
@@ -747,3 +758,632 @@ enable_dimacs_printer (BtorSATMgr *smgr)
 
   return true;
 }
+
+/*------------------------------------------------------------------------*/
+/* Cube-and-conquer                                                       */
+/*------------------------------------------------------------------------*/
+
+static inline void
+lock_cube_solver (BtorCubeSolver *cs)
+{
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_lock (&cs->mutex);
+#else
+  (void) cs;
+#endif
+}
+
+static inline void
+unlock_cube_solver (BtorCubeSolver *cs)
+{
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_unlock (&cs->mutex);
+#else
+  (void) cs;
+#endif
+}
+
+/* Literal of the i-th cube variable in given cube. */
+static inline int32_t
+cube_lit (BtorCubeSolver *cs, uint32_t cube, uint32_t i)
+{
+  int32_t var = BTOR_PEEK_STACK (cs->cube_vars, i);
+  return (cube >> i) & 1 ? var : -var;
+}
+
+static int32_t
+cube_worker_terminate (void *state)
+{
+  BtorCubeWorker *worker = (BtorCubeWorker *) state;
+  BtorCubeSolver *cs     = worker->cs;
+  bool done;
+
+  lock_cube_solver (cs);
+  done = cs->done;
+  unlock_cube_solver (cs);
+  if (done) return 1;
+  /* Only the first worker (which runs in the calling thread) queries the
+   * termination callback of the wrapping SAT manager. */
+  if (worker->id == 0 && cs->term.fun && cs->term.fun (cs->term.state))
+  {
+    lock_cube_solver (cs);
+    cs->done = true;
+    unlock_cube_solver (cs);
+    return 1;
+  }
+  return 0;
+}
+
+static void *
+cube_worker_run (void *state)
+{
+  BtorCubeWorker *worker = (BtorCubeWorker *) state;
+  BtorCubeSolver *cs     = worker->cs;
+  BtorSATMgr *smgr       = worker->smgr;
+  BtorSolverResult res;
+  uint32_t cube, depth;
+  int32_t lit;
+  bool cube_failed;
+  size_t i;
+
+  depth = BTOR_COUNT_STACK (cs->cube_vars);
+  for (;;)
+  {
+    lock_cube_solver (cs);
+    if (cs->done || cs->next_cube == cs->ncubes)
+    {
+      unlock_cube_solver (cs);
+      break;
+    }
+    cube = cs->next_cube++;
+    unlock_cube_solver (cs);
+
+    for (i = 0; i < BTOR_COUNT_STACK (cs->assumptions); i++)
+      btor_sat_assume (smgr, BTOR_PEEK_STACK (cs->assumptions, i));
+    for (i = 0; i < depth; i++) btor_sat_assume (smgr, cube_lit (cs, cube, i));
+
+    res = btor_sat_check_sat (smgr, -1);
+
+    if (res == BTOR_RESULT_SAT)
+    {
+      lock_cube_solver (cs);
+      if (!cs->done)
+      {
+        assert (smgr->maxvar < cs->size);
+        for (lit = 1; lit <= smgr->maxvar; lit++)
+          cs->model[lit] = btor_sat_deref (smgr, lit);
+        cs->result = 10;
+        cs->done   = true;
+      }
+      cs->stats.cubes_sat++;
+      unlock_cube_solver (cs);
+      break;
+    }
+    else if (res == BTOR_RESULT_UNSAT)
+    {
+      cube_failed = false;
+      for (i = 0; i < depth && !cube_failed; i++)
+        cube_failed = btor_sat_failed (smgr, cube_lit (cs, cube, i));
+
+      lock_cube_solver (cs);
+      for (i = 0; i < BTOR_COUNT_STACK (cs->assumptions); i++)
+      {
+        lit = BTOR_PEEK_STACK (cs->assumptions, i);
+        if (btor_sat_failed (smgr, lit)) cs->failed[abs (lit)] = lit < 0 ? -1 : 1;
+      }
+      cs->unsat_cubes++;
+      cs->stats.cubes_unsat++;
+      /* The conflict does not depend on the cube, i.e., the formula is
+       * unsatisfiable under the original assumptions. */
+      if (!cube_failed && !cs->done)
+      {
+        cs->result = 20;
+        cs->done   = true;
+        cs->stats.early_unsat++;
+      }
+      unlock_cube_solver (cs);
+    }
+    else
+    {
+      assert (res == BTOR_RESULT_UNKNOWN);
+      break;
+    }
+  }
+  return 0;
+}
+
+static void
+new_cube_workers (BtorSATMgr *smgr)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  Btor *btor         = smgr->btor;
+  BtorCubeWorker *worker;
+  uint32_t i;
+
+#ifdef BTOR_HAVE_PTHREADS
+  cs->nworkers = btor_opt_get (btor, BTOR_OPT_SAT_ENGINE_N_THREADS);
+#else
+  cs->nworkers = 1;
+#endif
+  BTOR_CNEWN (btor->mm, cs->workers, cs->nworkers);
+
+  for (i = 0; i < cs->nworkers; i++)
+  {
+    worker     = &cs->workers[i];
+    worker->cs = cs;
+    worker->id = i;
+    /* The first worker solves its cubes on the wrapped SAT manager. */
+    if (i == 0)
+    {
+      worker->smgr = cs->smgr;
+      continue;
+    }
+    worker->btor = btor_new ();
+    btor_opt_set (worker->btor, BTOR_OPT_VERBOSITY, 0);
+    btor_opt_set (worker->btor,
+                  BTOR_OPT_SAT_ENGINE,
+                  btor_opt_get (btor, BTOR_OPT_SAT_ENGINE));
+    btor_opt_set (worker->btor,
+                  BTOR_OPT_SAT_ENGINE_LGL_FORK,
+                  btor_opt_get (btor, BTOR_OPT_SAT_ENGINE_LGL_FORK));
+    btor_opt_set (worker->btor,
+                  BTOR_OPT_SAT_ENGINE_CADICAL_FREEZE,
+                  btor_opt_get (btor, BTOR_OPT_SAT_ENGINE_CADICAL_FREEZE));
+    btor_opt_set (worker->btor, BTOR_OPT_SAT_ENGINE_N_THREADS, 1);
+    btor_opt_set (worker->btor, BTOR_OPT_SAT_ENGINE_CUBES, 0);
+    btor_opt_set (worker->btor, BTOR_OPT_PRINT_DIMACS, 0);
+    worker->smgr = btor_get_sat_mgr (worker->btor);
+    btor_sat_mgr_set_term (worker->smgr, cube_worker_terminate, worker);
+    btor_sat_enable_solver (worker->smgr);
+    btor_sat_init (worker->smgr);
+  }
+  BTOR_MSG (btor->msg, 1, "started %u cube workers", cs->nworkers);
+}
+
+static void
+delete_cube_workers (BtorCubeSolver *cs, BtorMemMgr *mm)
+{
+  uint32_t i;
+
+  if (!cs->workers) return;
+  for (i = 1; i < cs->nworkers; i++) btor_delete (cs->workers[i].btor);
+  BTOR_DELETEN (mm, cs->workers, cs->nworkers);
+  cs->workers  = 0;
+  cs->nworkers = 0;
+}
+
+/* Send all variables, clauses and melted literals recorded since the last
+ * call to given SAT manager, where 'nclauses' and 'nmelted' are the number of
+ * literals in 'cs->clauses' and 'cs->melted' that were already sent. */
+static void
+sync_cube_smgr (BtorCubeSolver *cs,
+                BtorSATMgr *smgr,
+                size_t *nclauses,
+                size_t *nmelted)
+{
+  while (smgr->maxvar < cs->maxvar) btor_sat_mgr_next_cnf_id (smgr);
+  assert (smgr->maxvar == cs->maxvar);
+  for (; *nclauses < BTOR_COUNT_STACK (cs->clauses); *nclauses += 1)
+    add (smgr, BTOR_PEEK_STACK (cs->clauses, *nclauses));
+  for (; *nmelted < BTOR_COUNT_STACK (cs->melted); *nmelted += 1)
+    melt (smgr, BTOR_PEEK_STACK (cs->melted, *nmelted));
+}
+
+static void
+sync_cube_workers (BtorCubeSolver *cs)
+{
+  BtorCubeWorker *worker;
+  uint32_t i;
+
+  sync_cube_smgr (cs, cs->smgr, &cs->nclauses, &cs->nmelted);
+  for (i = 1; i < cs->nworkers; i++)
+  {
+    worker = &cs->workers[i];
+    sync_cube_smgr (cs, worker->smgr, &worker->nclauses, &worker->nmelted);
+  }
+}
+
+/* Select (at most) 'depth' variables to split on.  We use the number of
+ * occurrences in the CNF as a measure of impact, which for bit-blasted
+ * formulas prefers the bits with the highest AIG fan-out. */
+static uint32_t
+select_cube_vars (BtorSATMgr *smgr, uint32_t depth)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  BtorMemMgr *mm     = smgr->btor->mm;
+  uint32_t *occs;
+  int32_t var, best;
+  size_t i;
+
+  BTOR_CNEWN (mm, occs, cs->maxvar + 1);
+  for (i = 0; i < BTOR_COUNT_STACK (cs->clauses); i++)
+    occs[abs (BTOR_PEEK_STACK (cs->clauses, i))]++;
+  /* Never split on the constant, assumed or melted variables. */
+  occs[0]              = 0;
+  occs[smgr->true_lit] = 0;
+  for (i = 0; i < BTOR_COUNT_STACK (cs->assumptions); i++)
+    occs[abs (BTOR_PEEK_STACK (cs->assumptions, i))] = 0;
+  for (i = 0; i < BTOR_COUNT_STACK (cs->melted); i++)
+    occs[abs (BTOR_PEEK_STACK (cs->melted, i))] = 0;
+
+  BTOR_RESET_STACK (cs->cube_vars);
+  while (BTOR_COUNT_STACK (cs->cube_vars) < depth)
+  {
+    best = 0;
+    for (var = 1; var <= cs->maxvar; var++)
+      if (occs[var] > occs[best]) best = var;
+    if (!best) break;
+    BTOR_PUSH_STACK (cs->cube_vars, best);
+    occs[best] = 0;
+  }
+  BTOR_DELETEN (mm, occs, cs->maxvar + 1);
+  return BTOR_COUNT_STACK (cs->cube_vars);
+}
+
+static int32_t
+solve_cubes (BtorSATMgr *smgr)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  BtorMemMgr *mm     = smgr->btor->mm;
+  double start       = btor_util_time_stamp ();
+#ifdef BTOR_HAVE_PTHREADS
+  uint32_t i;
+#endif
+
+  if (!cs->workers) new_cube_workers (smgr);
+  sync_cube_workers (cs);
+
+  if (cs->size <= cs->maxvar)
+  {
+    if (cs->size)
+    {
+      BTOR_DELETEN (mm, cs->model, cs->size);
+      BTOR_DELETEN (mm, cs->failed, cs->size);
+    }
+    cs->size = cs->maxvar + 1;
+    BTOR_CNEWN (mm, cs->model, cs->size);
+    BTOR_CNEWN (mm, cs->failed, cs->size);
+  }
+  else
+  {
+    BTOR_CLRN (cs->failed, cs->size);
+  }
+
+  cs->ncubes      = 1u << BTOR_COUNT_STACK (cs->cube_vars);
+  cs->next_cube   = 0;
+  cs->unsat_cubes = 0;
+  cs->result      = 0;
+  cs->done        = false;
+  cs->stats.calls++;
+
+#ifdef BTOR_HAVE_PTHREADS
+  /* cubes are picked from a shared queue, if a thread can not be started
+   * its cubes are solved by the remaining workers */
+  for (i = 1; i < cs->nworkers; i++)
+    cs->workers[i].started = pthread_create (&cs->workers[i].thread,
+                                             0,
+                                             cube_worker_run,
+                                             &cs->workers[i])
+                             == 0;
+#endif
+  cs->smgr->term.fun   = cube_worker_terminate;
+  cs->smgr->term.state = &cs->workers[0];
+  cube_worker_run (&cs->workers[0]);
+  cs->smgr->term.fun   = cs->term.fun;
+  cs->smgr->term.state = cs->term.state;
+  setterm (cs->smgr);
+#ifdef BTOR_HAVE_PTHREADS
+  for (i = 1; i < cs->nworkers; i++)
+    if (cs->workers[i].started) pthread_join (cs->workers[i].thread, 0);
+#endif
+
+  if (!cs->result && cs->unsat_cubes == cs->ncubes) cs->result = 20;
+  cs->cubed = cs->result != 0;
+
+  BTOR_MSG (smgr->btor->msg,
+            2,
+            "%u cubes on %u variables: %u unsat, result %d in %.2f seconds",
+            cs->ncubes,
+            BTOR_COUNT_STACK (cs->cube_vars),
+            cs->unsat_cubes,
+            cs->result,
+            btor_util_time_stamp () - start);
+  return cs->result;
+}
+
+static void *
+cube_solver_init (BtorSATMgr *smgr)
+{
+  BtorCubeSolver *cs       = (BtorCubeSolver *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = cs->smgr;
+
+  BTOR_INIT_STACK (smgr->btor->mm, cs->clauses);
+  BTOR_INIT_STACK (smgr->btor->mm, cs->assumptions);
+  BTOR_INIT_STACK (smgr->btor->mm, cs->melted);
+  BTOR_INIT_STACK (smgr->btor->mm, cs->cube_vars);
+
+  /* See dimacs_printer_init. The wrapped SAT manager is the first cube worker
+   * and is therefore always used incrementally (init_flags). */
+  BTOR_MSG (smgr->btor->msg, 1, "initialized %s", wrapped_smgr->name);
+  init_flags (wrapped_smgr);
+  wrapped_smgr->solver = wrapped_smgr->api.init (wrapped_smgr);
+
+  return cs;
+}
+
+static void
+cube_solver_add (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  /* Clauses are sent to the wrapped SAT manager or the workers when calling
+   * cube_solver_sat. */
+  BTOR_PUSH_STACK (cs->clauses, lit);
+}
+
+static void
+cube_solver_assume (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  /* Assumptions are sent to the wrapped SAT manager or the workers when
+   * calling cube_solver_sat. */
+  BTOR_PUSH_STACK (cs->assumptions, lit);
+}
+
+static int32_t
+cube_solver_deref (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  int32_t val;
+
+  if (!cs->cubed) return deref (cs->smgr, lit);
+  val = abs (lit) < cs->size ? cs->model[abs (lit)] : 0;
+  return lit < 0 ? -val : val;
+}
+
+static int32_t
+cube_solver_repr (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  if (cs->cubed) return lit;
+  return repr (cs->smgr, lit);
+}
+
+static void
+cube_solver_enable_verbosity (BtorSATMgr *smgr, int32_t level)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  enable_verbosity (cs->smgr, level);
+}
+
+static int32_t
+cube_solver_failed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+
+  if (!cs->cubed) return failed (cs->smgr, lit);
+  return abs (lit) < cs->size && cs->failed[abs (lit)] == (lit < 0 ? -1 : 1);
+}
+
+static int32_t
+cube_solver_fixed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  return fixed (cs->smgr, lit);
+}
+
+static void
+cube_solver_reset (BtorSATMgr *smgr)
+{
+  BtorCubeSolver *cs       = (BtorCubeSolver *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = cs->smgr;
+  BtorMemMgr *mm           = smgr->btor->mm;
+
+  delete_cube_workers (cs, mm);
+  reset (wrapped_smgr);
+
+  BTOR_DELETE (mm, wrapped_smgr);
+  BTOR_RELEASE_STACK (cs->clauses);
+  BTOR_RELEASE_STACK (cs->assumptions);
+  BTOR_RELEASE_STACK (cs->melted);
+  BTOR_RELEASE_STACK (cs->cube_vars);
+  if (cs->size)
+  {
+    BTOR_DELETEN (mm, cs->model, cs->size);
+    BTOR_DELETEN (mm, cs->failed, cs->size);
+  }
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_destroy (&cs->mutex);
+#endif
+  BTOR_DELETE (mm, cs);
+  smgr->solver = 0;
+}
+
+static int32_t
+cube_solver_sat (BtorSATMgr *smgr, int32_t limit)
+{
+  BtorCubeSolver *cs       = (BtorCubeSolver *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = cs->smgr;
+  uint32_t depth;
+  int32_t res;
+  size_t i;
+
+  wrapped_smgr->satcalls = smgr->satcalls;
+  cs->cubed              = false;
+
+  /* Only split unlimited calls, limited calls are usually cheap. */
+  depth = limit < 0 ? btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_CUBES) : 0;
+  if (depth && select_cube_vars (smgr, depth))
+  {
+    res = solve_cubes (smgr);
+  }
+  else
+  {
+    sync_cube_smgr (cs, wrapped_smgr, &cs->nclauses, &cs->nmelted);
+    for (i = 0; i < BTOR_COUNT_STACK (cs->assumptions); i++)
+      assume (wrapped_smgr, BTOR_PEEK_STACK (cs->assumptions, i));
+    res = sat (wrapped_smgr, limit);
+  }
+  BTOR_RESET_STACK (cs->assumptions);
+  return res;
+}
+
+static void
+cube_solver_set_output (BtorSATMgr *smgr, FILE *output)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  set_output (cs->smgr, output);
+}
+
+static void
+cube_solver_set_prefix (BtorSATMgr *smgr, const char *prefix)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  set_prefix (cs->smgr, prefix);
+}
+
+static void
+cube_solver_stats (BtorSATMgr *smgr)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "%u cube-and-conquer calls with %u workers",
+            cs->stats.calls,
+            cs->nworkers);
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "%u sat cubes, %u unsat cubes, %u early unsat",
+            cs->stats.cubes_sat,
+            cs->stats.cubes_unsat,
+            cs->stats.early_unsat);
+  stats (cs->smgr);
+}
+
+static void *
+cube_solver_clone (Btor *btor, BtorSATMgr *smgr)
+{
+  BtorCubeSolver *cs, *cs_clone;
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  cs = (BtorCubeSolver *) smgr->solver;
+
+  /* Note: Workers are not cloned, the clone starts new workers on demand. */
+  BTOR_CNEW (mm, cs_clone);
+  clone_int_stack (mm, &cs_clone->clauses, &cs->clauses);
+  clone_int_stack (mm, &cs_clone->assumptions, &cs->assumptions);
+  clone_int_stack (mm, &cs_clone->melted, &cs->melted);
+  clone_int_stack (mm, &cs_clone->cube_vars, &cs->cube_vars);
+  cs_clone->maxvar   = cs->maxvar;
+  cs_clone->nclauses = cs->nclauses;
+  cs_clone->nmelted  = cs->nmelted;
+  cs_clone->cubed    = cs->cubed;
+  cs_clone->size     = cs->size;
+  if (cs->size)
+  {
+    BTOR_NEWN (mm, cs_clone->model, cs->size);
+    BTOR_NEWN (mm, cs_clone->failed, cs->size);
+    memcpy (cs_clone->model, cs->model, cs->size * sizeof (*cs->model));
+    memcpy (cs_clone->failed, cs->failed, cs->size * sizeof (*cs->failed));
+  }
+  cs_clone->stats = cs->stats;
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_init (&cs_clone->mutex, 0);
+#endif
+  cs_clone->smgr = btor_sat_mgr_clone (btor, cs->smgr);
+
+  return cs_clone;
+}
+
+static void
+cube_solver_setterm (BtorSATMgr *smgr)
+{
+  BtorCubeSolver *cs       = (BtorCubeSolver *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = cs->smgr;
+  cs->term.fun             = smgr->term.fun;
+  cs->term.state           = smgr->term.state;
+  wrapped_smgr->term.fun   = smgr->term.fun;
+  wrapped_smgr->term.state = smgr->term.state;
+  setterm (wrapped_smgr);
+}
+
+static int32_t
+cube_solver_inc_max_var (BtorSATMgr *smgr)
+{
+  BtorCubeSolver *cs       = (BtorCubeSolver *) smgr->solver;
+  BtorSATMgr *wrapped_smgr = cs->smgr;
+  int32_t res;
+  wrapped_smgr->maxvar = smgr->maxvar;
+  res                  = inc_max_var (wrapped_smgr);
+  wrapped_smgr->maxvar = res;
+  if (res > cs->maxvar) cs->maxvar = res;
+  return res;
+}
+
+static void
+cube_solver_melt (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCubeSolver *cs = (BtorCubeSolver *) smgr->solver;
+  /* See cube_solver_add. */
+  BTOR_PUSH_STACK (cs->melted, lit);
+}
+
+/*------------------------------------------------------------------------*/
+
+/* The cube solver is a SAT manager that wraps the currently configured SAT
+ * manager. It records the CNF sent to the SAT solver and forwards all API
+ * calls to the wrapped SAT manager, except for unlimited SAT calls. These are
+ * split into 2^n cubes on the n variables with the most occurrences, which
+ * are solved by a pool of workers (BTOR_OPT_SAT_ENGINE_N_THREADS). The first
+ * worker is the wrapped SAT manager, every other worker maintains its own
+ * incremental copy of the CNF. The recorded CNF is replayed to the wrapped
+ * SAT manager and the workers before each SAT call. The merged result (model
+ * or failed assumptions) is then reported as the result of the SAT call.
+ * Requires a SAT solver with incremental support. */
+static bool
+enable_cube_solver (BtorSATMgr *smgr)
+{
+  assert (smgr);
+  assert (smgr->name);
+  assert (btor_sat_mgr_has_incremental_support (smgr));
+
+  BtorCubeSolver *cs;
+
+  BTOR_CNEW (smgr->btor->mm, cs);
+  BTOR_CNEW (smgr->btor->mm, cs->smgr);
+  memcpy (cs->smgr, smgr, sizeof (BtorSATMgr));
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_init (&cs->mutex, 0);
+#endif
+
+  memset (&smgr->api, 0, sizeof (smgr->api));
+
+  smgr->solver               = cs;
+  smgr->name                 = "Cube Solver";
+  smgr->api.add              = cube_solver_add;
+  smgr->api.assume           = cube_solver_assume;
+  smgr->api.deref            = cube_solver_deref;
+  smgr->api.enable_verbosity = cube_solver_enable_verbosity;
+  smgr->api.failed           = cube_solver_failed;
+  smgr->api.fixed            = cube_solver_fixed;
+  smgr->api.inc_max_var      = cube_solver_inc_max_var;
+  smgr->api.init             = cube_solver_init;
+  smgr->api.melt             = cube_solver_melt;
+  smgr->api.repr             = cube_solver_repr;
+  smgr->api.reset            = cube_solver_reset;
+  smgr->api.sat              = cube_solver_sat;
+  smgr->api.set_output       = cube_solver_set_output;
+  smgr->api.set_prefix       = cube_solver_set_prefix;
+  smgr->api.stats            = cube_solver_stats;
+  smgr->api.setterm          = cube_solver_setterm;
+  smgr->api.clone = cs->smgr->api.clone ? cube_solver_clone : 0;
+
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "enabled cube-and-conquer on %s with %u cube variables",
+            cs->smgr->name,
+            btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_CUBES));
+
+  return true;
+}
@@ -15,6 +15,10 @@
 #include <stdbool.h>
 #include <stdio.h>
 
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
 #include "btortypes.h"
 #include "utils/btormem.h"
 #include "utils/btorstack.h"
@@ -91,6 +95,77 @@ typedef struct BtorCnfPrinter BtorCnfPrinter;
 
 /*------------------------------------------------------------------------*/
 
+typedef struct BtorCubeSolver BtorCubeSolver;
+typedef struct BtorCubeWorker BtorCubeWorker;
+
+/* The first worker runs in the calling thread on the wrapped SAT manager.
+ * Every other worker owns a private Btor instance and SAT manager, since
+ * memory managers (and hence SAT managers) must not be shared between
+ * threads. */
+struct BtorCubeWorker
+{
+  BtorCubeSolver *cs;
+  uint32_t id;
+  Btor *btor; /* 0 for the first worker */
+  BtorSATMgr *smgr;
+  /* Number of literals in 'cs->clauses' and 'cs->melted' sent to 'smgr'.
+   * Not used by the first worker, see 'nclauses' of BtorCubeSolver. */
+  size_t nclauses;
+  size_t nmelted;
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_t thread;
+  bool started; /* 'thread' was created successfully */
+#endif
+};
+
+struct BtorCubeSolver
+{
+  BtorSATMgr *smgr; /* SAT manager wrapped by the cube solver. */
+  BtorIntStack clauses;
+  BtorIntStack assumptions;
+  BtorIntStack melted;
+  BtorIntStack cube_vars;
+  int32_t maxvar;
+  size_t nclauses; /* number of literals in 'clauses' sent to 'smgr' */
+  size_t nmelted;  /* number of literals in 'melted' sent to 'smgr' */
+
+  BtorCubeWorker *workers;
+  uint32_t nworkers;
+
+  struct
+  {
+    int32_t (*fun) (void *); /* termination callback of 'smgr' */
+    void *state;
+  } term;
+
+  /* Model (SAT case) or failed assumptions (UNSAT case) of the last call
+   * that was decided by the workers, indexed by variable. */
+  bool cubed;
+  int8_t *model;
+  int8_t *failed;
+  int32_t size;
+
+  /* Shared by all workers, protected by 'mutex'. */
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_t mutex;
+#endif
+  uint32_t ncubes;
+  uint32_t next_cube;
+  uint32_t unsat_cubes;
+  int32_t result;
+  bool done;
+
+  struct
+  {
+    uint32_t calls;
+    uint32_t cubes_sat;
+    uint32_t cubes_unsat;
+    uint32_t early_unsat;
+  } stats;
+};
+
+/*------------------------------------------------------------------------*/
+
 /* Creates new SAT manager.
  * A SAT manager is used by nearly all functions of the SAT layer.
  */
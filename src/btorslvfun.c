@@ -29,6 +29,9 @@
 #include "utils/btorunionfind.h"
 #include "utils/btorutil.h"
 
+static void prune_betap_cache (Btor *btor, bool all);
+static void reset_lemma_premises (BtorFunSolver *slv);
+
 /*------------------------------------------------------------------------*/
 
 static BtorFunSolver *
@@ -48,12 +51,19 @@ clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
   BTOR_NEW (clone->mm, res);
   memcpy (res, slv, sizeof (BtorFunSolver));
 
-  res->btor   = clone;
-  res->lemmas = btor_hashptr_table_clone (
+  res->btor             = clone;
+  res->app_chains       = 0;
+  res->args_assignments = 0;
+  res->args_tuples      = 0;
+  res->store_chains     = 0;
+  res->betap_cache      = 0;
+  BTOR_INIT_STACK (clone->mm, res->store_chain_segs);
+  res->lemmas           = btor_hashptr_table_clone (
       clone->mm, slv->lemmas, btor_clone_key_as_node, 0, exp_map, 0);
 
   btor_clone_node_ptr_stack (
       clone->mm, &slv->cur_lemmas, &res->cur_lemmas, exp_map, false);
+  BTOR_INIT_STACK (clone->mm, res->cur_lemma_prems);
 
   if (slv->score)
   {
@@ -113,6 +123,12 @@ delete_fun_solver (BtorFunSolver *slv)
 
   btor = slv->btor;
 
+  assert (!slv->app_chains);
+  assert (!slv->args_assignments);
+  assert (!slv->store_chains);
+
+  prune_betap_cache (btor, true);
+
   btor_iter_hashptr_init (&it, slv->lemmas);
   while (btor_iter_hashptr_has_next (&it))
     btor_node_release (btor, btor_iter_hashptr_next (&it));
@@ -146,6 +162,8 @@ delete_fun_solver (BtorFunSolver *slv)
   }
 
   BTOR_RELEASE_STACK (slv->cur_lemmas);
+  reset_lemma_premises (slv);
+  BTOR_RELEASE_STACK (slv->cur_lemma_prems);
   BTOR_RELEASE_STACK (slv->stats.lemmas_size);
   BTOR_DELETE (btor->mm, slv);
   btor->slv = 0;
@@ -607,6 +625,44 @@ DONE:
   return result;
 }
 
+/* Collect the top applies below the function equalities on 'feqs'. */
+static void
+collect_applies_below_feqs (Btor *btor,
+                            BtorNodePtrStack *feqs,
+                            BtorIntHashTable *top_applies,
+                            BtorNodePtrStack *top_applies_feq)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorIntHashTable *mark;
+
+  mark = btor_hashint_table_new (btor->mm);
+  while (!BTOR_EMPTY_STACK (*feqs))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (*feqs));
+
+    if (!cur->apply_below || btor_hashint_table_contains (mark, cur->id))
+      continue;
+
+    btor_hashint_table_add (mark, cur->id);
+
+    /* we only need the "top applies" below a failed function equality */
+    if (!cur->parameterized && btor_node_is_apply (cur))
+    {
+      BTORLOG (1, "apply below eq: %s", btor_util_node2string (cur));
+      if (!btor_hashint_table_contains (top_applies, cur->id))
+      {
+        BTOR_PUSH_STACK (*top_applies_feq, cur);
+        btor_hashint_table_add (top_applies, cur->id);
+      }
+      continue;
+    }
+
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (*feqs, cur->e[i]);
+  }
+  btor_hashint_table_delete (mark);
+}
+
 static void
 collect_applies (Btor *btor,
                  Btor *clone,
@@ -625,7 +681,6 @@ collect_applies (Btor *btor,
   assert (top_applies_feq);
 
   double start;
-  uint32_t i;
   BtorMemMgr *mm;
   BtorFunSolver *slv;
   BtorNode *cur_btor, *cur_clone, *bv_eq;
@@ -691,36 +746,9 @@ collect_applies (Btor *btor,
   }
 
   btor_hashint_table_delete (mark);
-  mark = btor_hashint_table_new (mm);
-
-  /* collect applies below failed function equalities */
-  while (!BTOR_EMPTY_STACK (failed_eqs))
-  {
-    cur_btor = btor_node_real_addr (BTOR_POP_STACK (failed_eqs));
-
-    if (!cur_btor->apply_below
-        || btor_hashint_table_contains (mark, cur_btor->id))
-      continue;
-
-    btor_hashint_table_add (mark, cur_btor->id);
 
-    /* we only need the "top applies" below a failed function equality */
-    if (!cur_btor->parameterized && btor_node_is_apply (cur_btor))
-    {
-      BTORLOG (1, "apply below eq: %s", btor_util_node2string (cur_btor));
-      if (!btor_hashint_table_contains (top_applies, cur_btor->id))
-      {
-        BTOR_PUSH_STACK (*top_applies_feq, cur_btor);
-        btor_hashint_table_add (top_applies, cur_btor->id);
-      }
-      continue;
-    }
-
-    for (i = 0; i < cur_btor->arity; i++)
-      BTOR_PUSH_STACK (failed_eqs, cur_btor->e[i]);
-  }
+  collect_applies_below_feqs (btor, &failed_eqs, top_applies, top_applies_feq);
   BTOR_RELEASE_STACK (failed_eqs);
-  btor_hashint_table_delete (mark);
   slv->time.search_init_apps_collect_fa += btor_util_time_stamp () - start;
 }
 
@@ -822,6 +850,50 @@ set_up_dual_and_collect (Btor *btor,
   btor_nodemap_delete (key_map);
 }
 
+/* Collect bit-vector variables, applies and function equalities (the inputs
+ * of the bit-vector skeleton) reachable from the constraints. */
+static void
+collect_dual_prop_inputs (Btor *btor, BtorNodePtrStack *inputs)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack stack;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *mark;
+
+  mark = btor_hashint_table_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, stack);
+
+  btor_iter_hashptr_init (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    BTOR_PUSH_STACK (stack, cur);
+
+    while (!BTOR_EMPTY_STACK (stack))
+    {
+      cur = btor_node_real_addr (BTOR_POP_STACK (stack));
+
+      if (btor_hashint_table_contains (mark, cur->id)) continue;
+
+      btor_hashint_table_add (mark, cur->id);
+      if (btor_node_is_bv_var (cur) || btor_node_is_fun_eq (cur)
+          || btor_node_is_apply (cur))
+      {
+        assert (btor_node_is_synth (cur));
+        BTOR_PUSH_STACK (*inputs, cur);
+        continue;
+      }
+
+      for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (stack, cur->e[i]);
+    }
+  }
+
+  BTOR_RELEASE_STACK (stack);
+  btor_hashint_table_delete (mark);
+}
+
 static void
 search_initial_applies_dual_prop (Btor *btor,
                                   Btor *clone,
@@ -838,13 +910,68 @@ search_initial_applies_dual_prop (Btor *btor,
   assert (top_applies);
 
   double start;
-  uint32_t i;
+  BtorNodePtrStack inputs;
+  BtorSATMgr *smgr;
+  BtorFunSolver *slv;
+  BtorMemMgr *mm;
+
+  start = btor_util_time_stamp ();
+
+  BTORLOG (1, "");
+  BTORLOG (1, "*** search initial applies");
+
+  mm                            = btor->mm;
+  slv                           = BTOR_FUN_SOLVER (btor);
+  slv->stats.dp_failed_vars     = 0;
+  slv->stats.dp_assumed_vars    = 0;
+  slv->stats.dp_failed_applies  = 0;
+  slv->stats.dp_assumed_applies = 0;
+
+  smgr = btor_get_sat_mgr (btor);
+  if (!smgr->inc_required) return;
+
+  BTOR_INIT_STACK (mm, inputs);
+  collect_dual_prop_inputs (btor, &inputs);
+
+  (void) btor_node_compare_by_id_qsort_asc;
+
+  set_up_dual_and_collect (
+      btor, clone, clone_root, exp_map, &inputs, top_applies);
+
+  BTOR_RELEASE_STACK (inputs);
+
+  slv->time.search_init_apps += btor_util_time_stamp () - start;
+}
+
+/* Dual propagation without a clone: justify the constraints on the AIG
+ * layer w.r.t. the current SAT assignment. An AND with value true requires
+ * both children, an AND with value false only one false child. Inputs of the
+ * bit-vector skeleton none of whose AIG variables is reached by the
+ * justification are don't cares (as failed assumptions determine in the
+ * clone based approach). */
+static void
+search_initial_applies_dual_prop_aig (Btor *btor,
+                                      BtorNodePtrStack *top_applies)
+{
+  assert (btor);
+  assert (btor->slv);
+  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
+  assert (top_applies);
+
+  double start;
+  uint32_t i, j;
+  int32_t lval, rval;
+  bool needed;
   BtorNode *cur;
-  BtorNodePtrStack stack, inputs;
+  BtorAIG *aig, *left, *right;
+  BtorAIGVec *av;
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack visit;
+  BtorNodePtrStack inputs, feqs, topapps_feq;
   BtorPtrHashTableIterator it;
   BtorSATMgr *smgr;
   BtorFunSolver *slv;
-  BtorIntHashTable *mark;
+  BtorIntHashTable *cache, *vars, *topapps;
   BtorMemMgr *mm;
 
   start = btor_util_time_stamp ();
@@ -862,44 +989,118 @@ search_initial_applies_dual_prop (Btor *btor,
   smgr = btor_get_sat_mgr (btor);
   if (!smgr->inc_required) return;
 
-  mark = btor_hashint_table_new (mm);
-  BTOR_INIT_STACK (mm, stack);
-  BTOR_INIT_STACK (mm, inputs);
+  amgr  = btor_get_aig_mgr (btor);
+  cache = btor_hashint_table_new (mm);
+  vars  = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, visit);
 
   btor_iter_hashptr_init (&it, btor->synthesized_constraints);
   btor_iter_hashptr_queue (&it, btor->assumptions);
   while (btor_iter_hashptr_has_next (&it))
   {
     cur = btor_iter_hashptr_next (&it);
-    BTOR_PUSH_STACK (stack, cur);
+    assert (btor_node_is_synth (cur));
+    av = btor_node_real_addr (cur)->av;
+    assert (av->width == 1);
+    aig = av->aigs[0];
+    BTOR_PUSH_STACK (visit,
+                     btor_node_is_inverted (cur) ? BTOR_INVERT_AIG (aig) : aig);
+  }
 
-    while (!BTOR_EMPTY_STACK (stack))
-    {
-      cur = btor_node_real_addr (BTOR_POP_STACK (stack));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    aig = BTOR_REAL_ADDR_AIG (BTOR_POP_STACK (visit));
 
-      if (btor_hashint_table_contains (mark, cur->id)) continue;
+    if (btor_aig_is_const (aig)
+        || btor_hashint_table_contains (cache, btor_aig_get_id (aig)))
+      continue;
+    btor_hashint_table_add (cache, btor_aig_get_id (aig));
 
-      btor_hashint_table_add (mark, cur->id);
-      if (btor_node_is_bv_var (cur) || btor_node_is_fun_eq (cur)
-          || btor_node_is_apply (cur))
+    if (btor_aig_is_var (aig))
+    {
+      btor_hashint_table_add (vars, btor_aig_get_id (aig));
+      continue;
+    }
+
+    assert (btor_aig_is_and (aig));
+    left  = btor_aig_get_left_child (amgr, aig);
+    right = btor_aig_get_right_child (amgr, aig);
+    if (btor_aig_get_assignment (amgr, aig) == -1)
+    {
+      lval = btor_aig_get_assignment (amgr, left);
+      rval = btor_aig_get_assignment (amgr, right);
+      /* prefer a child that is already justified */
+      if (rval == -1
+          && (lval != -1
+              || btor_hashint_table_contains (
+                  cache, btor_aig_get_id (BTOR_REAL_ADDR_AIG (right)))))
       {
-        assert (btor_node_is_synth (cur));
-        BTOR_PUSH_STACK (inputs, cur);
+        BTOR_PUSH_STACK (visit, right);
+        continue;
+      }
+      if (lval == -1)
+      {
+        BTOR_PUSH_STACK (visit, left);
         continue;
       }
-
-      for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (stack, cur->e[i]);
     }
+    BTOR_PUSH_STACK (visit, left);
+    BTOR_PUSH_STACK (visit, right);
   }
+  BTOR_RELEASE_STACK (visit);
 
-  (void) btor_node_compare_by_id_qsort_asc;
+  BTOR_INIT_STACK (mm, inputs);
+  BTOR_INIT_STACK (mm, feqs);
+  BTOR_INIT_STACK (mm, topapps_feq);
+  topapps = btor_hashint_table_new (mm);
+  collect_dual_prop_inputs (btor, &inputs);
+  for (i = 0; i < BTOR_COUNT_STACK (inputs); i++)
+  {
+    cur = BTOR_PEEK_STACK (inputs, i);
+    av  = cur->av;
+    for (j = 0, needed = false; j < av->width && !needed; j++)
+    {
+      aig    = BTOR_REAL_ADDR_AIG (av->aigs[j]);
+      needed = !btor_aig_is_const (aig)
+               && btor_hashint_table_contains (vars, btor_aig_get_id (aig));
+    }
 
-  set_up_dual_and_collect (
-      btor, clone, clone_root, exp_map, &inputs, top_applies);
+    if (btor_node_is_bv_var (cur))
+    {
+      slv->stats.dp_assumed_vars += 1;
+      if (needed) slv->stats.dp_failed_vars += 1;
+    }
+    else if (btor_node_is_fun_eq (cur))
+    {
+      slv->stats.dp_assumed_eqs += 1;
+      if (needed)
+      {
+        slv->stats.dp_failed_eqs += 1;
+        BTOR_PUSH_STACK (feqs, cur);
+      }
+    }
+    else
+    {
+      assert (btor_node_is_apply (cur));
+      slv->stats.dp_assumed_applies += 1;
+      if (needed)
+      {
+        slv->stats.dp_failed_applies += 1;
+        btor_hashint_table_add (topapps, cur->id);
+        BTOR_PUSH_STACK (*top_applies, cur);
+      }
+    }
+  }
+  collect_applies_below_feqs (btor, &feqs, topapps, &topapps_feq);
+  for (i = 0; i < BTOR_COUNT_STACK (topapps_feq); i++)
+    BTOR_PUSH_STACK (*top_applies, BTOR_PEEK_STACK (topapps_feq, i));
 
-  BTOR_RELEASE_STACK (stack);
   BTOR_RELEASE_STACK (inputs);
-  btor_hashint_table_delete (mark);
+  BTOR_RELEASE_STACK (feqs);
+  BTOR_RELEASE_STACK (topapps_feq);
+  btor_hashint_table_delete (topapps);
+  btor_hashint_table_delete (vars);
+  btor_hashint_table_delete (cache);
 
   slv->time.search_init_apps += btor_util_time_stamp () - start;
 }
@@ -1181,6 +1382,99 @@ equal_bv_assignments (BtorNode *exp0, BtorNode *exp1)
   return equal;
 }
 
+/* Assignment of args nodes interned for the current refinement round, which
+ * allows to compare args assignments by pointer in the rho tables. */
+struct BtorFunArgsAssignment
+{
+  BtorBitVectorTuple *bvs;
+  uint32_t hash; /* same as computed by hash_args_assignment */
+};
+
+typedef struct BtorFunArgsAssignment BtorFunArgsAssignment;
+
+static void
+init_args_assignments (BtorFunSolver *slv)
+{
+  assert (!slv->args_assignments);
+  assert (!slv->args_tuples);
+
+  BtorMemMgr *mm = slv->btor->mm;
+
+  slv->args_assignments = btor_hashint_map_new (mm);
+  slv->args_tuples =
+      btor_hashptr_table_new (mm,
+                              (BtorHashPtr) btor_bv_hash_tuple,
+                              (BtorCmpPtr) btor_bv_compare_tuple);
+}
+
+static void
+delete_args_assignments (BtorFunSolver *slv)
+{
+  BtorMemMgr *mm;
+  BtorFunArgsAssignment *a;
+  BtorPtrHashTableIterator it;
+
+  mm = slv->btor->mm;
+  btor_iter_hashptr_init (&it, slv->args_tuples);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    a = it.bucket->data.as_ptr;
+    (void) btor_iter_hashptr_next (&it);
+    btor_bv_free_tuple (mm, a->bvs);
+    BTOR_DELETE (mm, a);
+  }
+  btor_hashptr_table_delete (slv->args_tuples);
+  btor_hashint_map_delete (slv->args_assignments);
+  slv->args_tuples      = 0;
+  slv->args_assignments = 0;
+}
+
+/* Returns the interned assignment of 'args' if called within a refinement
+ * round and 0 otherwise. */
+static BtorFunArgsAssignment *
+get_args_assignment (Btor *btor, BtorNode *args)
+{
+  assert (btor_node_is_regular (args));
+  assert (btor_node_is_args (args));
+
+  uint32_t i;
+  BtorFunSolver *slv;
+  BtorFunArgsAssignment *res;
+  BtorBitVectorTuple *t;
+  BtorArgsIterator it;
+  BtorHashTableData *d;
+  BtorPtrHashBucket *b;
+
+  if (!btor->slv || btor->slv->kind != BTOR_FUN_SOLVER_KIND) return 0;
+  slv = BTOR_FUN_SOLVER (btor);
+  if (!slv->args_assignments) return 0;
+
+  if ((d = btor_hashint_map_get (slv->args_assignments, args->id)))
+    return d->as_ptr;
+
+  t = btor_bv_new_tuple (btor->mm, btor_node_args_get_arity (btor, args));
+  btor_iter_args_init (&it, args);
+  for (i = 0; btor_iter_args_has_next (&it); i++)
+    t->bv[i] = get_bv_assignment (btor, btor_iter_args_next (&it));
+
+  if ((b = btor_hashptr_table_get (slv->args_tuples, t)))
+  {
+    btor_bv_free_tuple (btor->mm, t);
+    res = b->data.as_ptr;
+  }
+  else
+  {
+    BTOR_NEW (btor->mm, res);
+    res->bvs  = t;
+    res->hash = 0;
+    for (i = 0; i < t->arity; i++) res->hash += btor_bv_hash (t->bv[i]);
+    btor_hashptr_table_add (slv->args_tuples, t)->data.as_ptr = res;
+    slv->stats.args_interned++;
+  }
+  btor_hashint_map_add (slv->args_assignments, args->id)->as_ptr = res;
+  return res;
+}
+
 static int32_t
 compare_args_assignments (BtorNode *e0, BtorNode *e1)
 {
@@ -1196,11 +1490,20 @@ compare_args_assignments (BtorNode *e0, BtorNode *e1)
   BtorNode *arg0, *arg1;
   Btor *btor;
   BtorArgsIterator it0, it1;
+  BtorFunArgsAssignment *a0, *a1;
   btor = e0->btor;
 
   if (btor_node_get_sort_id (e0) != btor_node_get_sort_id (e1)) return 1;
 
   if (e0 == e1) return 0;
+
+  if ((a0 = get_args_assignment (btor, e0)))
+  {
+    a1 = get_args_assignment (btor, e1);
+    assert (a1);
+    return a0 != a1;
+  }
+
   btor_iter_args_init (&it0, e0);
   btor_iter_args_init (&it1, e1);
 
@@ -1235,8 +1538,11 @@ hash_args_assignment (BtorNode *exp)
   BtorNode *arg;
   BtorArgsIterator it;
   BtorBitVector *bv;
+  BtorFunArgsAssignment *a;
 
   btor = exp->btor;
+  if ((a = get_args_assignment (btor, exp))) return a->hash;
+
   hash = 0;
   btor_iter_args_init (&it, exp);
   while (btor_iter_args_has_next (&it))
@@ -1415,61 +1721,327 @@ mk_premise (Btor *btor, BtorNode *args, BtorNode *prem[], uint32_t num_prem)
   return res;
 }
 
+/* Returns true if premise 'lit' of a lemma is implied by the formula, i.e.,
+ * if it is a constraint or fixed to true on the top level of the SAT solver.
+ * Such premises can be dropped from the lemma. */
+static bool
+is_implied_premise (Btor *btor, BtorNode *lit)
+{
+  int32_t cnf_id;
+  BtorNode *real_lit;
+  BtorAIG *aig;
+
+  if (lit == btor->true_exp) return true;
+  if (btor_hashptr_table_get (btor->synthesized_constraints, lit)
+      || btor_hashptr_table_get (btor->unsynthesized_constraints, lit)
+      || btor_hashptr_table_get (btor->embedded_constraints, lit))
+    return true;
+
+  real_lit = btor_node_real_addr (lit);
+  if (!btor_node_is_synth (real_lit)) return false;
+  assert (real_lit->av->width == 1);
+  aig = real_lit->av->aigs[0];
+  if (btor_node_is_inverted (lit)) aig = BTOR_INVERT_AIG (aig);
+  if (btor_aig_is_const (aig)) return btor_aig_is_true (aig);
+  if (!(cnf_id = btor_aig_get_cnf_id (aig))) return false;
+  return btor_sat_fixed (btor_get_sat_mgr (btor), cnf_id) > 0;
+}
+
+/* Pushes the literals of premise 'prem' of a path of 'args' onto 'lits'. */
 static void
-add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
+push_premise_lits (Btor *btor,
+                   BtorNode *args,
+                   BtorNode *prem[],
+                   uint32_t num_prem,
+                   BtorNodePtrStack *lits)
 {
-  assert (btor);
-  assert (btor->slv);
-  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
-  assert (fun);
-  assert (btor_node_is_regular (fun));
-  assert (btor_node_is_fun (fun));
-  assert (!fun->parameterized);
-  assert (app1);
-  assert (btor_node_is_regular (app1));
-  assert (btor_node_is_apply (app1));
-  assert (!app2 || btor_node_is_regular (app2) || btor_node_is_apply (app2));
+  uint32_t i;
 
-  double start;
-  uint32_t i, lemma_size = 1;
-  BtorIntHashTable *cache_app1, *cache_app2;
-  BtorNodePtrStack prem_app1, prem_app2, prem;
-  BtorNode *value, *tmp, *and, *con, *lemma;
-  BtorMemMgr *mm;
-  BtorFunSolver *slv;
+  for (i = 0; i < num_prem; i++)
+  {
+    if (btor_node_is_args (prem[i]))
+      BTOR_PUSH_STACK (
+          *lits, btor_node_invert (mk_equal_args (btor, args, prem[i])));
+    else
+      BTOR_PUSH_STACK (*lits, btor_node_copy (btor, prem[i]));
+  }
+}
+
+/* Pushes the equalities of the arguments of 'args1' and 'args2' onto 'lits'.
+ */
+static void
+push_equal_args_lits (Btor *btor,
+                      BtorNode *args1,
+                      BtorNode *args2,
+                      BtorNodePtrStack *lits)
+{
+  BtorArgsIterator it1, it2;
+
+  btor_iter_args_init (&it1, args1);
+  btor_iter_args_init (&it2, args2);
+  while (btor_iter_args_has_next (&it1))
+  {
+    assert (btor_iter_args_has_next (&it2));
+    BTOR_PUSH_STACK (*lits,
+                     btor_exp_eq (btor,
+                                  btor_iter_args_next (&it1),
+                                  btor_iter_args_next (&it2)));
+  }
+  assert (!btor_iter_args_has_next (&it2));
+}
+
+static int32_t
+compare_lits_by_id (const void *p, const void *q)
+{
+  BtorNode *a = *(BtorNode **) p;
+  BtorNode *b = *(BtorNode **) q;
+  int32_t ida = btor_node_get_id (a);
+  int32_t idb = btor_node_get_id (b);
+  return ida < idb ? -1 : (ida > idb ? 1 : 0);
+}
+
+/* Removes duplicate premise literals and literals implied by the formula
+ * from 'lits' (--fun-lemma-min), the remaining literals are sorted by id. */
+static void
+minimize_premise_lits (Btor *btor, BtorNodePtrStack *lits)
+{
+  uint32_t i, j;
+  BtorNode *lit;
+  BtorFunSolver *slv;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  qsort (lits->start,
+         BTOR_COUNT_STACK (*lits),
+         sizeof (BtorNode *),
+         compare_lits_by_id);
+  for (i = 0, j = 0; i < BTOR_COUNT_STACK (*lits); i++)
+  {
+    lit = BTOR_PEEK_STACK (*lits, i);
+    if ((j > 0 && BTOR_PEEK_STACK (*lits, j - 1) == lit)
+        || is_implied_premise (btor, lit))
+    {
+      slv->stats.lemma_prems_dropped++;
+      btor_node_release (btor, lit);
+      continue;
+    }
+    BTOR_POKE_STACK (*lits, j, lit);
+    j++;
+  }
+  lits->top = lits->start + j;
+}
+
+/* Premise of a lemma in 'cur_lemmas' for subsumption checks
+ * (--fun-lemma-min). */
+struct BtorFunLemmaPremise
+{
+  BtorNode *lemma;
+  BtorNode *con;
+  uint32_t pos;     /* position in 'cur_lemma_prems' */
+  BtorIntStack ids; /* ids of premise literals, ascending */
+};
+
+typedef struct BtorFunLemmaPremise BtorFunLemmaPremise;
+
+static void
+add_lemma_premise (Btor *btor,
+                   BtorNode *lemma,
+                   BtorNode *con,
+                   BtorNodePtrStack *lits)
+{
+  uint32_t i;
+  BtorFunSolver *slv;
+  BtorFunLemmaPremise *p;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  BTOR_NEW (btor->mm, p);
+  p->lemma = lemma;
+  p->con   = con;
+  p->pos   = BTOR_COUNT_STACK (slv->cur_lemma_prems);
+  BTOR_INIT_STACK (btor->mm, p->ids);
+  for (i = 0; i < BTOR_COUNT_STACK (*lits); i++)
+    BTOR_PUSH_STACK (p->ids, btor_node_get_id (BTOR_PEEK_STACK (*lits, i)));
+  BTOR_PUSH_STACK (slv->cur_lemma_prems, p);
+}
+
+/* Returns true if the premise literals of 'p' are a subset of those of 'q'.
+ */
+static bool
+is_subset_lemma_premise (BtorFunLemmaPremise *p, BtorFunLemmaPremise *q)
+{
+  uint32_t i, j;
+
+  if (BTOR_COUNT_STACK (p->ids) > BTOR_COUNT_STACK (q->ids)) return false;
+  for (i = 0, j = 0; i < BTOR_COUNT_STACK (p->ids); i++, j++)
+  {
+    while (j < BTOR_COUNT_STACK (q->ids)
+           && BTOR_PEEK_STACK (q->ids, j) < BTOR_PEEK_STACK (p->ids, i))
+      j++;
+    if (j == BTOR_COUNT_STACK (q->ids)
+        || BTOR_PEEK_STACK (q->ids, j) != BTOR_PEEK_STACK (p->ids, i))
+      return false;
+  }
+  return true;
+}
 
-  start      = btor_util_time_stamp ();
-  mm         = btor->mm;
-  slv        = BTOR_FUN_SOLVER (btor);
-  cache_app1 = btor_hashint_table_new (mm);
-  cache_app2 = btor_hashint_table_new (mm);
+static int32_t
+compare_lemma_premises (const void *p, const void *q)
+{
+  BtorFunLemmaPremise *a = *(BtorFunLemmaPremise **) p;
+  BtorFunLemmaPremise *b = *(BtorFunLemmaPremise **) q;
+  int32_t ida = btor_node_get_id (a->con);
+  int32_t idb = btor_node_get_id (b->con);
+  if (ida != idb) return ida < idb ? -1 : 1;
+  return a->pos < b->pos ? -1 : (a->pos > b->pos ? 1 : 0);
+}
+
+/* Removes lemmas from 'cur_lemmas' that are subsumed by another lemma in
+ * 'cur_lemmas' with the same conclusion and a subset of its premise. */
+static void
+remove_subsumed_lemmas (Btor *btor)
+{
+  uint32_t i, j, k, n;
+  BtorFunSolver *slv;
+  BtorFunLemmaPremise *p, *q;
+  BtorPtrHashTable *subsumed;
+  BtorNode *lemma;
+
+  slv      = BTOR_FUN_SOLVER (btor);
+  n        = BTOR_COUNT_STACK (slv->cur_lemma_prems);
+  subsumed = btor_hashptr_table_new (btor->mm, 0, 0);
+
+  /* group lemmas by conclusion */
+  qsort (slv->cur_lemma_prems.start,
+         n,
+         sizeof (BtorFunLemmaPremise *),
+         compare_lemma_premises);
+  for (i = 0; i < n; i++)
+  {
+    p = BTOR_PEEK_STACK (slv->cur_lemma_prems, i);
+    for (j = i + 1; j < n; j++)
+    {
+      q = BTOR_PEEK_STACK (slv->cur_lemma_prems, j);
+      if (q->con != p->con) break;
+      if (btor_hashptr_table_get (subsumed, q->lemma)) continue;
+      if (is_subset_lemma_premise (p, q))
+        btor_hashptr_table_add (subsumed, q->lemma);
+      else if (is_subset_lemma_premise (q, p))
+      {
+        btor_hashptr_table_add (subsumed, p->lemma);
+        break;
+      }
+    }
+  }
+
+  for (i = 0, k = 0; i < BTOR_COUNT_STACK (slv->cur_lemmas); i++)
+  {
+    lemma = BTOR_PEEK_STACK (slv->cur_lemmas, i);
+    if (btor_hashptr_table_get (subsumed, lemma))
+    {
+      slv->stats.lemmas_subsumed++;
+      continue;
+    }
+    BTOR_POKE_STACK (slv->cur_lemmas, k, lemma);
+    k++;
+  }
+  slv->cur_lemmas.top = slv->cur_lemmas.start + k;
+  btor_hashptr_table_delete (subsumed);
+}
+
+static void
+reset_lemma_premises (BtorFunSolver *slv)
+{
+  BtorFunLemmaPremise *p;
+
+  while (!BTOR_EMPTY_STACK (slv->cur_lemma_prems))
+  {
+    p = BTOR_POP_STACK (slv->cur_lemma_prems);
+    BTOR_RELEASE_STACK (p->ids);
+    BTOR_DELETE (slv->btor->mm, p);
+  }
+}
+
+static void
+add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
+{
+  assert (btor);
+  assert (btor->slv);
+  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
+  assert (fun);
+  assert (btor_node_is_regular (fun));
+  assert (btor_node_is_fun (fun));
+  assert (!fun->parameterized);
+  assert (app1);
+  assert (btor_node_is_regular (app1));
+  assert (btor_node_is_apply (app1));
+  assert (!app2 || btor_node_is_regular (app2) || btor_node_is_apply (app2));
+
+  double start;
+  bool opt_lemma_min;
+  uint32_t i, lemma_size = 1;
+  BtorIntHashTable *cache_app1, *cache_app2;
+  BtorNodePtrStack prem_app1, prem_app2, prem, eqs;
+  BtorNode *value, *tmp, *and, *con, *lemma;
+  BtorMemMgr *mm;
+  BtorFunSolver *slv;
+
+  start         = btor_util_time_stamp ();
+  mm            = btor->mm;
+  slv           = BTOR_FUN_SOLVER (btor);
+  opt_lemma_min = btor_opt_get (btor, BTOR_OPT_FUN_LEMMA_MIN) != 0;
+  cache_app1    = btor_hashint_table_new (mm);
+  cache_app2    = btor_hashint_table_new (mm);
   BTOR_INIT_STACK (mm, prem_app1);
   BTOR_INIT_STACK (mm, prem_app2);
   BTOR_INIT_STACK (mm, prem);
+  BTOR_INIT_STACK (mm, eqs);
 
-  /* collect premise and conclusion */
+  /* collect premise and conclusion, with --fun-lemma-min 'prem' collects
+   * the literals of the premise rather than conjunctions and 'eqs' the
+   * argument equalities of the conflicting applies */
 
   collect_premisses (btor, app1, fun, app1->e[1], &prem_app1, cache_app1);
-  tmp = mk_premise (
-      btor, app1->e[1], prem_app1.start, BTOR_COUNT_STACK (prem_app1));
-
-  BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+  if (opt_lemma_min)
+    push_premise_lits (btor,
+                       app1->e[1],
+                       prem_app1.start,
+                       BTOR_COUNT_STACK (prem_app1),
+                       &prem);
+  else
+  {
+    tmp = mk_premise (
+        btor, app1->e[1], prem_app1.start, BTOR_COUNT_STACK (prem_app1));
+    BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+  }
   lemma_size += BTOR_COUNT_STACK (prem_app1);
 
   if (app2) /* function congruence axiom conflict */
   {
     collect_premisses (btor, app2, fun, app2->e[1], &prem_app2, cache_app2);
-    tmp = mk_premise (
-        btor, app2->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
-
-    BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
-    BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], app2->e[1]));
+    if (opt_lemma_min)
+    {
+      push_premise_lits (btor,
+                         app2->e[1],
+                         prem_app2.start,
+                         BTOR_COUNT_STACK (prem_app2),
+                         &prem);
+      push_equal_args_lits (btor, app1->e[1], app2->e[1], &eqs);
+    }
+    else
+    {
+      tmp = mk_premise (
+          btor, app2->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
+      BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+      BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], app2->e[1]));
+    }
     lemma_size += BTOR_COUNT_STACK (prem_app2);
     con = btor_exp_eq (btor, app1, app2);
   }
   else if (btor_node_is_update (fun)) /* read over write conflict */
   {
-    BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], fun->e[1]));
+    if (opt_lemma_min)
+      push_equal_args_lits (btor, app1->e[1], fun->e[1], &eqs);
+    else
+      BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], fun->e[1]));
     lemma_size += btor_node_args_get_arity (btor, app1->e[1]);
     con = btor_exp_eq (btor, app1, fun->e[2]);
   }
@@ -1490,24 +2062,46 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
                        &prem_app2,
                        cache_app2);
 
-    tmp = mk_premise (
-        btor, app1->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
-
-    BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+    if (opt_lemma_min)
+      push_premise_lits (btor,
+                         app1->e[1],
+                         prem_app2.start,
+                         BTOR_COUNT_STACK (prem_app2),
+                         &prem);
+    else
+    {
+      tmp = mk_premise (
+          btor, app1->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
+      BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+    }
     lemma_size += BTOR_COUNT_STACK (prem_app2);
     con = btor_exp_eq (btor, app1, value);
     btor_node_release (btor, value);
   }
 
+  if (opt_lemma_min)
+  {
+    minimize_premise_lits (btor, &prem);
+    minimize_premise_lits (btor, &eqs);
+    /* argument equalities of congruence lemmas are not counted (as above) */
+    lemma_size = BTOR_COUNT_STACK (prem) + 1;
+    if (!app2) lemma_size += BTOR_COUNT_STACK (eqs);
+    while (!BTOR_EMPTY_STACK (eqs))
+      BTOR_PUSH_STACK (prem, BTOR_POP_STACK (eqs));
+    qsort (prem.start,
+           BTOR_COUNT_STACK (prem),
+           sizeof (BtorNode *),
+           compare_lits_by_id);
+  }
+
   /* create lemma */
   if (BTOR_EMPTY_STACK (prem))
-    lemma = con;
+    lemma = btor_node_copy (btor, con);
   else
   {
     and   = btor_exp_bv_and_n (btor, prem.start, BTOR_COUNT_STACK (prem));
     lemma = btor_exp_implies (btor, and, con);
     btor_node_release (btor, and);
-    btor_node_release (btor, con);
   }
 
   assert (lemma != btor->true_exp);
@@ -1515,6 +2109,7 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   {
     btor_hashptr_table_add (slv->lemmas, btor_node_copy (btor, lemma));
     BTOR_PUSH_STACK (slv->cur_lemmas, lemma);
+    if (opt_lemma_min) add_lemma_premise (btor, lemma, con, &prem);
     slv->stats.lod_refinements++;
     slv->stats.lemmas_size_sum += lemma_size;
     if (lemma_size >= BTOR_SIZE_STACK (slv->stats.lemmas_size))
@@ -1522,6 +2117,7 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
     slv->stats.lemmas_size.start[lemma_size] += 1;
   }
   btor_node_release (btor, lemma);
+  btor_node_release (btor, con);
 
   /* cleanup */
   for (i = 0; i < BTOR_COUNT_STACK (prem); i++)
@@ -1533,6 +2129,7 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   BTOR_RELEASE_STACK (prem_app1);
   BTOR_RELEASE_STACK (prem_app2);
   BTOR_RELEASE_STACK (prem);
+  BTOR_RELEASE_STACK (eqs);
   btor_hashint_table_delete (cache_app1);
   btor_hashint_table_delete (cache_app2);
   BTOR_FUN_SOLVER (btor)->time.lemma_gen += btor_util_time_stamp () - start;
@@ -1633,6 +2230,612 @@ find_conflict_app (Btor *btor, BtorNode *app, BtorIntHashTable *conf_apps)
   return res;
 }
 
+/*------------------------------------------------------------------------*/
+
+/* Propagation chain of an apply, i.e., the functions it was added to the rho
+ * tables of, together with the nodes whose assignments determined the chain
+ * and the nodes that were pushed for propagation along the way. If none of
+ * these assignments changed in the next refinement round, the chain is
+ * replayed instead of propagating the apply from scratch (--fun-inc-check).
+ */
+struct BtorFunAppChain
+{
+  BtorNode *app;
+  uint32_t round; /* refinement round the chain was last used in */
+  bool complete;  /* propagated until the end without conflict */
+  BtorNodePtrStack funs;
+  BtorNodePtrStack push;
+  BtorNodePtrStack deps;
+  BtorBitVectorPtrStack vals; /* assignments of 'deps' */
+};
+
+typedef struct BtorFunAppChain BtorFunAppChain;
+
+static void
+reset_app_chain (Btor *btor, BtorFunAppChain *chain)
+{
+  while (!BTOR_EMPTY_STACK (chain->funs))
+    btor_node_release (btor, BTOR_POP_STACK (chain->funs));
+  while (!BTOR_EMPTY_STACK (chain->push))
+    btor_node_release (btor, BTOR_POP_STACK (chain->push));
+  while (!BTOR_EMPTY_STACK (chain->deps))
+    btor_node_release (btor, BTOR_POP_STACK (chain->deps));
+  while (!BTOR_EMPTY_STACK (chain->vals))
+    btor_bv_free (btor->mm, BTOR_POP_STACK (chain->vals));
+  chain->complete = false;
+}
+
+static BtorFunAppChain *
+get_app_chain (Btor *btor, BtorNode *app)
+{
+  BtorFunSolver *slv;
+  BtorFunAppChain *res;
+  BtorHashTableData *d;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  if ((d = btor_hashint_map_get (slv->app_chains, app->id)))
+    return (BtorFunAppChain *) d->as_ptr;
+
+  BTOR_CNEW (btor->mm, res);
+  res->app   = btor_node_copy (btor, app);
+  res->round = slv->app_chains_round - 1;
+  BTOR_INIT_STACK (btor->mm, res->funs);
+  BTOR_INIT_STACK (btor->mm, res->push);
+  BTOR_INIT_STACK (btor->mm, res->deps);
+  BTOR_INIT_STACK (btor->mm, res->vals);
+  btor_hashint_map_add (slv->app_chains, app->id)->as_ptr = res;
+  return res;
+}
+
+static void
+delete_app_chains (BtorFunSolver *slv)
+{
+  Btor *btor;
+  BtorFunAppChain *chain;
+  BtorIntHashTableIterator it;
+
+  btor = slv->btor;
+  btor_iter_hashint_init (&it, slv->app_chains);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    chain = btor_iter_hashint_next_data (&it)->as_ptr;
+    reset_app_chain (btor, chain);
+    btor_node_release (btor, chain->app);
+    BTOR_RELEASE_STACK (chain->funs);
+    BTOR_RELEASE_STACK (chain->push);
+    BTOR_RELEASE_STACK (chain->deps);
+    BTOR_RELEASE_STACK (chain->vals);
+    BTOR_DELETE (btor->mm, chain);
+  }
+  btor_hashint_map_delete (slv->app_chains);
+  slv->app_chains = 0;
+}
+
+static void
+add_dep_app_chain (Btor *btor, BtorFunAppChain *chain, BtorNode *exp)
+{
+  BTOR_PUSH_STACK (chain->deps, btor_node_copy (btor, exp));
+  BTOR_PUSH_STACK (chain->vals, get_bv_assignment (btor, exp));
+}
+
+static void
+add_args_deps_app_chain (Btor *btor, BtorFunAppChain *chain, BtorNode *args)
+{
+  BtorArgsIterator it;
+
+  btor_iter_args_init (&it, args);
+  while (btor_iter_args_has_next (&it))
+    add_dep_app_chain (btor, chain, btor_iter_args_next (&it));
+}
+
+static void
+add_push_app_chain (Btor *btor, BtorFunAppChain *chain, BtorNode *exp)
+{
+  BTOR_PUSH_STACK (chain->push, btor_node_copy (btor, exp));
+}
+
+/* Checks if the assignments the chain depends on are unchanged. */
+static bool
+is_valid_app_chain (Btor *btor, BtorFunAppChain *chain)
+{
+  bool res;
+  uint32_t i;
+  BtorBitVector *bv;
+
+  if (!chain->complete) return false;
+  for (i = 0, res = true; res && i < BTOR_COUNT_STACK (chain->deps); i++)
+  {
+    bv  = get_bv_assignment (btor, BTOR_PEEK_STACK (chain->deps, i));
+    res = btor_bv_compare (bv, BTOR_PEEK_STACK (chain->vals, i)) == 0;
+    btor_bv_free (btor->mm, bv);
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Segment of a store chain, i.e., a sequence of updates where each update is
+ * the array of its predecessor. Updates are numbered consecutively per
+ * refinement round, 'indices' maps the interned assignment of an update index
+ * to the ascending positions of the updates with that index assignment. A
+ * segment ends at the base array of the chain or continues in the segment of
+ * an update that was indexed earlier (chains sharing a common suffix).
+ */
+struct BtorFunStoreChain
+{
+  int32_t start; /* position of first update */
+  BtorNodePtrStack updates;
+  BtorPtrHashTable *indices;
+  int32_t next; /* position of continuation, -1 if 'base' is reached */
+  BtorNode *base;
+  uint32_t depth; /* number of updates below this segment */
+};
+
+typedef struct BtorFunStoreChain BtorFunStoreChain;
+
+static void
+delete_store_chains (BtorFunSolver *slv)
+{
+  uint32_t i;
+  BtorMemMgr *mm;
+  BtorFunStoreChain *seg;
+  BtorUIntStack *positions;
+  BtorPtrHashTableIterator it;
+
+  mm = slv->btor->mm;
+  /* segments occupy consecutive positions */
+  for (i = 0; i < BTOR_COUNT_STACK (slv->store_chain_segs);)
+  {
+    seg = BTOR_PEEK_STACK (slv->store_chain_segs, i);
+    assert ((uint32_t) seg->start == i);
+    i += BTOR_COUNT_STACK (seg->updates);
+    btor_iter_hashptr_init (&it, seg->indices);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      positions = it.bucket->data.as_ptr;
+      (void) btor_iter_hashptr_next (&it);
+      BTOR_RELEASE_STACK (*positions);
+      BTOR_DELETE (mm, positions);
+    }
+    btor_hashptr_table_delete (seg->indices);
+    BTOR_RELEASE_STACK (seg->updates);
+    BTOR_DELETE (mm, seg);
+  }
+  BTOR_RELEASE_STACK (slv->store_chain_segs);
+  btor_hashint_map_delete (slv->store_chains);
+  slv->store_chains = 0;
+}
+
+/* Returns the position of 'update', indexes the store chain below 'update'
+ * if it was not indexed yet in the current refinement round. */
+static int32_t
+get_store_chain_pos (Btor *btor,
+                     BtorNode *update,
+                     BtorNodePtrStack *prop_stack,
+                     BtorIntHashTable *apply_search_cache)
+{
+  assert (btor_node_is_regular (update));
+  assert (btor_node_is_update (update));
+
+  int32_t pos;
+  BtorMemMgr *mm;
+  BtorFunSolver *slv;
+  BtorFunStoreChain *seg, *next;
+  BtorFunArgsAssignment *a;
+  BtorNode *cur;
+  BtorPtrHashBucket *b;
+  BtorUIntStack *positions;
+  BtorHashTableData *d;
+
+  mm  = btor->mm;
+  slv = BTOR_FUN_SOLVER (btor);
+
+  if ((d = btor_hashint_map_get (slv->store_chains, update->id)))
+    return d->as_int;
+
+  BTOR_CNEW (mm, seg);
+  seg->start = BTOR_COUNT_STACK (slv->store_chain_segs);
+  seg->next  = -1;
+  BTOR_INIT_STACK (mm, seg->updates);
+  seg->indices = btor_hashptr_table_new (mm, 0, 0);
+
+  cur = update;
+  while (btor_node_is_update (cur) && !cur->parameterized)
+  {
+    if ((d = btor_hashint_map_get (slv->store_chains, cur->id)))
+    {
+      seg->next = d->as_int;
+      break;
+    }
+    pos = BTOR_COUNT_STACK (slv->store_chain_segs);
+    BTOR_PUSH_STACK (slv->store_chain_segs, seg);
+    BTOR_PUSH_STACK (seg->updates, cur);
+    btor_hashint_map_add (slv->store_chains, cur->id)->as_int = pos;
+
+    a = get_args_assignment (btor, cur->e[1]);
+    assert (a);
+    if (!(b = btor_hashptr_table_get (seg->indices, a)))
+    {
+      BTOR_NEW (mm, positions);
+      BTOR_INIT_STACK (mm, *positions);
+      btor_hashptr_table_add (seg->indices, a)->data.as_ptr = positions;
+    }
+    else
+      positions = b->data.as_ptr;
+    BTOR_PUSH_STACK (*positions, pos);
+
+    /* reads may skip this update based on the assignment of its index */
+    push_applies_for_propagation (
+        btor, cur->e[1], prop_stack, apply_search_cache);
+    push_applies_for_propagation (
+        btor, cur->e[2], prop_stack, apply_search_cache);
+    cur = btor_node_get_simplified (btor, cur->e[0]);
+  }
+
+  if (seg->next >= 0)
+  {
+    next       = BTOR_PEEK_STACK (slv->store_chain_segs, seg->next);
+    seg->depth = next->depth + next->start
+                 + BTOR_COUNT_STACK (next->updates) - seg->next;
+  }
+  else
+  {
+    seg->base  = cur;
+    seg->depth = 0;
+  }
+  return seg->start;
+}
+
+/* Returns the first function in the store chain starting at 'update' that
+ * needs to be visited by a read with arguments 'args', i.e., the first update
+ * with an index assignment equal to the assignment of 'args' or the base
+ * array of the chain. Updates with other indices are skipped. */
+static BtorNode *
+find_store_chain (Btor *btor,
+                  BtorNode *update,
+                  BtorNode *args,
+                  BtorNodePtrStack *prop_stack,
+                  BtorIntHashTable *apply_search_cache)
+{
+  int32_t pos;
+  uint32_t lo, hi, mid, start_depth;
+  BtorFunSolver *slv;
+  BtorFunStoreChain *seg;
+  BtorFunArgsAssignment *a;
+  BtorPtrHashBucket *b;
+  BtorUIntStack *positions;
+  BtorNode *res;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  a   = get_args_assignment (btor, args);
+  assert (a);
+
+  pos = get_store_chain_pos (btor, update, prop_stack, apply_search_cache);
+  seg         = BTOR_PEEK_STACK (slv->store_chain_segs, pos);
+  start_depth = seg->depth + seg->start + BTOR_COUNT_STACK (seg->updates) - pos;
+  res         = 0;
+  for (;;)
+  {
+    seg = BTOR_PEEK_STACK (slv->store_chain_segs, pos);
+    if ((b = btor_hashptr_table_get (seg->indices, a)))
+    {
+      /* first position >= 'pos' */
+      positions = b->data.as_ptr;
+      lo        = 0;
+      hi        = BTOR_COUNT_STACK (*positions);
+      while (lo < hi)
+      {
+        mid = lo + (hi - lo) / 2;
+        if (BTOR_PEEK_STACK (*positions, mid) < (uint32_t) pos)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      if (lo < BTOR_COUNT_STACK (*positions))
+      {
+        pos = BTOR_PEEK_STACK (*positions, lo);
+        res = BTOR_PEEK_STACK (seg->updates, pos - seg->start);
+        slv->stats.store_chain_skips +=
+            start_depth
+            - (seg->depth + seg->start + BTOR_COUNT_STACK (seg->updates)
+               - pos);
+        break;
+      }
+    }
+    if (seg->next < 0)
+    {
+      res = seg->base;
+      slv->stats.store_chain_skips += start_depth;
+      break;
+    }
+    pos = seg->next;
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Result of the partial beta reduction of a lambda w.r.t. an args node, and
+ * the conditions (with their values) that were evaluated to reach it. The
+ * result can be reused as long as the values of these conditions do not
+ * change, since they determine the path taken through the lambda body. */
+struct BtorFunBetaResult
+{
+  BtorNode *args;
+  BtorNode *result;
+  BtorNodePtrStack conds;
+  BtorCharStack vals;
+};
+
+typedef struct BtorFunBetaResult BtorFunBetaResult;
+
+struct BtorFunBetaCache
+{
+  BtorNode *lambda;
+  BtorIntHashTable *results; /* maps args ids to BtorFunBetaResult */
+};
+
+typedef struct BtorFunBetaCache BtorFunBetaCache;
+
+static void
+delete_betap_result (Btor *btor, BtorFunBetaResult *r)
+{
+  while (!BTOR_EMPTY_STACK (r->conds))
+    btor_node_release (btor, BTOR_POP_STACK (r->conds));
+  BTOR_RELEASE_STACK (r->conds);
+  BTOR_RELEASE_STACK (r->vals);
+  btor_node_release (btor, r->args);
+  btor_node_release (btor, r->result);
+  BTOR_DELETE (btor->mm, r);
+}
+
+static bool
+is_valid_betap_result (BtorFunBetaResult *r)
+{
+  uint32_t i;
+
+  if (btor_node_is_simplified (r->args)
+      || btor_node_is_simplified (btor_node_real_addr (r->result)))
+    return false;
+  for (i = 0; i < BTOR_COUNT_STACK (r->conds); i++)
+    if (btor_node_is_simplified (BTOR_PEEK_STACK (r->conds, i))) return false;
+  return true;
+}
+
+/* Deletes cached results of lambdas that were simplified (i.e., their body
+ * changed) or that depend on simplified nodes. Deletes all results and the
+ * cache itself if 'all' is true. */
+static void
+prune_betap_cache (Btor *btor, bool all)
+{
+  size_t i, j;
+  BtorHashTableData d;
+  BtorFunSolver *slv;
+  BtorFunBetaCache *c;
+  BtorFunBetaResult *r;
+  BtorIntStack stale_lambdas, stale_args;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  if (!slv->betap_cache) return;
+
+  BTOR_INIT_STACK (btor->mm, stale_lambdas);
+  BTOR_INIT_STACK (btor->mm, stale_args);
+  for (i = 0; i < slv->betap_cache->size; i++)
+  {
+    if (!slv->betap_cache->keys[i]) continue;
+    c = slv->betap_cache->data[i].as_ptr;
+    for (j = 0; j < c->results->size; j++)
+    {
+      if (!c->results->keys[j]) continue;
+      r = c->results->data[j].as_ptr;
+      if (!all && !btor_node_is_simplified (c->lambda)
+          && is_valid_betap_result (r))
+        continue;
+      BTOR_PUSH_STACK (stale_args, c->results->keys[j]);
+    }
+    while (!BTOR_EMPTY_STACK (stale_args))
+    {
+      btor_hashint_map_remove (c->results, BTOR_POP_STACK (stale_args), &d);
+      delete_betap_result (btor, d.as_ptr);
+    }
+    if (c->results->count == 0)
+      BTOR_PUSH_STACK (stale_lambdas, slv->betap_cache->keys[i]);
+  }
+  while (!BTOR_EMPTY_STACK (stale_lambdas))
+  {
+    btor_hashint_map_remove (
+        slv->betap_cache, BTOR_POP_STACK (stale_lambdas), &d);
+    c = d.as_ptr;
+    btor_hashint_map_delete (c->results);
+    btor_node_release (btor, c->lambda);
+    BTOR_DELETE (btor->mm, c);
+  }
+  BTOR_RELEASE_STACK (stale_lambdas);
+  BTOR_RELEASE_STACK (stale_args);
+
+  if (all)
+  {
+    assert (slv->betap_cache->count == 0);
+    btor_hashint_map_delete (slv->betap_cache);
+    slv->betap_cache = 0;
+  }
+}
+
+/* Partially beta reduces 'lambda' w.r.t. 'args' and collects the evaluated
+ * conditions in 'conds'. If enabled, results are cached and reused as long
+ * as the evaluated conditions keep their values. */
+static BtorNode *
+betap_reduce_cached (Btor *btor,
+                     BtorNode *lambda,
+                     BtorNode *args,
+                     BtorPtrHashTable *conds)
+{
+  uint32_t i;
+  bool valid;
+  BtorMemMgr *mm;
+  BtorFunSolver *slv;
+  BtorFunBetaCache *c;
+  BtorFunBetaResult *r;
+  BtorHashTableData *d;
+  BtorBitVector *bv;
+  BtorNode *cond, *res;
+  BtorPtrHashTableIterator it;
+
+  mm  = btor->mm;
+  slv = BTOR_FUN_SOLVER (btor);
+
+  if (!slv->betap_cache)
+  {
+    btor_beta_assign_args (btor, lambda, args);
+    res = btor_beta_reduce_partial (btor, lambda, conds);
+    btor_beta_unassign_params (btor, lambda);
+    return res;
+  }
+
+  c = 0;
+  r = 0;
+  if ((d = btor_hashint_map_get (slv->betap_cache, lambda->id)))
+  {
+    c = d->as_ptr;
+    if ((d = btor_hashint_map_get (c->results, args->id))) r = d->as_ptr;
+  }
+
+  if (r)
+  {
+    valid = is_valid_betap_result (r);
+    for (i = 0; valid && i < BTOR_COUNT_STACK (r->conds); i++)
+    {
+      bv    = btor_eval_exp (btor, BTOR_PEEK_STACK (r->conds, i));
+      valid = btor_bv_is_true (bv) == BTOR_PEEK_STACK (r->vals, i);
+      btor_bv_free (mm, bv);
+    }
+    if (valid)
+    {
+      slv->stats.betap_cache_hits++;
+      for (i = 0; i < BTOR_COUNT_STACK (r->conds); i++)
+      {
+        cond = BTOR_PEEK_STACK (r->conds, i);
+        if (!btor_hashptr_table_get (conds, cond))
+          btor_hashptr_table_add (conds, btor_node_copy (btor, cond));
+      }
+      return btor_node_copy (btor, r->result);
+    }
+    btor_hashint_map_remove (c->results, args->id, 0);
+    delete_betap_result (btor, r);
+  }
+  slv->stats.betap_cache_misses++;
+
+  btor_beta_assign_args (btor, lambda, args);
+  res = btor_beta_reduce_partial (btor, lambda, conds);
+  btor_beta_unassign_params (btor, lambda);
+
+  if (!c)
+  {
+    BTOR_NEW (mm, c);
+    c->lambda  = btor_node_copy (btor, lambda);
+    c->results = btor_hashint_map_new (mm);
+    btor_hashint_map_add (slv->betap_cache, lambda->id)->as_ptr = c;
+  }
+  BTOR_NEW (mm, r);
+  r->args   = btor_node_copy (btor, args);
+  r->result = btor_node_copy (btor, res);
+  BTOR_INIT_STACK (mm, r->conds);
+  BTOR_INIT_STACK (mm, r->vals);
+  btor_iter_hashptr_init (&it, conds);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cond = btor_iter_hashptr_next (&it);
+    bv   = btor_eval_exp (btor, cond);
+    BTOR_PUSH_STACK (r->conds, btor_node_copy (btor, cond));
+    BTOR_PUSH_STACK (r->vals, btor_bv_is_true (bv));
+    btor_bv_free (mm, bv);
+  }
+  btor_hashint_map_add (c->results, args->id)->as_ptr = r;
+  return res;
+}
+
+static bool
+add_congruence_lemma (Btor *btor,
+                      BtorNode *fun,
+                      BtorNode *hashed_app,
+                      BtorNode *app,
+                      BtorIntHashTable *conf_apps)
+{
+  bool restart;
+  uint32_t opt_eager_lemmas;
+
+  restart          = true;
+  opt_eager_lemmas = btor_opt_get (btor, BTOR_OPT_FUN_EAGER_LEMMAS);
+
+  BTORLOG (1, "\e[1;31m");
+  BTORLOG (1, "FC conflict at: %s", btor_util_node2string (fun));
+  BTORLOG (1, "add_lemma:");
+  BTORLOG (1, "  fun: %s", btor_util_node2string (fun));
+  BTORLOG (1, "  app1: %s", btor_util_node2string (hashed_app));
+  BTORLOG (1, "  app2: %s", btor_util_node2string (app));
+  BTORLOG (1, "\e[0;39m");
+  if (opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_CONF)
+  {
+    btor_hashint_table_add (conf_apps, app->id);
+    restart = find_conflict_app (btor, app, conf_apps);
+  }
+  else if (opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_ALL)
+    restart = false;
+  BTOR_FUN_SOLVER (btor)->stats.function_congruence_conflicts++;
+  add_lemma (btor, fun, hashed_app, app);
+  return restart;
+}
+
+/* Replays the propagation chain of 'app' recorded in a previous refinement
+ * round. Only function congruence has to be checked since all other checks
+ * along the chain depend on unchanged assignments. Returns true if
+ * propagation has to be stopped due to a conflict. */
+static bool
+replay_app_chain (Btor *btor,
+                  BtorFunAppChain *chain,
+                  BtorNodePtrStack *prop_stack,
+                  BtorPtrHashTable *cleanup_table,
+                  BtorIntHashTable *apply_search_cache,
+                  BtorIntHashTable *conf_apps)
+{
+  uint32_t i;
+  BtorNode *app, *args, *fun, *hashed_app;
+  BtorPtrHashBucket *b;
+
+  app  = chain->app;
+  args = btor_node_get_simplified (btor, app->e[1]);
+
+  BTORLOG (1, "  replay: %s", btor_util_node2string (app));
+  for (i = 0; i < BTOR_COUNT_STACK (chain->funs); i++)
+  {
+    fun = BTOR_PEEK_STACK (chain->funs, i);
+    if (!fun->rho)
+    {
+      fun->rho = btor_hashptr_table_new (btor->mm,
+                                         (BtorHashPtr) hash_args_assignment,
+                                         (BtorCmpPtr) compare_args_assignments);
+      if (!btor_hashptr_table_get (cleanup_table, fun))
+        btor_hashptr_table_add (cleanup_table, fun);
+    }
+    else if ((b = btor_hashptr_table_get (fun->rho, args)))
+    {
+      hashed_app = (BtorNode *) b->data.as_ptr;
+      if (hashed_app == app) continue;
+      /* 'hashed_app' continues the chain from here on */
+      chain->complete = false;
+      if (!equal_bv_assignments (hashed_app, app))
+        return add_congruence_lemma (btor, fun, hashed_app, app, conf_apps);
+      break;
+    }
+    btor_hashptr_table_add (fun->rho, args)->data.as_ptr = app;
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (chain->push); i++)
+    push_applies_for_propagation (
+        btor, BTOR_PEEK_STACK (chain->push, i), prop_stack, apply_search_cache);
+  return false;
+}
+
 static void
 propagate (Btor *btor,
            BtorNodePtrStack *prop_stack,
@@ -1658,6 +2861,7 @@ propagate (Btor *btor,
   BtorPtrHashTableIterator it;
   BtorPtrHashTable *conds;
   BtorIntHashTable *conf_apps;
+  BtorFunAppChain *chain;
 
   start            = btor_util_time_stamp ();
   mm               = btor->mm;
@@ -1700,6 +2904,37 @@ propagate (Btor *btor,
     args = btor_node_get_simplified (btor, args);
     assert (btor_node_is_args (args));
 
+    chain = 0;
+    /* reads skipping updates via index sets are not recorded */
+    if (slv->app_chains && !slv->store_chains)
+    {
+      chain = get_app_chain (btor, app);
+      /* first visit of 'app' in this round */
+      if (chain->round != slv->app_chains_round)
+      {
+        chain->round = slv->app_chains_round;
+        if (BTOR_COUNT_STACK (chain->funs) > 0
+            && BTOR_PEEK_STACK (chain->funs, 0) == fun
+            && is_valid_app_chain (btor, chain))
+        {
+          slv->stats.apps_replayed++;
+          if (replay_app_chain (btor,
+                                chain,
+                                prop_stack,
+                                cleanup_table,
+                                apply_search_cache,
+                                conf_apps))
+            break;
+          continue;
+        }
+        slv->stats.apps_rechecked++;
+        reset_app_chain (btor, chain);
+        add_dep_app_chain (btor, chain, app);
+        add_args_deps_app_chain (btor, chain, args);
+        add_push_app_chain (btor, chain, args);
+      }
+    }
+
     push_applies_for_propagation (btor, args, prop_stack, apply_search_cache);
 
     if (!fun->rho)
@@ -1719,25 +2954,13 @@ propagate (Btor *btor,
         assert (btor_node_is_regular (hashed_app));
         assert (btor_node_is_apply (hashed_app));
 
+        if (chain && hashed_app != app) chain->complete = false;
+
         /* function congruence conflict */
         if (!equal_bv_assignments (hashed_app, app))
         {
-          BTORLOG (1, "\e[1;31m");
-          BTORLOG (1, "FC conflict at: %s", btor_util_node2string (fun));
-          BTORLOG (1, "add_lemma:");
-          BTORLOG (1, "  fun: %s", btor_util_node2string (fun));
-          BTORLOG (1, "  app1: %s", btor_util_node2string (hashed_app));
-          BTORLOG (1, "  app2: %s", btor_util_node2string (app));
-          BTORLOG (1, "\e[0;39m");
-          if (opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_CONF)
-          {
-            btor_hashint_table_add (conf_apps, app->id);
-            restart = find_conflict_app (btor, app, conf_apps);
-          }
-          else if (opt_eager_lemmas == BTOR_FUN_EAGER_LEMMAS_ALL)
-            restart = false;
-          slv->stats.function_congruence_conflicts++;
-          add_lemma (btor, fun, hashed_app, app);
+          restart =
+              add_congruence_lemma (btor, fun, hashed_app, app, conf_apps);
           // conflict = true;
           /* stop at first conflict */
           if (restart) break;
@@ -1752,15 +2975,25 @@ propagate (Btor *btor,
              "  save app: %s (%s)",
              btor_util_node2string (args),
              btor_util_node2string (app));
+    if (chain) BTOR_PUSH_STACK (chain->funs, btor_node_copy (btor, fun));
 
     /* skip array vars/uf */
-    if (btor_node_is_uf (fun)) continue;
+    if (btor_node_is_uf (fun))
+    {
+      if (chain) chain->complete = true;
+      continue;
+    }
 
     if (btor_node_is_fun_cond (fun))
     {
       push_applies_for_propagation (
           btor, fun->e[0], prop_stack, apply_search_cache);
       bv = get_bv_assignment (btor, fun->e[0]);
+      if (chain)
+      {
+        add_dep_app_chain (btor, chain, fun->e[0]);
+        add_push_app_chain (btor, chain, fun->e[0]);
+      }
 
       /* propagate over function ite */
       BTORLOG (1, "  propagate down: %s", btor_util_node2string (app));
@@ -1775,6 +3008,13 @@ propagate (Btor *btor,
     }
     else if (btor_node_is_update (fun))
     {
+      if (chain)
+      {
+        add_args_deps_app_chain (btor, chain, fun->e[1]);
+        add_dep_app_chain (btor, chain, fun->e[2]);
+        add_push_app_chain (btor, chain, fun->e[1]);
+        add_push_app_chain (btor, chain, fun->e[2]);
+      }
       if (compare_args_assignments (fun->e[1], args) == 0)
       {
         if (!equal_bv_assignments (app, fun->e[2]))
@@ -1798,6 +3038,7 @@ propagate (Btor *btor,
           slv->stats.beta_reduction_conflicts++;
           add_lemma (btor, fun, app, 0);
           conflict = true;
+          if (chain) chain->complete = false;
 
 #if 0
 		  /* stop at first conflict */
@@ -1805,12 +3046,19 @@ propagate (Btor *btor,
 		    break;
 #endif
         }
+        else if (chain)
+          chain->complete = true;
       }
       else
       {
+        cur = btor_node_get_simplified (btor, fun->e[0]);
+        if (slv->store_chains && btor_node_is_update (cur)
+            && !cur->parameterized)
+          cur = find_store_chain (
+              btor, cur, args, prop_stack, apply_search_cache);
         app->propagated = 0;
         BTOR_PUSH_STACK (*prop_stack, app);
-        BTOR_PUSH_STACK (*prop_stack, fun->e[0]);
+        BTOR_PUSH_STACK (*prop_stack, cur);
         slv->stats.propagations_down++;
       }
       push_applies_for_propagation (
@@ -1824,15 +3072,30 @@ propagate (Btor *btor,
     conds = btor_hashptr_table_new (mm,
                                     (BtorHashPtr) btor_node_hash_by_id,
                                     (BtorCmpPtr) btor_node_compare_by_id);
-    btor_beta_assign_args (btor, fun, args);
-    fun_value = btor_beta_reduce_partial (btor, fun, conds);
+    fun_value = betap_reduce_cached (btor, fun, args, conds);
     assert (!btor_node_is_fun (fun_value));
-    btor_beta_unassign_params (btor, fun);
 
     prop_down = false;
     if (!btor_node_is_inverted (fun_value) && btor_node_is_apply (fun_value))
       prop_down = fun_value->e[1] == args;
 
+    if (chain)
+    {
+      btor_iter_hashptr_init (&it, conds);
+      while (btor_iter_hashptr_has_next (&it))
+      {
+        cur = btor_iter_hashptr_next (&it);
+        add_dep_app_chain (btor, chain, cur);
+        add_push_app_chain (btor, chain, cur);
+      }
+      if (!prop_down)
+      {
+        add_dep_app_chain (btor, chain, fun_value);
+        add_push_app_chain (btor, chain, fun_value);
+        chain->complete = true;
+      }
+    }
+
     if (prop_down)
     {
       assert (btor_node_is_apply (fun_value));
@@ -1860,6 +3123,7 @@ propagate (Btor *btor,
       slv->stats.beta_reduction_conflicts++;
       add_lemma (btor, fun, app, 0);
       conflict = true;
+      if (chain) chain->complete = false;
     }
 
     /* we have a conflict and the values are inconsistent, we do not have
@@ -2264,6 +3528,14 @@ check_and_resolve_conflicts (Btor *btor,
   /* initialize new bit vector model, which will be constructed while
    * consistency checking. this also deletes the model from the previous run */
   btor_model_init_bv (btor, &btor->bv_model);
+  init_args_assignments (slv);
+  if (btor_opt_get (btor, BTOR_OPT_FUN_STORE_CHAINS))
+  {
+    slv->store_chains = btor_hashint_map_new (mm);
+    BTOR_INIT_STACK (mm, slv->store_chain_segs);
+  }
+
+  if (slv->app_chains) slv->app_chains_round++;
 
   BTOR_INIT_STACK (mm, prop_stack);
   BTOR_INIT_STACK (mm, top_applies);
@@ -2291,6 +3563,11 @@ check_and_resolve_conflicts (Btor *btor,
         btor, clone, clone_root, exp_map, &top_applies);
     init_apps = &top_applies;
   }
+  else if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP_AIG))
+  {
+    search_initial_applies_dual_prop_aig (btor, &top_applies);
+    init_apps = &top_applies;
+  }
   else if (btor_opt_get (btor, BTOR_OPT_FUN_JUST))
   {
     search_initial_applies_just (btor, &top_applies);
@@ -2387,6 +3664,8 @@ check_and_resolve_conflicts (Btor *btor,
   BTOR_RELEASE_STACK (prop_stack);
   BTOR_RELEASE_STACK (top_applies);
   btor_hashint_table_delete (apply_search_cache);
+  if (slv->store_chains) delete_store_chains (slv);
+  delete_args_assignments (slv);
   slv->time.check_consistency += btor_util_time_stamp () - start;
 }
 
@@ -2493,6 +3772,16 @@ sat_fun_solver (BtorFunSolver *slv)
 
   if (btor->feqs->count > 0) add_function_inequality_constraints (btor);
 
+  if (btor_opt_get (btor, BTOR_OPT_FUN_INC_CHECK))
+    slv->app_chains = btor_hashint_map_new (btor->mm);
+
+  if (!btor_opt_get (btor, BTOR_OPT_FUN_BETAP_CACHE))
+    prune_betap_cache (btor, true);
+  else if (!slv->betap_cache)
+    slv->betap_cache = btor_hashint_map_new (btor->mm);
+  else
+    prune_betap_cache (btor, false);
+
   /* initialize dual prop clone */
   if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
   {
@@ -2541,6 +3830,12 @@ sat_fun_solver (BtorFunSolver *slv)
     if (BTOR_EMPTY_STACK (slv->cur_lemmas)) break;
     slv->stats.refinement_iterations++;
 
+    if (!BTOR_EMPTY_STACK (slv->cur_lemma_prems))
+    {
+      remove_subsumed_lemmas (btor);
+      reset_lemma_premises (slv);
+    }
+
     BTORLOG (1, "add %d lemma(s)", BTOR_COUNT_STACK (slv->cur_lemmas));
     /* add generated lemmas to formula */
     for (i = 0; i < BTOR_COUNT_STACK (slv->cur_lemmas); i++)
@@ -2575,6 +3870,7 @@ sat_fun_solver (BtorFunSolver *slv)
   }
 
 DONE:
+  if (slv->app_chains) delete_app_chains (slv);
   BTOR_RELEASE_STACK (init_apps);
   btor_hashint_table_delete (init_apps_cache);
 
@@ -2607,6 +3903,10 @@ generate_model_fun_solver (BtorFunSolver *slv,
     btor_model_init_bv (slv->btor, &slv->btor->bv_model);
   btor_model_init_fun (slv->btor, &slv->btor->fun_model);
 
+  /* model values are computed and cached on demand when queried via
+   * btor_model_get_bv and btor_model_get_fun */
+  if (btor_opt_get (slv->btor, BTOR_OPT_MODEL_LAZY)) return;
+
   btor_model_generate (slv->btor,
                        slv->btor->bv_model,
                        slv->btor->fun_model,
@@ -2656,6 +3956,17 @@ print_stats_fun_solver (BtorFunSolver *slv)
                 "  %.1f average lemma size",
                 BTOR_AVERAGE_UTIL (slv->stats.lemmas_size_sum,
                                    slv->stats.lod_refinements));
+      if (btor_opt_get (btor, BTOR_OPT_FUN_LEMMA_MIN))
+      {
+        BTOR_MSG (btor->msg,
+                  1,
+                  "  %4lld premise literals dropped",
+                  slv->stats.lemma_prems_dropped);
+        BTOR_MSG (btor->msg,
+                  1,
+                  "  %4d subsumed lemmas",
+                  slv->stats.lemmas_subsumed);
+      }
       for (i = 1; i < BTOR_SIZE_STACK (slv->stats.lemmas_size); i++)
       {
         if (!slv->stats.lemmas_size.start[i]) continue;
@@ -2678,8 +3989,38 @@ print_stats_fun_solver (BtorFunSolver *slv)
   BTOR_MSG (btor->msg, 1, "%7lld propagations", slv->stats.propagations);
   BTOR_MSG (
       btor->msg, 1, "%7lld propagations down", slv->stats.propagations_down);
+  if (slv->stats.args_interned)
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld interned argument assignments",
+              slv->stats.args_interned);
+  if (btor_opt_get (btor, BTOR_OPT_FUN_INC_CHECK))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld applies re-checked (%.1f per round)",
+              slv->stats.apps_rechecked,
+              BTOR_AVERAGE_UTIL (slv->stats.apps_rechecked,
+                                 slv->stats.refinement_iterations + 1));
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld applies checked in total",
+              slv->stats.apps_rechecked + slv->stats.apps_replayed);
+  }
+  if (btor_opt_get (btor, BTOR_OPT_FUN_STORE_CHAINS))
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld stores skipped via index sets",
+              slv->stats.store_chain_skips);
+  if (btor_opt_get (btor, BTOR_OPT_FUN_BETAP_CACHE))
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld/%lld partial beta reduction cache hits/misses",
+              slv->stats.betap_cache_hits,
+              slv->stats.betap_cache_misses);
 
-  if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
+  if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP)
+      || btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP_AIG))
   {
     BTOR_MSG (btor->msg,
               1,
@@ -2818,6 +4159,7 @@ btor_new_fun_solver (Btor *btor)
                                         (BtorHashPtr) btor_node_hash_by_id,
                                         (BtorCmpPtr) btor_node_compare_by_id);
   BTOR_INIT_STACK (btor->mm, slv->cur_lemmas);
+  BTOR_INIT_STACK (btor->mm, slv->cur_lemma_prems);
 
   BTOR_INIT_STACK (btor->mm, slv->stats.lemmas_size);
 
@@ -12,6 +12,7 @@
 
 #include "btornode.h"
 #include "btorslv.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 
 #define BTOR_FUN_SOLVER(btor) ((BtorFunSolver *) (btor)->slv)
@@ -22,9 +23,31 @@ struct BtorFunSolver
 
   BtorPtrHashTable *lemmas;
   BtorNodePtrStack cur_lemmas;
+  BtorVoidPtrStack cur_lemma_prems; /* premises of 'cur_lemmas' for
+                                       subsumption (--fun-lemma-min) */
 
   BtorPtrHashTable *score; /* dcr score */
 
+  /* propagation chains of applies recorded in previous refinement rounds of
+   * the current SAT call (--fun-inc-check), maps apply ids to chains */
+  BtorIntHashTable *app_chains;
+  uint32_t app_chains_round;
+
+  /* assignments of args nodes interned per refinement round, maps args ids
+   * to BtorFunArgsAssignment (shared by args with equal assignments) */
+  BtorIntHashTable *args_assignments;
+  BtorPtrHashTable *args_tuples;
+
+  /* index sets of store chains built per refinement round
+   * (--fun-store-chains), maps update ids to positions in 'store_chain_segs',
+   * which maps positions to chain segments */
+  BtorIntHashTable *store_chains;
+  BtorVoidPtrStack store_chain_segs;
+
+  /* partial beta reduction results of lambdas kept across refinement rounds
+   * and SAT calls (--fun-betap-cache), maps lambda ids to BtorFunBetaCache */
+  BtorIntHashTable *betap_cache;
+
   // TODO (ma): make options for these
   int32_t lod_limit;
   int32_t sat_limit;
@@ -41,6 +64,8 @@ struct BtorFunSolver
 
     BtorUIntStack lemmas_size;      /* distribution of n-size lemmas */
     uint_least64_t lemmas_size_sum; /* sum of the size of all added lemmas */
+    uint_least64_t lemma_prems_dropped; /* premise literals dropped */
+    uint32_t lemmas_subsumed;
 
     uint32_t dp_failed_vars; /* number of vars in FA (dual prop) of last
                                 sat call (final bv skeleton) */
@@ -54,6 +79,16 @@ struct BtorFunSolver
     uint_least64_t eval_exp_calls;
     uint_least64_t propagations;
     uint_least64_t propagations_down;
+
+    uint_least64_t apps_rechecked; /* applies propagated from scratch */
+    uint_least64_t apps_replayed;  /* applies with unchanged assignments */
+
+    uint_least64_t args_interned; /* distinct args assignments per round */
+
+    uint_least64_t store_chain_skips; /* updates skipped via index sets */
+
+    uint_least64_t betap_cache_hits;
+    uint_least64_t betap_cache_misses;
   } stats;
 
   struct
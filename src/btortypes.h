@@ -163,6 +163,11 @@ enum BtorOption
         `MiniSat <https://github.com/niklasso/minisat>`_
       * BTOR_SAT_ENGINE_PICOSAT:
         `PicoSAT <http://fmv.jku.at/picosat/>`_
+      * BTOR_SAT_ENGINE_IPASIR:
+        any SAT solver implementing the
+        `IPASIR <https://github.com/biotomas/ipasir>`_ interface, loaded at
+        runtime from the shared library given by environment variable
+        ``BTORIPASIRLIB``
   */
   BTOR_OPT_SAT_ENGINE,
 
@@ -283,6 +288,9 @@ enum BtorOption
 
       Enable (``value``: 1) or disable (``value``: 0) unconstrained
       optimization.
+      In incremental mode and with model generation enabled, only
+      bit-vector terms are eliminated. Eliminated terms are restored if
+      their inputs occur in constraints or assumptions added later on.
   */
   BTOR_OPT_UCOPT,
 
@@ -851,12 +859,31 @@ enum BtorOption
   BTOR_OPT_SAT_ENGINE_LGL_FORK,
   BTOR_OPT_SAT_ENGINE_CADICAL_FREEZE,
   BTOR_OPT_SAT_ENGINE_N_THREADS,
+  BTOR_OPT_SAT_ENGINE_CUBES,
   BTOR_OPT_SIMP_NORMAMLIZE_ADDERS,
   BTOR_OPT_DECLSORT_BV_WIDTH,
   BTOR_OPT_QUANT_SYNTH_ITE_COMPLETE,
   BTOR_OPT_QUANT_FIXSYNTH,
   BTOR_OPT_RW_ZERO_LOWER_SLICE,
   BTOR_OPT_NONDESTR_SUBST,
+  BTOR_OPT_LAZY_ENCODE,
+  BTOR_OPT_UDIV_MUL_ENCODE,
+  BTOR_OPT_FUN_INC_CHECK,
+  BTOR_OPT_FUN_STORE_CHAINS,
+  BTOR_OPT_FUN_BETAP_CACHE,
+  BTOR_OPT_FUN_LEMMA_MIN,
+  BTOR_OPT_MODEL_LAZY,
+  BTOR_OPT_MODEL_RANGES,
+  BTOR_OPT_FUN_DUAL_PROP_AIG,
+  BTOR_OPT_RW_PROFILE,
+  BTOR_OPT_RW_DEFERRED,
+  BTOR_OPT_EGRAPH,
+  BTOR_OPT_EGRAPH_NODES,
+  BTOR_OPT_EGRAPH_TIME,
+  BTOR_OPT_COMPONENTS,
+  BTOR_OPT_INCREMENTAL_PREPROC,
+  BTOR_OPT_KNOWN_BITS,
+  BTOR_OPT_BV_REDUCE,
   /* this MUST be the last entry! */
   BTOR_OPT_NUM_OPTS,
 };
@@ -0,0 +1,395 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorbvreduce.h"
+
+#include "btoraigvec.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btorsubst.h"
+#include "preprocess/btorknownbits.h"
+#include "utils/btorhashint.h"
+#include "utils/btorutil.h"
+
+/*------------------------------------------------------------------------*/
+
+/* Get the node and the position of the bit that bit 'pos' of 'exp' refers to
+ * by descending through slices, concatenations and ite (c, ~0, 0) as created
+ * by sign extension (possibly with c = (x = 1)). */
+static void
+get_bit_origin (
+    Btor *btor, BtorNode *exp, uint32_t pos, BtorNode **node, uint32_t *idx)
+{
+  uint32_t w1;
+  bool inv;
+
+  inv = false;
+  for (;;)
+  {
+    if (btor_node_is_inverted (exp))
+    {
+      inv = !inv;
+      exp = btor_node_real_addr (exp);
+    }
+    if (btor_node_is_bv_slice (exp))
+    {
+      pos += btor_node_bv_slice_get_lower (exp);
+      exp = exp->e[0];
+    }
+    else if (btor_node_is_bv_concat (exp))
+    {
+      w1 = btor_node_bv_get_width (btor, exp->e[1]);
+      if (pos >= w1)
+      {
+        pos -= w1;
+        exp = exp->e[0];
+      }
+      else
+        exp = exp->e[1];
+    }
+    else if (btor_node_is_bv_cond (exp)
+             && btor_node_is_bv_const_ones (btor, exp->e[1])
+             && btor_node_is_bv_const_zero (btor, exp->e[2]))
+    {
+      pos = 0;
+      exp = exp->e[0];
+    }
+    else if (btor_node_is_bv_cond (exp)
+             && btor_node_is_bv_const_zero (btor, exp->e[1])
+             && btor_node_is_bv_const_ones (btor, exp->e[2]))
+    {
+      inv = !inv;
+      pos = 0;
+      exp = exp->e[0];
+    }
+    else if (btor_node_is_bv_eq (exp)
+             && btor_node_bv_get_width (btor, exp->e[0]) == 1
+             && btor_node_is_bv_const (exp->e[0]))
+    {
+      /* 1-bit equality with constant as created by sign extension */
+      if (btor_node_is_bv_const_zero (btor, exp->e[0])) inv = !inv;
+      exp = exp->e[1];
+    }
+    else
+      break;
+  }
+  *node = inv ? btor_node_invert (exp) : exp;
+  *idx  = pos;
+}
+
+/* Number of most significant bits that are copies of the sign bit (including
+ * the sign bit) due to sign extension. */
+static uint32_t
+get_num_sign_bits_ext (Btor *btor, BtorNode *exp)
+{
+  uint32_t i, width, msb_idx, idx;
+  BtorNode *msb, *node;
+
+  width = btor_node_bv_get_width (btor, exp);
+  get_bit_origin (btor, exp, width - 1, &msb, &msb_idx);
+  for (i = 1; i < width; i++)
+  {
+    get_bit_origin (btor, exp, width - 1 - i, &node, &idx);
+    if (node != msb || idx != msb_idx) break;
+  }
+  return i;
+}
+
+/* Number of most significant bits known to be equal to the sign bit
+ * (including the sign bit). */
+static uint32_t
+get_num_sign_bits (BtorKBContext *kb, Btor *btor, BtorNode *exp)
+{
+  uint32_t res, width, i, msb;
+  BtorBitVector *lo, *hi;
+
+  width = btor_node_bv_get_width (btor, exp);
+  res   = get_num_sign_bits_ext (btor, exp);
+  btor_known_bits_get (kb, exp, &lo, &hi);
+  if (btor_bv_get_bit (lo, width - 1) == btor_bv_get_bit (hi, width - 1))
+  {
+    msb = btor_bv_get_bit (lo, width - 1);
+    for (i = 1; i < width; i++)
+    {
+      if (btor_bv_get_bit (lo, width - 1 - i) != msb
+          || btor_bv_get_bit (hi, width - 1 - i) != msb)
+        break;
+    }
+    if (i > res) res = i;
+  }
+  btor_bv_free (btor->mm, lo);
+  btor_bv_free (btor->mm, hi);
+  return res;
+}
+
+static uint32_t
+get_num_leading_zeros (BtorKBContext *kb, Btor *btor, BtorNode *exp)
+{
+  uint32_t res;
+  BtorBitVector *lo, *hi;
+
+  btor_known_bits_get (kb, exp, &lo, &hi);
+  res = btor_bv_get_num_leading_zeros (hi);
+  btor_bv_free (btor->mm, lo);
+  btor_bv_free (btor->mm, hi);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Get the minimal width at which 'exp' can be computed without overflow
+ * ('sign' is set if the result has to be sign extended), which is computed
+ * from the number of leading zeros 'lz' and sign bits 'sb' of the operands:
+ *
+ *   add:  max (w0, w1) + 1 significant bits
+ *   mul:  w0 + w1 significant bits
+ *   ult:  max (w0, w1) significant bits, unsigned order is preserved by
+ *         truncating sign extended operands
+ */
+static uint32_t
+get_min_width (BtorNodeKind kind,
+               uint32_t width,
+               uint32_t lz[2],
+               uint32_t sb[2],
+               bool *sign)
+{
+  uint32_t u0, u1, s0, s1, nu, ns;
+
+  u0 = width - lz[0];
+  u1 = width - lz[1];
+  s0 = width - sb[0] + 1;
+  s1 = width - sb[1] + 1;
+  switch (kind)
+  {
+    case BTOR_BV_ADD_NODE:
+      nu = (u0 > u1 ? u0 : u1) + 1;
+      ns = (s0 > s1 ? s0 : s1) + 1;
+      break;
+    case BTOR_BV_MUL_NODE:
+      nu = u0 + u1;
+      ns = s0 + s1;
+      break;
+    default:
+      assert (kind == BTOR_BV_ULT_NODE);
+      nu = u0 > u1 ? u0 : u1;
+      ns = s0 > s1 ? s0 : s1;
+  }
+  if (nu == 0) nu = 1;
+  *sign = ns < nu;
+  return *sign ? ns : nu;
+}
+
+static BtorNode *
+reduce_width (Btor *btor, BtorNode *exp, uint32_t width, bool sign)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t w;
+  BtorNode *e0, *e1, *op, *res;
+
+  w  = btor_node_bv_get_width (btor, exp->e[0]);
+  e0 = btor_exp_bv_slice (btor, exp->e[0], width - 1, 0);
+  e1 = btor_exp_bv_slice (btor, exp->e[1], width - 1, 0);
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE: op = btor_exp_bv_add (btor, e0, e1); break;
+    case BTOR_BV_MUL_NODE: op = btor_exp_bv_mul (btor, e0, e1); break;
+    default:
+      assert (btor_node_is_bv_ult (exp));
+      op = btor_exp_bv_ult (btor, e0, e1);
+  }
+  if (btor_node_is_bv_ult (exp))
+    res = btor_node_copy (btor, op);
+  else if (sign)
+    res = btor_exp_bv_sext (btor, op, w - width);
+  else
+    res = btor_exp_bv_uext (btor, op, w - width);
+  btor_node_release (btor, op);
+  btor_node_release (btor, e0);
+  btor_node_release (btor, e1);
+  return res;
+}
+
+/* Get the number of AIG nodes of 'exp' (add, mul or ult) over the lower
+ * 'width' bits of its operands. The operands are encoded in a separate AIG
+ * manager with known bits as constants and one AIG variable per input bit
+ * (see get_bit_origin), such that AIG nodes that are simplified away by
+ * constant propagation and structural hashing are not counted. */
+static uint_least64_t
+get_num_aigs (Btor *btor, BtorKBContext *kb, BtorNode *exp, uint32_t width)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t i, j, k, idx;
+  uint_least64_t res;
+  BtorBitVector *lo, *hi;
+  BtorAIGVecMgr *avmgr;
+  BtorAIGMgr *amgr;
+  BtorAIGVec *av[2], *op;
+  BtorAIG *aig;
+  BtorNode *node;
+  BtorNodePtrStack nodes;
+  BtorUIntStack idxs;
+  BtorAIGPtrStack aigs;
+
+  avmgr = btor_aigvec_mgr_new (btor);
+  amgr  = btor_aigvec_get_aig_mgr (avmgr);
+  BTOR_INIT_STACK (btor->mm, nodes);
+  BTOR_INIT_STACK (btor->mm, idxs);
+  BTOR_INIT_STACK (btor->mm, aigs);
+
+  for (i = 0; i < 2; i++)
+  {
+    btor_known_bits_get (kb, exp->e[i], &lo, &hi);
+    av[i] = btor_aigvec_zero (avmgr, width);
+    for (j = 0; j < width; j++)
+    {
+      if (btor_bv_get_bit (lo, j))
+        aig = BTOR_AIG_TRUE;
+      else if (!btor_bv_get_bit (hi, j))
+        aig = BTOR_AIG_FALSE;
+      else
+      {
+        get_bit_origin (btor, exp->e[i], j, &node, &idx);
+        for (k = 0; k < BTOR_COUNT_STACK (nodes); k++)
+          if (BTOR_PEEK_STACK (nodes, k) == btor_node_real_addr (node)
+              && BTOR_PEEK_STACK (idxs, k) == idx)
+            break;
+        if (k == BTOR_COUNT_STACK (nodes))
+        {
+          BTOR_PUSH_STACK (nodes, btor_node_real_addr (node));
+          BTOR_PUSH_STACK (idxs, idx);
+          BTOR_PUSH_STACK (aigs, btor_aig_var (amgr));
+        }
+        aig = btor_aig_copy (amgr, BTOR_PEEK_STACK (aigs, k));
+        if (btor_node_is_inverted (node)) aig = BTOR_INVERT_AIG (aig);
+      }
+      av[i]->aigs[width - 1 - j] = aig;
+    }
+    btor_bv_free (btor->mm, lo);
+    btor_bv_free (btor->mm, hi);
+  }
+
+  res = amgr->cur_num_aigs;
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE: op = btor_aigvec_add (avmgr, av[0], av[1]); break;
+    case BTOR_BV_MUL_NODE: op = btor_aigvec_mul (avmgr, av[0], av[1]); break;
+    default:
+      assert (btor_node_is_bv_ult (exp));
+      op = btor_aigvec_ult (avmgr, av[0], av[1]);
+  }
+  res = amgr->cur_num_aigs - res;
+
+  btor_aigvec_release_delete (avmgr, op);
+  btor_aigvec_release_delete (avmgr, av[0]);
+  btor_aigvec_release_delete (avmgr, av[1]);
+  while (!BTOR_EMPTY_STACK (aigs))
+    btor_aig_release (amgr, BTOR_POP_STACK (aigs));
+  BTOR_RELEASE_STACK (aigs);
+  BTOR_RELEASE_STACK (idxs);
+  BTOR_RELEASE_STACK (nodes);
+  btor_aigvec_mgr_delete (avmgr);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_reduce_bv_widths (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, width, min_width, lz[2], sb[2], num_reduced;
+  uint_least64_t num_aigs, aigs, aigs_min;
+  double start, delta;
+  bool sign;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *cache;
+  BtorNodePtrStack visit;
+  BtorNode *cur, *subst;
+  BtorKBContext *kb;
+
+  if (btor->unsynthesized_constraints->count == 0) return;
+
+  start       = btor_util_time_stamp ();
+  num_reduced = 0;
+  num_aigs    = 0;
+
+  kb    = btor_known_bits_new_context (btor);
+  cache = btor_hashint_table_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, visit);
+  btor_init_substitutions (btor);
+
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    BTOR_PUSH_STACK (visit, cur);
+  }
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+
+    if (cur->parameterized || btor_node_is_synth (cur)) continue;
+    if (!btor_node_is_bv_add (cur) && !btor_node_is_bv_mul (cur)
+        && !btor_node_is_bv_ult (cur))
+      continue;
+
+    width = btor_node_bv_get_width (btor, cur->e[0]);
+    if (width == 1) continue;
+    for (i = 0; i < 2; i++)
+    {
+      lz[i] = get_num_leading_zeros (kb, btor, cur->e[i]);
+      sb[i] = get_num_sign_bits (kb, btor, cur->e[i]);
+    }
+    min_width = get_min_width (cur->kind, width, lz, sb, &sign);
+    if (min_width >= width) continue;
+
+    /* skip if bit-blasting already simplifies away the extension bits */
+    aigs     = get_num_aigs (btor, kb, cur, width);
+    aigs_min = get_num_aigs (btor, kb, cur, min_width);
+    if (aigs_min >= aigs) continue;
+
+    subst = reduce_width (btor, cur, min_width, sign);
+    BTORLOG (2,
+             "reduce %s from %u to %u bits",
+             btor_util_node2string (cur),
+             width,
+             min_width);
+    btor_insert_substitution (btor, cur, subst, false);
+    btor_node_release (btor, subst);
+    num_reduced++;
+    num_aigs += aigs - aigs_min;
+  }
+
+  btor_substitute_and_rebuild (btor, btor->substitutions);
+  btor_delete_substitutions (btor);
+
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (cache);
+  btor_known_bits_delete_context (kb);
+
+  btor->stats.bv_reduced += num_reduced;
+  btor->stats.bv_reduce_aigs += num_aigs;
+  delta = btor_util_time_stamp () - start;
+  btor->time.bv_reduce += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "reduced width of %u terms (%llu AIG nodes saved) in %.3f seconds",
+            num_reduced,
+            (unsigned long long) num_aigs,
+            delta);
+}
@@ -0,0 +1,21 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORBVREDUCE_H_INCLUDED
+#define BTORBVREDUCE_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Reduce the bit-width of additions, multiplications and unsigned less than
+ * over zero- or sign-extended operands (determined from known leading bits
+ * and the structure of the operands) to the minimal width at which the result
+ * does not overflow, followed by a zero or sign extension. Terms are only
+ * reduced if this saves AIG nodes. */
+void btor_reduce_bv_widths (Btor* btor);
+
+#endif
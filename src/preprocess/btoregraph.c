@@ -0,0 +1,1076 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btoregraph.h"
+
+#include "btorcore.h"
+#include "btordbg.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btorsubst.h"
+#include "utils/btorhashint.h"
+#include "utils/btorhashptr.h"
+#include "utils/btorutil.h"
+
+#include <inttypes.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Children of e-nodes are literals, i.e., the id of the child class shifted
+ * by one with the lowest bit set if the child is inverted (as for the edges
+ * of BtorNode). Classes are merged with a union-find that stores the
+ * polarity of each class relative to its parent, hence the e-nodes of a class
+ * either represent the value of the class or its negation. */
+
+#define EG_LIT(cls, inv) (((cls) << 1) | (inv))
+#define EG_CLS(lit) ((lit) >> 1)
+#define EG_INV(lit) ((lit) & 1u)
+
+struct BtorEGNode
+{
+  BtorNodeKind kind; /* BTOR_INVALID_NODE for leafs */
+  uint32_t arity;
+  uint32_t e[3];         /* child literals */
+  uint32_t upper, lower; /* slice indices */
+  BtorNode *exp;         /* leaf node */
+  uint32_t cls;          /* class the e-node was created in */
+  bool dead;             /* congruent to another e-node */
+};
+
+typedef struct BtorEGNode BtorEGNode;
+
+BTOR_DECLARE_STACK (BtorEGNodePtr, BtorEGNode *);
+
+struct BtorEGraph
+{
+  Btor *btor;
+  BtorMemMgr *mm;
+  BtorEGNodePtrStack nodes;
+  BtorPtrHashTable *hashcons; /* canonical e-nodes */
+  BtorUIntStack uf;           /* class -> literal of parent class */
+  BtorUIntStack size;         /* class -> number of merged classes */
+  BtorUIntStack width;        /* class -> bit-width */
+  BtorIntHashTable *lits;     /* node id -> literal */
+  BtorUIntStack unions;       /* pending unions (pairs of literals) */
+  bool conflict;              /* merged a class with its negation */
+
+  /* snapshot of the current round */
+  uint32_t num_classes, num_members;
+  uint32_t *first, *count, *members; /* e-nodes per (root) class */
+  uint64_t *cost;                    /* min. cost per (root) class */
+  BtorEGNode **best;                 /* e-node with min. cost */
+  BtorIntHashTable *terms;           /* class -> extracted term */
+};
+
+typedef struct BtorEGraph BtorEGraph;
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_enode_exp (Btor *btor, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  if (exp->parameterized || !btor_sort_is_bv (btor, exp->sort_id))
+    return false;
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_CONCAT_NODE:
+    case BTOR_COND_NODE: return true;
+    default: return false;
+  }
+}
+
+static bool
+is_binary_kind (BtorNodeKind kind)
+{
+  return kind >= BTOR_BV_AND_NODE && kind <= BTOR_BV_CONCAT_NODE
+         && kind != BTOR_FUN_EQ_NODE;
+}
+
+/* Estimated number of AIG nodes of the bit-blasted operator, 'width' is the
+ * bit-width of the operands (of the result for conditionals). */
+static uint64_t
+op_cost (BtorNodeKind kind, uint32_t width)
+{
+  uint64_t w = width, log;
+
+  switch (kind)
+  {
+    case BTOR_BV_AND_NODE: return w;
+    case BTOR_BV_EQ_NODE: return 4 * w;
+    case BTOR_BV_ULT_NODE: return 6 * w;
+    case BTOR_BV_ADD_NODE: return 7 * w;
+    case BTOR_BV_MUL_NODE: return 8 * w * w;
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE: return 16 * w * w;
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+      for (log = 1; (1u << log) < w; log++)
+        ;
+      return 3 * w * log;
+    case BTOR_COND_NODE: return 3 * w;
+    default: return 0;
+  }
+}
+
+/* Cost of the DAG of the bit-vector part of the given roots. */
+static uint64_t
+dag_cost (Btor *btor, BtorNodePtrStack *roots)
+{
+  uint32_t i;
+  uint64_t res;
+  BtorIntHashTable *cache;
+  BtorNodePtrStack visit;
+  BtorNode *cur;
+
+  res   = 0;
+  cache = btor_hashint_table_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, visit);
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+    BTOR_PUSH_STACK (visit, BTOR_PEEK_STACK (*roots, i));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    if (!is_enode_exp (btor, cur)) continue;
+    res += 1
+           + op_cost (cur->kind,
+                      btor_node_bv_get_width (
+                          btor, cur->kind == BTOR_COND_NODE ? cur : cur->e[0]));
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (cache);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static uint32_t
+hash_enode (const BtorEGNode *n)
+{
+  uint32_t i, h;
+
+  h = n->kind;
+  if (n->exp) h += 333444569u * (uint32_t) btor_node_get_id (n->exp);
+  for (i = 0; i < n->arity; i++) h = 76891121u * h + n->e[i];
+  h += 456790003u * n->upper + n->lower;
+  return h;
+}
+
+static int32_t
+compare_enode (const BtorEGNode *a, const BtorEGNode *b)
+{
+  uint32_t i;
+
+  if (a->kind != b->kind || a->arity != b->arity || a->exp != b->exp
+      || a->upper != b->upper || a->lower != b->lower)
+    return 1;
+  for (i = 0; i < a->arity; i++)
+    if (a->e[i] != b->e[i]) return 1;
+  return 0;
+}
+
+static BtorPtrHashTable *
+new_hashcons (BtorEGraph *eg)
+{
+  return btor_hashptr_table_new (
+      eg->mm, (BtorHashPtr) hash_enode, (BtorCmpPtr) compare_enode);
+}
+
+static uint32_t
+find (BtorEGraph *eg, uint32_t lit)
+{
+  uint32_t cls, inv, p;
+
+  cls = EG_CLS (lit);
+  inv = EG_INV (lit);
+  while ((p = BTOR_PEEK_STACK (eg->uf, cls)) != EG_LIT (cls, 0))
+  {
+    inv ^= EG_INV (p);
+    cls = EG_CLS (p);
+  }
+  return EG_LIT (cls, inv);
+}
+
+static bool
+merge (BtorEGraph *eg, uint32_t a, uint32_t b)
+{
+  uint32_t ra, rb, ca, cb, tmp;
+
+  ra = find (eg, a);
+  rb = find (eg, b);
+  ca = EG_CLS (ra);
+  cb = EG_CLS (rb);
+  if (ca == cb)
+  {
+    /* a = ~a can only be derived by an unsound rule */
+    assert (EG_INV (ra) == EG_INV (rb));
+    if (EG_INV (ra) != EG_INV (rb)) eg->conflict = true;
+    return false;
+  }
+  if (BTOR_PEEK_STACK (eg->size, ca) > BTOR_PEEK_STACK (eg->size, cb))
+  {
+    tmp = ca;
+    ca  = cb;
+    cb  = tmp;
+  }
+  /* a = ca ^ inv (ra), b = cb ^ inv (rb), a = b -> ca = cb ^ inv (ra ^ rb) */
+  BTOR_POKE_STACK (eg->uf, ca, EG_LIT (cb, EG_INV (ra ^ rb)));
+  BTOR_POKE_STACK (eg->size,
+                   cb,
+                   BTOR_PEEK_STACK (eg->size, cb)
+                       + BTOR_PEEK_STACK (eg->size, ca));
+  return true;
+}
+
+static void
+canonicalize (BtorEGraph *eg, BtorEGNode *n)
+{
+  uint32_t i, tmp;
+
+  for (i = 0; i < n->arity; i++) n->e[i] = find (eg, n->e[i]);
+  if (btor_node_is_binary_commutative_kind (n->kind) && n->e[0] > n->e[1])
+  {
+    tmp     = n->e[0];
+    n->e[0] = n->e[1];
+    n->e[1] = tmp;
+  }
+}
+
+static uint32_t
+get_width (BtorEGraph *eg, uint32_t lit)
+{
+  return BTOR_PEEK_STACK (eg->width, EG_CLS (lit));
+}
+
+static uint32_t
+enode_width (BtorEGraph *eg, BtorEGNode *n)
+{
+  switch (n->kind)
+  {
+    case BTOR_INVALID_NODE: return btor_node_bv_get_width (eg->btor, n->exp);
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ULT_NODE: return 1;
+    case BTOR_BV_SLICE_NODE: return n->upper - n->lower + 1;
+    case BTOR_BV_CONCAT_NODE:
+      return get_width (eg, n->e[0]) + get_width (eg, n->e[1]);
+    case BTOR_COND_NODE: return get_width (eg, n->e[1]);
+    default: return get_width (eg, n->e[0]);
+  }
+}
+
+/* Returns the literal of the class of the given e-node, which is created if
+ * it does not exist yet. */
+static uint32_t
+add_enode (BtorEGraph *eg,
+           BtorNodeKind kind,
+           uint32_t arity,
+           uint32_t e[],
+           uint32_t upper,
+           uint32_t lower,
+           BtorNode *exp)
+{
+  uint32_t i, cls;
+  BtorEGNode key, *n;
+  BtorPtrHashBucket *b;
+
+  BTOR_CLR (&key);
+  key.kind  = kind;
+  key.arity = arity;
+  for (i = 0; i < arity; i++) key.e[i] = e[i];
+  key.upper = upper;
+  key.lower = lower;
+  key.exp   = exp;
+  canonicalize (eg, &key);
+
+  if ((b = btor_hashptr_table_get (eg->hashcons, &key)))
+    return find (eg, EG_LIT (((BtorEGNode *) b->key)->cls, 0));
+
+  BTOR_NEW (eg->mm, n);
+  *n  = key;
+  cls = BTOR_COUNT_STACK (eg->uf);
+  BTOR_PUSH_STACK (eg->uf, EG_LIT (cls, 0));
+  BTOR_PUSH_STACK (eg->size, 1);
+  BTOR_PUSH_STACK (eg->width, enode_width (eg, n));
+  n->cls = cls;
+  if (exp) n->exp = btor_node_copy (eg->btor, exp);
+  BTOR_PUSH_STACK (eg->nodes, n);
+  btor_hashptr_table_add (eg->hashcons, n);
+  return EG_LIT (cls, 0);
+}
+
+static uint32_t
+add_enode2 (BtorEGraph *eg, BtorNodeKind kind, uint32_t e0, uint32_t e1)
+{
+  uint32_t e[2] = {e0, e1};
+  return add_enode (eg, kind, 2, e, 0, 0, 0);
+}
+
+static uint32_t
+add_cond (BtorEGraph *eg, uint32_t e0, uint32_t e1, uint32_t e2)
+{
+  uint32_t e[3] = {e0, e1, e2};
+  return add_enode (eg, BTOR_COND_NODE, 3, e, 0, 0, 0);
+}
+
+/* Returns the literal of the given node, its cone is added to the e-graph
+ * down to the leafs (all nodes that are not handled by the e-graph). */
+static uint32_t
+add_exp (BtorEGraph *eg, BtorNode *exp)
+{
+  uint32_t i, lit, e[3];
+  BtorIntHashTable *mark;
+  BtorNodePtrStack visit;
+  BtorNode *cur, *real_exp;
+  BtorHashTableData *d;
+
+  real_exp = btor_node_real_addr (exp);
+  if (!(d = btor_hashint_map_get (eg->lits, real_exp->id)))
+  {
+    mark = btor_hashint_table_new (eg->mm);
+    BTOR_INIT_STACK (eg->mm, visit);
+    BTOR_PUSH_STACK (visit, real_exp);
+    while (!BTOR_EMPTY_STACK (visit))
+    {
+      cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+      if (btor_hashint_map_contains (eg->lits, cur->id)) continue;
+
+      if (is_enode_exp (eg->btor, cur))
+      {
+        if (!btor_hashint_table_contains (mark, cur->id))
+        {
+          btor_hashint_table_add (mark, cur->id);
+          BTOR_PUSH_STACK (visit, cur);
+          for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+          continue;
+        }
+        for (i = 0; i < cur->arity; i++)
+        {
+          d = btor_hashint_map_get (eg->lits,
+                                    btor_node_real_addr (cur->e[i])->id);
+          assert (d);
+          e[i] = (uint32_t) d->as_int ^ btor_node_is_inverted (cur->e[i]);
+        }
+        lit = add_enode (
+            eg,
+            cur->kind,
+            cur->arity,
+            e,
+            btor_node_is_bv_slice (cur) ? btor_node_bv_slice_get_upper (cur)
+                                        : 0,
+            btor_node_is_bv_slice (cur) ? btor_node_bv_slice_get_lower (cur)
+                                        : 0,
+            0);
+      }
+      else
+        lit = add_enode (eg, BTOR_INVALID_NODE, 0, e, 0, 0, cur);
+      btor_hashint_map_add (eg->lits, cur->id)->as_int = (int32_t) lit;
+    }
+    BTOR_RELEASE_STACK (visit);
+    btor_hashint_table_delete (mark);
+    d = btor_hashint_map_get (eg->lits, real_exp->id);
+  }
+  return (uint32_t) d->as_int ^ btor_node_is_inverted (exp);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+release_snapshot (BtorEGraph *eg)
+{
+  BtorIntHashTableIterator it;
+
+  if (eg->terms)
+  {
+    btor_iter_hashint_init (&it, eg->terms);
+    while (btor_iter_hashint_has_next (&it))
+      btor_node_release (eg->btor, btor_iter_hashint_next_data (&it)->as_ptr);
+    btor_hashint_map_delete (eg->terms);
+    eg->terms = 0;
+  }
+  if (eg->num_classes)
+  {
+    BTOR_DELETEN (eg->mm, eg->first, eg->num_classes);
+    BTOR_DELETEN (eg->mm, eg->count, eg->num_classes);
+    BTOR_DELETEN (eg->mm, eg->cost, eg->num_classes);
+    BTOR_DELETEN (eg->mm, eg->best, eg->num_classes);
+    BTOR_DELETEN (eg->mm, eg->members, eg->num_members);
+    eg->num_classes = 0;
+  }
+}
+
+static uint32_t
+root_cls (BtorEGraph *eg, BtorEGNode *n)
+{
+  return EG_CLS (find (eg, EG_LIT (n->cls, 0)));
+}
+
+/* Index the e-nodes of each class and determine the e-nodes with min. cost
+ * (number of estimated AIG nodes of the tree below). */
+static void
+take_snapshot (BtorEGraph *eg)
+{
+  bool changed;
+  uint32_t i, j, c, num_nodes;
+  uint64_t cost, ccost;
+  BtorEGNode *n;
+
+  release_snapshot (eg);
+
+  eg->num_classes = BTOR_COUNT_STACK (eg->uf);
+  num_nodes       = BTOR_COUNT_STACK (eg->nodes);
+  BTOR_CNEWN (eg->mm, eg->first, eg->num_classes);
+  BTOR_CNEWN (eg->mm, eg->count, eg->num_classes);
+  BTOR_CNEWN (eg->mm, eg->cost, eg->num_classes);
+  BTOR_CNEWN (eg->mm, eg->best, eg->num_classes);
+  BTOR_CNEWN (eg->mm, eg->members, num_nodes);
+  eg->num_members = num_nodes;
+  eg->terms = btor_hashint_map_new (eg->mm);
+
+  for (i = 0; i < num_nodes; i++)
+  {
+    n = BTOR_PEEK_STACK (eg->nodes, i);
+    if (!n->dead) eg->count[root_cls (eg, n)] += 1;
+  }
+  for (c = 1; c < eg->num_classes; c++)
+    eg->first[c] = eg->first[c - 1] + eg->count[c - 1];
+  for (c = 0; c < eg->num_classes; c++)
+  {
+    eg->count[c] = 0;
+    eg->cost[c]  = UINT64_MAX;
+  }
+  for (i = 0; i < num_nodes; i++)
+  {
+    n = BTOR_PEEK_STACK (eg->nodes, i);
+    if (n->dead) continue;
+    c                                      = root_cls (eg, n);
+    eg->members[eg->first[c] + eg->count[c]] = i;
+    eg->count[c] += 1;
+  }
+
+  /* the cost of an e-node is strictly greater than the cost of its children,
+   * hence the e-nodes with min. cost do not form cycles */
+  do
+  {
+    changed = false;
+    for (i = 0; i < num_nodes; i++)
+    {
+      n = BTOR_PEEK_STACK (eg->nodes, i);
+      if (n->dead) continue;
+      if (n->kind == BTOR_INVALID_NODE)
+        cost = 0;
+      else
+      {
+        cost = 1
+               + op_cost (n->kind,
+                          get_width (eg,
+                                     n->kind == BTOR_COND_NODE
+                                         ? EG_LIT (n->cls, 0)
+                                         : n->e[0]));
+        for (j = 0; j < n->arity; j++)
+        {
+          ccost = eg->cost[EG_CLS (find (eg, n->e[j]))];
+          if (ccost == UINT64_MAX || cost + ccost < cost) break;
+          cost += ccost;
+        }
+        if (j < n->arity) continue;
+      }
+      c = root_cls (eg, n);
+      if (cost < eg->cost[c])
+      {
+        eg->cost[c] = cost;
+        eg->best[c] = n;
+        changed     = true;
+      }
+    }
+  } while (changed);
+}
+
+static uint32_t
+get_members (BtorEGraph *eg, uint32_t lit, uint32_t **members)
+{
+  uint32_t c = EG_CLS (find (eg, lit));
+  if (c >= eg->num_classes) return 0;
+  *members = eg->members + eg->first[c];
+  return eg->count[c];
+}
+
+/* Polarity of literal 'lit' relative to e-node 'n' of its class. */
+static uint32_t
+rel_inv (BtorEGraph *eg, uint32_t lit, BtorEGNode *n)
+{
+  return EG_INV (find (eg, lit) ^ find (eg, EG_LIT (n->cls, 0)));
+}
+
+static BtorNode *
+invert_if (BtorNode *exp, uint32_t inv)
+{
+  return inv ? btor_node_invert (exp) : exp;
+}
+
+static BtorNode *
+mk_exp (Btor *btor, BtorEGNode *n, BtorNode *e[])
+{
+  switch (n->kind)
+  {
+    case BTOR_INVALID_NODE: return btor_node_copy (btor, n->exp);
+    case BTOR_BV_SLICE_NODE:
+      return btor_exp_bv_slice (btor, e[0], n->upper, n->lower);
+    case BTOR_COND_NODE: return btor_exp_cond (btor, e[0], e[1], e[2]);
+    default: return btor_exp_create (btor, n->kind, e, n->arity);
+  }
+}
+
+/* Build the term with min. cost of the given literal. */
+static BtorNode *
+get_term (BtorEGraph *eg, uint32_t lit)
+{
+  uint32_t i, c, cc, root;
+  bool ready;
+  BtorUIntStack visit;
+  BtorEGNode *n;
+  BtorNode *e[3], *res;
+  BtorHashTableData *d;
+
+  res  = 0;
+  root = find (eg, lit);
+  BTOR_INIT_STACK (eg->mm, visit);
+  BTOR_PUSH_STACK (visit, EG_CLS (root));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    c = BTOR_TOP_STACK (visit);
+    if (btor_hashint_map_contains (eg->terms, c))
+    {
+      (void) BTOR_POP_STACK (visit);
+      continue;
+    }
+    if (c >= eg->num_classes || !(n = eg->best[c])) goto DONE;
+
+    ready = true;
+    for (i = 0; i < n->arity; i++)
+    {
+      cc = EG_CLS (find (eg, n->e[i]));
+      if (btor_hashint_map_contains (eg->terms, cc)) continue;
+      BTOR_PUSH_STACK (visit, cc);
+      ready = false;
+    }
+    if (!ready) continue;
+    (void) BTOR_POP_STACK (visit);
+
+    for (i = 0; i < n->arity; i++)
+    {
+      cc   = find (eg, n->e[i]);
+      e[i] = invert_if (
+          btor_hashint_map_get (eg->terms, EG_CLS (cc))->as_ptr, EG_INV (cc));
+    }
+    btor_hashint_map_add (eg->terms, c)->as_ptr = invert_if (
+        mk_exp (eg->btor, n, e), EG_INV (find (eg, EG_LIT (n->cls, 0))));
+  }
+  d   = btor_hashint_map_get (eg->terms, EG_CLS (root));
+  res = btor_node_copy (eg->btor,
+                        invert_if (d->as_ptr, EG_INV (root)));
+DONE:
+  BTOR_RELEASE_STACK (visit);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+push_union (BtorEGraph *eg, BtorEGNode *n, uint32_t lit)
+{
+  BTOR_PUSH_STACK (eg->unions, EG_LIT (n->cls, 0));
+  BTOR_PUSH_STACK (eg->unions, lit);
+}
+
+/* Apply the rewriter to the e-node with its children replaced by the terms
+ * with min. cost of their classes. */
+static void
+rule_rewrite (BtorEGraph *eg, BtorEGNode *n)
+{
+  uint32_t i;
+  BtorNode *e[3], *res;
+
+  if (n->kind == BTOR_INVALID_NODE) return;
+
+  for (i = 0; i < n->arity; i++)
+  {
+    if (!(e[i] = get_term (eg, n->e[i])))
+    {
+      while (i > 0) btor_node_release (eg->btor, e[--i]);
+      return;
+    }
+  }
+  res = mk_exp (eg->btor, n, e);
+  push_union (eg, n, add_exp (eg, res));
+  btor_node_release (eg->btor, res);
+  for (i = 0; i < n->arity; i++) btor_node_release (eg->btor, e[i]);
+}
+
+/* (a o b) o c = a o (b o c) = b o (a o c) for o in {and, add, mul} */
+static void
+rule_assoc (BtorEGraph *eg, BtorEGNode *n)
+{
+  uint32_t i, j, num, *members = 0, x, y;
+  BtorEGNode *m;
+
+  if (n->kind != BTOR_BV_AND_NODE && n->kind != BTOR_BV_ADD_NODE
+      && n->kind != BTOR_BV_MUL_NODE)
+    return;
+
+  for (i = 0; i < 2; i++)
+  {
+    x   = n->e[i];
+    y   = n->e[1 - i];
+    num = get_members (eg, x, &members);
+    for (j = 0; j < num; j++)
+    {
+      m = BTOR_PEEK_STACK (eg->nodes, members[j]);
+      if (m->kind != n->kind || rel_inv (eg, x, m)) continue;
+      push_union (
+          eg,
+          n,
+          add_enode2 (
+              eg, n->kind, m->e[0], add_enode2 (eg, n->kind, m->e[1], y)));
+      push_union (
+          eg,
+          n,
+          add_enode2 (
+              eg, n->kind, m->e[1], add_enode2 (eg, n->kind, m->e[0], y)));
+    }
+  }
+}
+
+/* (c ? a : b) o x = c ? a o x : b o x */
+static void
+rule_ite_push (BtorEGraph *eg, BtorEGNode *n)
+{
+  uint32_t i, j, num, *members = 0, inv, e[2], t, f;
+  BtorEGNode *m;
+
+  if (!is_binary_kind (n->kind)) return;
+
+  for (i = 0; i < 2; i++)
+  {
+    num = get_members (eg, n->e[i], &members);
+    for (j = 0; j < num; j++)
+    {
+      m = BTOR_PEEK_STACK (eg->nodes, members[j]);
+      if (m->kind != BTOR_COND_NODE) continue;
+      inv          = rel_inv (eg, n->e[i], m);
+      e[1 - i]     = n->e[1 - i];
+      e[i]         = m->e[1] ^ inv;
+      t            = add_enode (eg, n->kind, 2, e, 0, 0, 0);
+      e[i]         = m->e[2] ^ inv;
+      f            = add_enode (eg, n->kind, 2, e, 0, 0, 0);
+      push_union (eg, n, add_cond (eg, m->e[0], t, f));
+    }
+  }
+}
+
+/* c ? a o x : b o x = (c ? a : b) o x */
+static void
+rule_ite_lift (BtorEGraph *eg, BtorEGNode *n)
+{
+  uint32_t i, j, k, l, num_t, num_f, *mem_t = 0, *mem_f = 0, inv, e[2];
+  BtorEGNode *mt, *mf;
+
+  if (n->kind != BTOR_COND_NODE) return;
+
+  num_t = get_members (eg, n->e[1], &mem_t);
+  num_f = get_members (eg, n->e[2], &mem_f);
+  for (i = 0; i < num_t; i++)
+  {
+    mt = BTOR_PEEK_STACK (eg->nodes, mem_t[i]);
+    if (!is_binary_kind (mt->kind)) continue;
+    inv = rel_inv (eg, n->e[1], mt);
+    for (j = 0; j < num_f; j++)
+    {
+      mf = BTOR_PEEK_STACK (eg->nodes, mem_f[j]);
+      if (mf->kind != mt->kind || rel_inv (eg, n->e[2], mf) != inv) continue;
+      for (k = 0; k < 2; k++)
+      {
+        for (l = 0; l < 2; l++)
+        {
+          if (l != k && !btor_node_is_binary_commutative_kind (mt->kind))
+            continue;
+          if (find (eg, mt->e[k]) != find (eg, mf->e[l])) continue;
+          e[k]     = mt->e[k];
+          e[1 - k] = add_cond (eg, n->e[0], mt->e[1 - k], mf->e[1 - l]);
+          push_union (
+              eg, n, add_enode (eg, mt->kind, 2, e, 0, 0, 0) ^ inv);
+        }
+      }
+    }
+  }
+}
+
+/* x * (a + b) = x * a + x * b and x * a + x * b = x * (a + b) */
+static void
+rule_distrib (BtorEGraph *eg, BtorEGNode *n)
+{
+  uint32_t i, j, k, l, num0, num1, *mem0 = 0, *mem1 = 0, x, xa, xb;
+  BtorEGNode *m0, *m1;
+
+  if (n->kind == BTOR_BV_MUL_NODE)
+  {
+    for (i = 0; i < 2; i++)
+    {
+      x    = n->e[i];
+      num1 = get_members (eg, n->e[1 - i], &mem1);
+      for (j = 0; j < num1; j++)
+      {
+        m1 = BTOR_PEEK_STACK (eg->nodes, mem1[j]);
+        if (m1->kind != BTOR_BV_ADD_NODE || rel_inv (eg, n->e[1 - i], m1))
+          continue;
+        xa = add_enode2 (eg, BTOR_BV_MUL_NODE, x, m1->e[0]);
+        xb = add_enode2 (eg, BTOR_BV_MUL_NODE, x, m1->e[1]);
+        push_union (eg, n, add_enode2 (eg, BTOR_BV_ADD_NODE, xa, xb));
+      }
+    }
+  }
+  else if (n->kind == BTOR_BV_ADD_NODE)
+  {
+    num0 = get_members (eg, n->e[0], &mem0);
+    num1 = get_members (eg, n->e[1], &mem1);
+    for (i = 0; i < num0; i++)
+    {
+      m0 = BTOR_PEEK_STACK (eg->nodes, mem0[i]);
+      if (m0->kind != BTOR_BV_MUL_NODE || rel_inv (eg, n->e[0], m0)) continue;
+      for (j = 0; j < num1; j++)
+      {
+        m1 = BTOR_PEEK_STACK (eg->nodes, mem1[j]);
+        if (m1->kind != BTOR_BV_MUL_NODE || rel_inv (eg, n->e[1], m1))
+          continue;
+        for (k = 0; k < 2; k++)
+          for (l = 0; l < 2; l++)
+          {
+            if (find (eg, m0->e[k]) != find (eg, m1->e[l])) continue;
+            push_union (
+                eg,
+                n,
+                add_enode2 (
+                    eg,
+                    BTOR_BV_MUL_NODE,
+                    m0->e[k],
+                    add_enode2 (
+                        eg, BTOR_BV_ADD_NODE, m0->e[1 - k], m1->e[1 - l])));
+          }
+      }
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Restore the congruence invariant after merging classes. */
+static void
+rebuild (BtorEGraph *eg)
+{
+  bool changed;
+  uint32_t i;
+  BtorEGNode *n;
+  BtorPtrHashBucket *b;
+
+  do
+  {
+    changed = false;
+    btor_hashptr_table_delete (eg->hashcons);
+    eg->hashcons = new_hashcons (eg);
+    for (i = 0; i < BTOR_COUNT_STACK (eg->nodes); i++)
+    {
+      n = BTOR_PEEK_STACK (eg->nodes, i);
+      if (n->dead) continue;
+      canonicalize (eg, n);
+      if ((b = btor_hashptr_table_get (eg->hashcons, n)))
+      {
+        if (merge (eg,
+                   EG_LIT (((BtorEGNode *) b->key)->cls, 0),
+                   EG_LIT (n->cls, 0)))
+          changed = true;
+        n->dead = true;
+      }
+      else
+        btor_hashptr_table_add (eg->hashcons, n);
+    }
+  } while (changed);
+}
+
+/* One round of matching all rules against a snapshot of the e-graph, the
+ * resulting equalities are merged at the end of the round. Returns false if
+ * the e-graph is saturated. */
+static bool
+saturate_round (BtorEGraph *eg, uint32_t max_nodes, double deadline)
+{
+  bool changed;
+  uint32_t i, num_nodes, a, b;
+  BtorEGNode *n;
+
+  take_snapshot (eg);
+
+  num_nodes = BTOR_COUNT_STACK (eg->nodes);
+  for (i = 0; i < num_nodes; i++)
+  {
+    if (BTOR_COUNT_STACK (eg->nodes) >= max_nodes) break;
+    if (deadline > 0 && (i & 63) == 0 && btor_util_time_stamp () > deadline)
+      break;
+
+    n = BTOR_PEEK_STACK (eg->nodes, i);
+    if (n->dead) continue;
+    rule_rewrite (eg, n);
+    rule_assoc (eg, n);
+    rule_ite_push (eg, n);
+    rule_ite_lift (eg, n);
+    rule_distrib (eg, n);
+  }
+  release_snapshot (eg);
+
+  changed = BTOR_COUNT_STACK (eg->nodes) > num_nodes;
+  while (!BTOR_EMPTY_STACK (eg->unions))
+  {
+    b = BTOR_POP_STACK (eg->unions);
+    a = BTOR_POP_STACK (eg->unions);
+    if (merge (eg, a, b)) changed = true;
+  }
+  rebuild (eg);
+  return changed;
+}
+
+/*------------------------------------------------------------------------*/
+
+static BtorEGraph *
+new_egraph (Btor *btor)
+{
+  BtorEGraph *eg;
+
+  BTOR_CNEW (btor->mm, eg);
+  eg->btor     = btor;
+  eg->mm       = btor->mm;
+  eg->hashcons = new_hashcons (eg);
+  eg->lits     = btor_hashint_map_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, eg->nodes);
+  BTOR_INIT_STACK (btor->mm, eg->uf);
+  BTOR_INIT_STACK (btor->mm, eg->size);
+  BTOR_INIT_STACK (btor->mm, eg->width);
+  BTOR_INIT_STACK (btor->mm, eg->unions);
+  /* class 0 is not used since it can not be a key of int hash tables */
+  BTOR_PUSH_STACK (eg->uf, EG_LIT (0, 0));
+  BTOR_PUSH_STACK (eg->size, 1);
+  BTOR_PUSH_STACK (eg->width, 0);
+  return eg;
+}
+
+static void
+delete_egraph (BtorEGraph *eg)
+{
+  uint32_t i;
+  BtorEGNode *n;
+
+  release_snapshot (eg);
+  for (i = 0; i < BTOR_COUNT_STACK (eg->nodes); i++)
+  {
+    n = BTOR_PEEK_STACK (eg->nodes, i);
+    if (n->exp) btor_node_release (eg->btor, n->exp);
+    BTOR_DELETE (eg->mm, n);
+  }
+  BTOR_RELEASE_STACK (eg->nodes);
+  BTOR_RELEASE_STACK (eg->uf);
+  BTOR_RELEASE_STACK (eg->size);
+  BTOR_RELEASE_STACK (eg->width);
+  BTOR_RELEASE_STACK (eg->unions);
+  btor_hashptr_table_delete (eg->hashcons);
+  btor_hashint_map_delete (eg->lits);
+  BTOR_DELETE (eg->mm, eg);
+}
+
+/* Adds the cone of 'exp' to 'mark' and returns true if it contains any of
+ * the nodes in 'keys'. Nodes already in 'mark' are not visited again. */
+static bool
+mark_cone (Btor *btor,
+           BtorNode *exp,
+           BtorIntHashTable *mark,
+           BtorIntHashTable *keys)
+{
+  bool res;
+  uint32_t i;
+  BtorNodePtrStack visit;
+  BtorNode *cur;
+
+  res = false;
+  BTOR_INIT_STACK (btor->mm, visit);
+  BTOR_PUSH_STACK (visit, exp);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (mark, cur->id)) continue;
+    if (btor_hashint_table_contains (keys, cur->id))
+    {
+      res = true;
+      break;
+    }
+    btor_hashint_table_add (mark, cur->id);
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  BTOR_RELEASE_STACK (visit);
+  return res;
+}
+
+void
+btor_egraph_saturate (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, rounds, max_rounds, max_nodes, time_limit, num_substs;
+  uint32_t opt_simp_const;
+  uint64_t old_cost, new_cost;
+  double start, delta, deadline;
+  BtorEGraph *eg;
+  BtorPtrHashTableIterator it;
+  BtorNodePtrStack roots, terms, new_roots;
+  BtorIntHashTable *mark, *keys, *tmp;
+  BtorNode *root, *term;
+
+  if (btor->unsynthesized_constraints->count == 0) return;
+
+  BTORLOG (1, "start equality saturation");
+
+  start      = btor_util_time_stamp ();
+  max_rounds = btor_opt_get (btor, BTOR_OPT_EGRAPH);
+  max_nodes  = btor_opt_get (btor, BTOR_OPT_EGRAPH_NODES);
+  time_limit = btor_opt_get (btor, BTOR_OPT_EGRAPH_TIME);
+  deadline   = time_limit ? start + time_limit / 1000.0 : 0;
+  num_substs = 0;
+  old_cost   = 0;
+  new_cost   = 0;
+
+  /* Equalities in the e-graph must hold independently of the constraints,
+   * else a constraint could be simplified by means of itself. Hence,
+   * embedded constraints must not be rewritten to true while terms are
+   * built. */
+  opt_simp_const = btor_opt_get (btor, BTOR_OPT_SIMPLIFY_CONSTRAINTS);
+  btor_opt_set (btor, BTOR_OPT_SIMPLIFY_CONSTRAINTS, 0);
+
+  eg = new_egraph (btor);
+  BTOR_INIT_STACK (btor->mm, roots);
+  BTOR_INIT_STACK (btor->mm, terms);
+  BTOR_INIT_STACK (btor->mm, new_roots);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    root = btor_node_real_addr (btor_iter_hashptr_next (&it));
+    BTOR_PUSH_STACK (roots, root);
+    (void) add_exp (eg, root);
+  }
+
+  rounds = 0;
+  while (rounds < max_rounds && BTOR_COUNT_STACK (eg->nodes) < max_nodes
+         && (deadline == 0 || btor_util_time_stamp () < deadline))
+  {
+    rounds++;
+    if (!saturate_round (eg, max_nodes, deadline) || eg->conflict) break;
+  }
+
+  /* the e-graph is discarded and no constraint is substituted */
+  if (eg->conflict)
+  {
+    BTORLOG (1, "e-graph merged a class with its negation");
+    delete_egraph (eg);
+    btor_opt_set (btor, BTOR_OPT_SIMPLIFY_CONSTRAINTS, opt_simp_const);
+    goto DONE;
+  }
+
+  /* extract terms with min. cost, a constraint is only substituted if its
+   * term does not contain any substituted constraint (including itself) */
+  take_snapshot (eg);
+  mark = btor_hashint_table_new (btor->mm);
+  keys = btor_hashint_table_new (btor->mm);
+  tmp  = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (roots); i++)
+  {
+    root = BTOR_PEEK_STACK (roots, i);
+    term = get_term (eg, add_exp (eg, root));
+    if (!term || term == root || btor_hashint_table_contains (keys, root->id)
+        || btor_hashint_table_contains (mark, root->id))
+    {
+      if (term) btor_node_release (btor, term);
+      term = 0;
+    }
+    else
+    {
+      btor_hashint_table_add (keys, root->id);
+      if (mark_cone (btor, term, tmp, keys))
+      {
+        btor_hashint_table_remove (keys, root->id);
+        btor_node_release (btor, term);
+        term = 0;
+      }
+      else
+        (void) mark_cone (btor, term, mark, keys);
+      btor_hashint_table_delete (tmp);
+      tmp = btor_hashint_table_new (btor->mm);
+    }
+    BTOR_PUSH_STACK (terms, term);
+    BTOR_PUSH_STACK (new_roots, term ? term : root);
+  }
+  btor_hashint_table_delete (tmp);
+  btor_hashint_table_delete (keys);
+  btor_hashint_table_delete (mark);
+  delete_egraph (eg);
+  btor_opt_set (btor, BTOR_OPT_SIMPLIFY_CONSTRAINTS, opt_simp_const);
+
+  old_cost = dag_cost (btor, &roots);
+  new_cost = dag_cost (btor, &new_roots);
+  if (new_cost < old_cost)
+  {
+    btor_init_substitutions (btor);
+    for (i = 0; i < BTOR_COUNT_STACK (roots); i++)
+    {
+      if (!(term = BTOR_PEEK_STACK (terms, i))) continue;
+      btor_insert_substitution (btor, BTOR_PEEK_STACK (roots, i), term, false);
+      num_substs++;
+    }
+    btor_substitute_and_rebuild (btor, btor->substitutions);
+    btor_delete_substitutions (btor);
+  }
+
+DONE:
+  for (i = 0; i < BTOR_COUNT_STACK (terms); i++)
+    if ((term = BTOR_PEEK_STACK (terms, i))) btor_node_release (btor, term);
+  BTOR_RELEASE_STACK (new_roots);
+  BTOR_RELEASE_STACK (terms);
+  BTOR_RELEASE_STACK (roots);
+
+  btor->stats.egraph_rounds += rounds;
+  btor->stats.egraph_substitutions += num_substs;
+  delta = btor_util_time_stamp () - start;
+  btor->time.egraph += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "equality saturation: %u rounds, %u constraints substituted, "
+            "cost %" PRIu64 " -> %" PRIu64 " in %.1f seconds",
+            rounds,
+            num_substs,
+            old_cost,
+            new_cost < old_cost ? new_cost : old_cost,
+            delta);
+  BTORLOG (1, "end equality saturation");
+}
@@ -0,0 +1,19 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTOREGRAPH_H_INCLUDED
+#define BTOREGRAPH_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Equality saturation on an e-graph of the bit-vector part of the
+ * (unsynthesized) constraints. Constraints are replaced by the extracted
+ * terms if this reduces the estimated AIG size of the formula. */
+void btor_egraph_saturate (Btor* btor);
+
+#endif
@@ -110,8 +110,9 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
   BtorNodeIterator it;
   BtorPtrHashTable *slices;
   int32_t i;
-  uint32_t min, max, count;
+  uint32_t min, max, count, frozen;
   BtorNodePtrStack vars;
+  bool incremental;
   double start, delta;
   BtorMemMgr *mm;
   uint32_t vals[4];
@@ -119,7 +120,11 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
   assert (btor != NULL);
 
   start = btor_util_time_stamp ();
-  count = 0;
+  count  = 0;
+  frozen = 0;
+
+  incremental = btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+                && btor_opt_get (btor, BTOR_OPT_INCREMENTAL_PREPROC);
 
   BTORLOG (1, "start slice elimination");
 
@@ -127,11 +132,28 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
   BTOR_INIT_STACK (mm, vars);
   for (b_var = btor->bv_vars->first; b_var != NULL; b_var = b_var->next)
   {
-    if (b_var->data.flag) continue;
     var = (BtorNode *) b_var->key;
+    if (incremental)
+    {
+      /* Variables that are already encoded into the SAT solver are frozen,
+       * splitting them would discard their encoding and the information
+       * learned about them in previous calls. All other variables are
+       * reconsidered on every call since slices on them may have been
+       * added in the meantime. */
+      if (btor_node_is_synth (var))
+      {
+        frozen++;
+        continue;
+      }
+      if (btor_node_is_simplified (var)) continue;
+    }
+    else
+    {
+      if (b_var->data.flag) continue;
+      /* mark as processed, required for non-destructive substiution */
+      b_var->data.flag = true;
+    }
     BTOR_PUSH_STACK (vars, var);
-    /* mark as processed, required for non-destructive substiution */
-    b_var->data.flag = true;
   }
 
   while (!BTOR_EMPTY_STACK (vars))
@@ -321,4 +343,6 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
   btor->time.slicing += delta;
   BTORLOG (1, "end slice elimination");
   BTOR_MSG (btor->msg, 1, "sliced %u variables in %1.f seconds", count, delta);
+  if (incremental)
+    BTOR_MSG (btor->msg, 1, "%u frozen variables not sliced", frozen);
 }
@@ -0,0 +1,1178 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorknownbits.h"
+
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btorsubst.h"
+#include "utils/btorhashint.h"
+#include "utils/btorutil.h"
+
+/*------------------------------------------------------------------------*/
+
+/* Bit i of a term is known to be 1 if it is set in 'lo' and known to be 0 if
+ * it is not set in 'hi', else it is unknown. Bits with lo = 1 and hi = 0 are
+ * a conflict. */
+struct BtorKnownBits
+{
+  BtorBitVector *lo;
+  BtorBitVector *hi;
+};
+
+typedef struct BtorKnownBits BtorKnownBits;
+
+struct BtorKBContext
+{
+  Btor *btor;
+  BtorMemMgr *mm;
+  BtorIntHashTable *bits; /* maps node ids to BtorKnownBits */
+  bool changed;
+  bool conflict;
+};
+
+#define KB_UNKNOWN 2
+
+/*------------------------------------------------------------------------*/
+
+static void
+init_context (BtorKBContext *ctx, Btor *btor)
+{
+  ctx->btor     = btor;
+  ctx->mm       = btor->mm;
+  ctx->bits     = btor_hashint_map_new (btor->mm);
+  ctx->changed  = false;
+  ctx->conflict = false;
+}
+
+static void
+release_context (BtorKBContext *ctx)
+{
+  uint32_t i;
+  BtorKnownBits *kb;
+
+  for (i = 0; i < ctx->bits->size; i++)
+  {
+    if (!ctx->bits->keys[i]) continue;
+    kb = ctx->bits->data[i].as_ptr;
+    btor_bv_free (ctx->mm, kb->lo);
+    btor_bv_free (ctx->mm, kb->hi);
+    BTOR_DELETE (ctx->mm, kb);
+  }
+  btor_hashint_map_delete (ctx->bits);
+}
+
+/* Get the known bits of a regular node, which are initialized to the value
+ * of constants and to unknown for all other nodes. */
+static BtorKnownBits *
+get_known_bits (BtorKBContext *ctx, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t width;
+  BtorHashTableData *d;
+  BtorKnownBits *kb;
+
+  if ((d = btor_hashint_map_get (ctx->bits, exp->id))) return d->as_ptr;
+
+  BTOR_NEW (ctx->mm, kb);
+  if (btor_node_is_bv_const (exp))
+  {
+    kb->lo = btor_bv_copy (ctx->mm, btor_node_bv_const_get_bits (exp));
+    kb->hi = btor_bv_copy (ctx->mm, kb->lo);
+  }
+  else
+  {
+    width  = btor_node_bv_get_width (ctx->btor, exp);
+    kb->lo = btor_bv_new (ctx->mm, width);
+    kb->hi = btor_bv_ones (ctx->mm, width);
+  }
+  btor_hashint_map_add (ctx->bits, exp->id)->as_ptr = kb;
+  return kb;
+}
+
+/* Copy the known bits of 'exp', which may be inverted. */
+static void
+get_bits (BtorKBContext *ctx,
+          BtorNode *exp,
+          BtorBitVector **lo,
+          BtorBitVector **hi)
+{
+  BtorKnownBits *kb;
+
+  kb = get_known_bits (ctx, btor_node_real_addr (exp));
+  if (btor_node_is_inverted (exp))
+  {
+    *lo = btor_bv_not (ctx->mm, kb->hi);
+    *hi = btor_bv_not (ctx->mm, kb->lo);
+  }
+  else
+  {
+    *lo = btor_bv_copy (ctx->mm, kb->lo);
+    *hi = btor_bv_copy (ctx->mm, kb->hi);
+  }
+}
+
+static void
+free_bits (BtorKBContext *ctx, BtorBitVector *lo, BtorBitVector *hi)
+{
+  btor_bv_free (ctx->mm, lo);
+  btor_bv_free (ctx->mm, hi);
+}
+
+/* Refine the known bits of 'exp' with given bits (in the polarity of 'exp'),
+ * takes ownership of 'lo' and 'hi'. */
+static void
+meet (BtorKBContext *ctx, BtorNode *exp, BtorBitVector *lo, BtorBitVector *hi)
+{
+  BtorBitVector *tmp, *nlo, *nhi, *clash;
+  BtorKnownBits *kb;
+
+  kb = get_known_bits (ctx, btor_node_real_addr (exp));
+  if (btor_node_is_inverted (exp))
+  {
+    tmp = btor_bv_not (ctx->mm, lo);
+    btor_bv_free (ctx->mm, lo);
+    lo = btor_bv_not (ctx->mm, hi);
+    btor_bv_free (ctx->mm, hi);
+    hi = tmp;
+  }
+  nlo = btor_bv_or (ctx->mm, kb->lo, lo);
+  nhi = btor_bv_and (ctx->mm, kb->hi, hi);
+  free_bits (ctx, lo, hi);
+
+  if (btor_bv_compare (nlo, kb->lo) || btor_bv_compare (nhi, kb->hi))
+  {
+    tmp   = btor_bv_not (ctx->mm, nhi);
+    clash = btor_bv_and (ctx->mm, nlo, tmp);
+    if (!btor_bv_is_zero (clash))
+    {
+      ctx->conflict = true;
+    }
+    btor_bv_free (ctx->mm, tmp);
+    btor_bv_free (ctx->mm, clash);
+    free_bits (ctx, kb->lo, kb->hi);
+    kb->lo       = nlo;
+    kb->hi       = nhi;
+    ctx->changed = true;
+  }
+  else
+    free_bits (ctx, nlo, nhi);
+}
+
+static bool
+is_fixed (const BtorBitVector *lo, const BtorBitVector *hi)
+{
+  return btor_bv_compare (lo, hi) == 0;
+}
+
+static bool
+has_fixed_bits (BtorKBContext *ctx,
+                const BtorBitVector *lo,
+                const BtorBitVector *hi)
+{
+  bool res;
+  BtorBitVector *tmp;
+
+  /* hi = ones and lo = zero if nothing is known */
+  tmp = btor_bv_xor (ctx->mm, lo, hi);
+  res = !btor_bv_is_ones (tmp);
+  btor_bv_free (ctx->mm, tmp);
+  return res;
+}
+
+static uint32_t
+get_bit (const BtorBitVector *lo, const BtorBitVector *hi, uint32_t pos)
+{
+  if (btor_bv_get_bit (lo, pos)) return 1;
+  if (!btor_bv_get_bit (hi, pos)) return 0;
+  return KB_UNKNOWN;
+}
+
+static void
+set_bit (BtorBitVector *lo, BtorBitVector *hi, uint32_t pos, uint32_t val)
+{
+  btor_bv_set_bit (lo, pos, val == 1);
+  btor_bv_set_bit (hi, pos, val != 0);
+}
+
+/* Number of consecutive known bits starting at bit 0. */
+static uint32_t
+get_num_known_low_bits (const BtorBitVector *lo, const BtorBitVector *hi)
+{
+  uint32_t i, width;
+
+  width = btor_bv_get_width (lo);
+  for (i = 0; i < width; i++)
+    if (get_bit (lo, hi, i) == KB_UNKNOWN) break;
+  return i;
+}
+
+/* Bits that are not fixed are unknown, 'lo' and 'hi' are set to all
+ * unknown bits of given width with bits [upper:lower] set to 'plo', 'phi'. */
+static void
+embed_bits (BtorKBContext *ctx,
+            const BtorBitVector *plo,
+            const BtorBitVector *phi,
+            uint32_t width,
+            uint32_t lower,
+            BtorBitVector **lo,
+            BtorBitVector **hi)
+{
+  uint32_t upper, i;
+
+  upper = lower + btor_bv_get_width (plo) - 1;
+  assert (upper < width);
+  *lo = btor_bv_new (ctx->mm, width);
+  *hi = btor_bv_ones (ctx->mm, width);
+  for (i = lower; i <= upper; i++)
+    set_bit (*lo, *hi, i, get_bit (plo, phi, i - lower));
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_kb_exp (BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  if (exp->parameterized || btor_node_is_fun (exp)) return false;
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_CONCAT_NODE: return true;
+    case BTOR_BV_EQ_NODE:
+    case BTOR_COND_NODE: return !btor_node_is_fun (exp->e[1]);
+    default: return false;
+  }
+}
+
+/* Collect the cone of the unsynthesized constraints sorted by id (children
+ * before parents). Nodes of other kinds than handled by is_kb_exp (variables,
+ * applies, ...) are leafs of the cone. */
+static void
+collect_cone (Btor *btor, BtorNodePtrStack *roots, BtorNodePtrStack *nodes)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *cache;
+  BtorPtrHashTableIterator it;
+
+  cache = btor_hashint_table_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, visit);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    if (!is_kb_exp (btor_node_real_addr (cur))) continue;
+    BTOR_PUSH_STACK (*roots, cur);
+    BTOR_PUSH_STACK (visit, cur);
+  }
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    if (btor_node_is_fun (cur) || cur->parameterized) continue;
+    BTOR_PUSH_STACK (*nodes, cur);
+    if (!is_kb_exp (cur)) continue;
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (cache);
+
+  qsort (nodes->start,
+         BTOR_COUNT_STACK (*nodes),
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+forward_add (BtorBitVector *alo,
+             BtorBitVector *ahi,
+             BtorBitVector *blo,
+             BtorBitVector *bhi,
+             BtorBitVector *lo,
+             BtorBitVector *hi)
+{
+  uint32_t i, width, a, b, c, ones, zeros;
+
+  width = btor_bv_get_width (alo);
+  c     = 0;
+  for (i = 0; i < width; i++)
+  {
+    a = get_bit (alo, ahi, i);
+    b = get_bit (blo, bhi, i);
+    if (a == KB_UNKNOWN || b == KB_UNKNOWN || c == KB_UNKNOWN)
+      set_bit (lo, hi, i, KB_UNKNOWN);
+    else
+      set_bit (lo, hi, i, a ^ b ^ c);
+    ones  = (a == 1) + (b == 1) + (c == 1);
+    zeros = (a == 0) + (b == 0) + (c == 0);
+    c     = ones >= 2 ? 1 : (zeros >= 2 ? 0 : KB_UNKNOWN);
+  }
+}
+
+/* Compute the known bits of 'exp' from the known bits of its children. */
+static void
+forward (BtorKBContext *ctx, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+  assert (is_kb_exp (exp));
+
+  uint32_t i, width, upper, lower, tz;
+  BtorBitVector *lo, *hi, *lo0, *hi0, *lo1, *hi1, *lo2, *hi2, *t0, *t1;
+  BtorMemMgr *mm;
+
+  mm    = ctx->mm;
+  width = btor_node_bv_get_width (ctx->btor, exp);
+  lo0 = hi0 = lo1 = hi1 = lo2 = hi2 = 0;
+  for (i = 0; i < exp->arity; i++)
+  {
+    if (i == 0) get_bits (ctx, exp->e[0], &lo0, &hi0);
+    if (i == 1) get_bits (ctx, exp->e[1], &lo1, &hi1);
+    if (i == 2) get_bits (ctx, exp->e[2], &lo2, &hi2);
+  }
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+      upper = btor_node_bv_slice_get_upper (exp);
+      lower = btor_node_bv_slice_get_lower (exp);
+      lo    = btor_bv_slice (mm, lo0, upper, lower);
+      hi    = btor_bv_slice (mm, hi0, upper, lower);
+      break;
+
+    case BTOR_BV_AND_NODE:
+      lo = btor_bv_and (mm, lo0, lo1);
+      hi = btor_bv_and (mm, hi0, hi1);
+      break;
+
+    case BTOR_BV_EQ_NODE:
+      /* a bit known to be 1 in one and 0 in the other operand */
+      t0 = btor_bv_not (mm, hi1);
+      t1 = btor_bv_and (mm, lo0, t0);
+      btor_bv_free (mm, t0);
+      t0 = btor_bv_not (mm, hi0);
+      lo = btor_bv_and (mm, lo1, t0);
+      btor_bv_free (mm, t0);
+      t0 = btor_bv_or (mm, lo, t1);
+      btor_bv_free (mm, t1);
+      btor_bv_free (mm, lo);
+      if (!btor_bv_is_zero (t0))
+      {
+        lo = btor_bv_new (mm, 1);
+        hi = btor_bv_new (mm, 1);
+      }
+      else if (is_fixed (lo0, hi0) && is_fixed (lo1, hi1))
+      {
+        lo = btor_bv_one (mm, 1);
+        hi = btor_bv_one (mm, 1);
+      }
+      else
+      {
+        lo = btor_bv_new (mm, 1);
+        hi = btor_bv_one (mm, 1);
+      }
+      btor_bv_free (mm, t0);
+      break;
+
+    case BTOR_BV_ADD_NODE:
+      lo = btor_bv_new (mm, width);
+      hi = btor_bv_ones (mm, width);
+      forward_add (lo0, hi0, lo1, hi1, lo, hi);
+      break;
+
+    case BTOR_BV_MUL_NODE:
+      if (is_fixed (lo0, hi0) && is_fixed (lo1, hi1))
+      {
+        lo = btor_bv_mul (mm, lo0, lo1);
+        hi = btor_bv_copy (mm, lo);
+      }
+      else
+      {
+        /* trailing zeros of the operands add up */
+        tz = btor_bv_get_num_trailing_zeros (hi0)
+             + btor_bv_get_num_trailing_zeros (hi1);
+        lo = btor_bv_new (mm, width);
+        t0 = btor_bv_ones (mm, width);
+        hi = btor_bv_sll_uint64 (mm, t0, tz < width ? tz : width);
+        btor_bv_free (mm, t0);
+        if (btor_bv_get_bit (lo0, 0) && btor_bv_get_bit (lo1, 0))
+          set_bit (lo, hi, 0, 1);
+      }
+      break;
+
+    case BTOR_BV_ULT_NODE:
+      if (btor_bv_compare (hi0, lo1) < 0)
+      {
+        lo = btor_bv_one (mm, 1);
+        hi = btor_bv_one (mm, 1);
+      }
+      else if (btor_bv_compare (lo0, hi1) >= 0)
+      {
+        lo = btor_bv_new (mm, 1);
+        hi = btor_bv_new (mm, 1);
+      }
+      else
+      {
+        lo = btor_bv_new (mm, 1);
+        hi = btor_bv_one (mm, 1);
+      }
+      break;
+
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+      if (is_fixed (lo1, hi1))
+      {
+        if (exp->kind == BTOR_BV_SLL_NODE)
+        {
+          lo = btor_bv_sll (mm, lo0, lo1);
+          hi = btor_bv_sll (mm, hi0, lo1);
+        }
+        else
+        {
+          lo = btor_bv_srl (mm, lo0, lo1);
+          hi = btor_bv_srl (mm, hi0, lo1);
+        }
+      }
+      else
+      {
+        /* trailing (leading) zeros are kept by sll (srl) */
+        lo = btor_bv_new (mm, width);
+        t0 = btor_bv_ones (mm, width);
+        if (exp->kind == BTOR_BV_SLL_NODE)
+          hi = btor_bv_sll_uint64 (
+              mm, t0, btor_bv_get_num_trailing_zeros (hi0));
+        else
+          hi = btor_bv_srl_uint64 (
+              mm, t0, btor_bv_get_num_leading_zeros (hi0));
+        btor_bv_free (mm, t0);
+      }
+      break;
+
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+      if (is_fixed (lo0, hi0) && is_fixed (lo1, hi1))
+      {
+        lo = exp->kind == BTOR_BV_UDIV_NODE ? btor_bv_udiv (mm, lo0, lo1)
+                                            : btor_bv_urem (mm, lo0, lo1);
+        hi = btor_bv_copy (mm, lo);
+      }
+      else
+      {
+        /* the result is at most the dividend, except for udiv by zero */
+        lo = btor_bv_new (mm, width);
+        t0 = btor_bv_ones (mm, width);
+        if (exp->kind == BTOR_BV_UREM_NODE || !btor_bv_is_zero (lo1))
+          hi = btor_bv_srl_uint64 (
+              mm, t0, btor_bv_get_num_leading_zeros (hi0));
+        else
+          hi = btor_bv_copy (mm, t0);
+        btor_bv_free (mm, t0);
+      }
+      break;
+
+    case BTOR_BV_CONCAT_NODE:
+      lo = btor_bv_concat (mm, lo0, lo1);
+      hi = btor_bv_concat (mm, hi0, hi1);
+      break;
+
+    default:
+      assert (exp->kind == BTOR_COND_NODE);
+      if (is_fixed (lo0, hi0))
+      {
+        lo = btor_bv_copy (mm, btor_bv_is_true (lo0) ? lo1 : lo2);
+        hi = btor_bv_copy (mm, btor_bv_is_true (lo0) ? hi1 : hi2);
+      }
+      else
+      {
+        lo = btor_bv_and (mm, lo1, lo2);
+        hi = btor_bv_or (mm, hi1, hi2);
+      }
+  }
+
+  if (lo0) free_bits (ctx, lo0, hi0);
+  if (lo1) free_bits (ctx, lo1, hi1);
+  if (lo2) free_bits (ctx, lo2, hi2);
+  meet (ctx, exp, lo, hi);
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Given the known bits of the result and of operand 'a' of an addition,
+ * compute the low bits of the other operand as (r - a) on the common prefix
+ * of known low bits. */
+static void
+backward_add (BtorKBContext *ctx,
+              BtorBitVector *rlo,
+              BtorBitVector *rhi,
+              BtorNode *a,
+              BtorNode *b)
+{
+  uint32_t i, k, width, r, x, borrow;
+  BtorBitVector *alo, *ahi, *lo, *hi;
+
+  get_bits (ctx, a, &alo, &ahi);
+  k = get_num_known_low_bits (rlo, rhi);
+  i = get_num_known_low_bits (alo, ahi);
+  k = i < k ? i : k;
+  if (k > 0)
+  {
+    width  = btor_bv_get_width (rlo);
+    lo     = btor_bv_new (ctx->mm, width);
+    hi     = btor_bv_ones (ctx->mm, width);
+    borrow = 0;
+    for (i = 0; i < k; i++)
+    {
+      r = get_bit (rlo, rhi, i);
+      x = get_bit (alo, ahi, i);
+      set_bit (lo, hi, i, r ^ x ^ borrow);
+      borrow = (!r && x) || (!(r ^ x) && borrow);
+    }
+    meet (ctx, b, lo, hi);
+  }
+  free_bits (ctx, alo, ahi);
+}
+
+/* Propagate the known bits of 'exp' to its children. */
+static void
+backward (BtorKBContext *ctx, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+  assert (is_kb_exp (exp));
+
+  uint32_t i, j, width, lower, w0, w1, unknown, pos;
+  BtorBitVector *plo, *phi, *lo0, *hi0, *lo1, *hi1, *lo, *hi, *t0, *t1;
+  BtorBitVector *ones, *mask;
+  BtorNode *e;
+  BtorMemMgr *mm;
+
+  mm    = ctx->mm;
+  width = btor_node_bv_get_width (ctx->btor, exp);
+  get_bits (ctx, exp, &plo, &phi);
+
+  if (!has_fixed_bits (ctx, plo, phi)) goto DONE;
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+      lower = btor_node_bv_slice_get_lower (exp);
+      embed_bits (ctx,
+                  plo,
+                  phi,
+                  btor_node_bv_get_width (ctx->btor, exp->e[0]),
+                  lower,
+                  &lo,
+                  &hi);
+      meet (ctx, exp->e[0], lo, hi);
+      break;
+
+    case BTOR_BV_AND_NODE:
+      /* 1 in the result implies 1 in both operands, 0 in the result and 1
+       * in one operand implies 0 in the other operand */
+      for (i = 0; i < 2; i++)
+      {
+        get_bits (ctx, exp->e[1 - i], &lo1, &hi1);
+        t0 = btor_bv_not (mm, lo1);
+        hi = btor_bv_or (mm, phi, t0);
+        btor_bv_free (mm, t0);
+        free_bits (ctx, lo1, hi1);
+        meet (ctx, exp->e[i], btor_bv_copy (mm, plo), hi);
+      }
+      break;
+
+    case BTOR_BV_EQ_NODE:
+      get_bits (ctx, exp->e[0], &lo0, &hi0);
+      get_bits (ctx, exp->e[1], &lo1, &hi1);
+      if (btor_bv_is_true (plo))
+      {
+        meet (ctx, exp->e[0], btor_bv_copy (mm, lo1), btor_bv_copy (mm, hi1));
+        meet (ctx, exp->e[1], btor_bv_copy (mm, lo0), btor_bv_copy (mm, hi0));
+      }
+      else
+      {
+        /* if one operand is fixed and all but one bit of the other operand
+         * are known and equal, the remaining bit must differ */
+        for (i = 0; i < 2; i++)
+        {
+          t0 = i == 0 ? lo0 : lo1;
+          t1 = i == 0 ? hi0 : hi1;
+          lo = i == 0 ? lo1 : lo0;
+          hi = i == 0 ? hi1 : hi0;
+          if (!is_fixed (t0, t1)) continue;
+          w0      = btor_bv_get_width (t0);
+          unknown = 0;
+          pos     = 0;
+          for (j = 0; j < w0 && unknown < 2; j++)
+          {
+            if (get_bit (lo, hi, j) == KB_UNKNOWN)
+            {
+              unknown++;
+              pos = j;
+            }
+            else if (get_bit (lo, hi, j) != btor_bv_get_bit (t0, j))
+              break;
+          }
+          if (j < w0 || unknown != 1) continue;
+          e  = exp->e[1 - i];
+          lo = btor_bv_new (mm, w0);
+          hi = btor_bv_ones (mm, w0);
+          set_bit (lo, hi, pos, !btor_bv_get_bit (t0, pos));
+          meet (ctx, e, lo, hi);
+          break;
+        }
+      }
+      free_bits (ctx, lo0, hi0);
+      free_bits (ctx, lo1, hi1);
+      break;
+
+    case BTOR_BV_ADD_NODE:
+      backward_add (ctx, plo, phi, exp->e[0], exp->e[1]);
+      backward_add (ctx, plo, phi, exp->e[1], exp->e[0]);
+      break;
+
+    case BTOR_BV_MUL_NODE:
+      /* an odd product requires odd operands */
+      if (btor_bv_get_bit (plo, 0))
+      {
+        for (i = 0; i < 2; i++)
+        {
+          lo = btor_bv_new (mm, width);
+          hi = btor_bv_ones (mm, width);
+          set_bit (lo, hi, 0, 1);
+          meet (ctx, exp->e[i], lo, hi);
+        }
+      }
+      break;
+
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+      get_bits (ctx, exp->e[1], &lo1, &hi1);
+      if (is_fixed (lo1, hi1))
+      {
+        /* bits shifted out of the operand are unknown */
+        ones = btor_bv_ones (mm, width);
+        if (exp->kind == BTOR_BV_SLL_NODE)
+        {
+          lo   = btor_bv_srl (mm, plo, lo1);
+          t0   = btor_bv_srl (mm, phi, lo1);
+          mask = btor_bv_srl (mm, ones, lo1);
+        }
+        else
+        {
+          lo   = btor_bv_sll (mm, plo, lo1);
+          t0   = btor_bv_sll (mm, phi, lo1);
+          mask = btor_bv_sll (mm, ones, lo1);
+        }
+        t1 = btor_bv_not (mm, mask);
+        hi = btor_bv_or (mm, t0, t1);
+        btor_bv_free (mm, t0);
+        btor_bv_free (mm, t1);
+        btor_bv_free (mm, mask);
+        btor_bv_free (mm, ones);
+        meet (ctx, exp->e[0], lo, hi);
+      }
+      free_bits (ctx, lo1, hi1);
+      break;
+
+    case BTOR_BV_CONCAT_NODE:
+      w1 = btor_node_bv_get_width (ctx->btor, exp->e[1]);
+      meet (ctx,
+            exp->e[0],
+            btor_bv_slice (mm, plo, width - 1, w1),
+            btor_bv_slice (mm, phi, width - 1, w1));
+      meet (ctx,
+            exp->e[1],
+            btor_bv_slice (mm, plo, w1 - 1, 0),
+            btor_bv_slice (mm, phi, w1 - 1, 0));
+      break;
+
+    case BTOR_COND_NODE:
+      get_bits (ctx, exp->e[0], &lo0, &hi0);
+      if (is_fixed (lo0, hi0))
+      {
+        e = btor_bv_is_true (lo0) ? exp->e[1] : exp->e[2];
+        meet (ctx, e, btor_bv_copy (mm, plo), btor_bv_copy (mm, phi));
+      }
+      else
+      {
+        /* a branch that contradicts the result is not taken */
+        for (i = 1; i < 3; i++)
+        {
+          get_bits (ctx, exp->e[i], &lo1, &hi1);
+          t0 = btor_bv_not (mm, phi);
+          t1 = btor_bv_and (mm, lo1, t0);
+          btor_bv_free (mm, t0);
+          t0 = btor_bv_not (mm, hi1);
+          lo = btor_bv_and (mm, plo, t0);
+          btor_bv_free (mm, t0);
+          t0 = btor_bv_or (mm, t1, lo);
+          btor_bv_free (mm, t1);
+          btor_bv_free (mm, lo);
+          free_bits (ctx, lo1, hi1);
+          if (!btor_bv_is_zero (t0))
+          {
+            btor_bv_free (mm, t0);
+            lo = btor_bv_new (mm, 1);
+            hi = btor_bv_new (mm, 1);
+            btor_bv_set_bit (lo, 0, i == 2);
+            btor_bv_set_bit (hi, 0, i == 2);
+            meet (ctx, exp->e[0], lo, hi);
+            e = exp->e[i == 1 ? 2 : 1];
+            meet (ctx, e, btor_bv_copy (mm, plo), btor_bv_copy (mm, phi));
+            break;
+          }
+          btor_bv_free (mm, t0);
+        }
+      }
+      free_bits (ctx, lo0, hi0);
+      break;
+
+    default: break;
+  }
+
+DONE:
+  free_bits (ctx, plo, phi);
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Build the concatenation of the runs of known and unknown bits of a term of
+ * given width from the most significant bit down. Known runs are constants,
+ * unknown runs [upper:lower] are created by 'mk_run'. */
+static BtorNode *
+mk_runs (Btor *btor,
+         BtorBitVector *lo,
+         BtorBitVector *hi,
+         BtorNode *(*mk_run) (Btor *, void *, uint32_t, uint32_t),
+         void *state)
+{
+  uint32_t upper, lower, width;
+  bool known;
+  BtorNode *res, *run, *tmp;
+  BtorBitVector *bits;
+
+  width = btor_bv_get_width (lo);
+  res   = 0;
+  upper = width - 1;
+  for (;;)
+  {
+    known = get_bit (lo, hi, upper) != KB_UNKNOWN;
+    lower = upper;
+    while (lower > 0
+           && (get_bit (lo, hi, lower - 1) != KB_UNKNOWN) == known)
+      lower--;
+    if (known)
+    {
+      bits = btor_bv_slice (btor->mm, lo, upper, lower);
+      run  = btor_exp_bv_const (btor, bits);
+      btor_bv_free (btor->mm, bits);
+    }
+    else
+      run = mk_run (btor, state, upper, lower);
+    if (res)
+    {
+      tmp = btor_exp_bv_concat (btor, res, run);
+      btor_node_release (btor, res);
+      btor_node_release (btor, run);
+      res = tmp;
+    }
+    else
+      res = run;
+    if (lower == 0) break;
+    upper = lower - 1;
+  }
+  return res;
+}
+
+static BtorNode *
+mk_fresh_var (Btor *btor, void *state, uint32_t upper, uint32_t lower)
+{
+  BtorSortId sort;
+  BtorNode *res;
+
+  (void) state;
+  sort = btor_sort_bv (btor, upper - lower + 1);
+  res  = btor_exp_var (btor, sort, 0);
+  btor_sort_release (btor, sort);
+  return res;
+}
+
+static BtorNode *
+mk_narrow_exp (Btor *btor, void *state, uint32_t upper, uint32_t lower)
+{
+  uint32_t i;
+  BtorNode *exp, *e[3], *res;
+
+  exp = state;
+  assert (btor_node_is_regular (exp));
+  assert (btor_node_is_bv_and (exp) || btor_node_is_bv_cond (exp));
+
+  for (i = 0; i < exp->arity; i++)
+  {
+    if (btor_node_is_bv_cond (exp) && i == 0)
+      e[i] = btor_node_copy (btor, exp->e[0]);
+    else
+      e[i] = btor_exp_bv_slice (btor, exp->e[i], upper, lower);
+  }
+  if (btor_node_is_bv_and (exp))
+    res = btor_exp_bv_and (btor, e[0], e[1]);
+  else
+    res = btor_exp_cond (btor, e[0], e[1], e[2]);
+  for (i = 0; i < exp->arity; i++) btor_node_release (btor, e[i]);
+  return res;
+}
+
+/* Assert the known slices of a variable that is already encoded into the SAT
+ * solver. */
+static void
+assert_known_slices (Btor *btor,
+                     BtorNode *var,
+                     BtorBitVector *lo,
+                     BtorBitVector *hi)
+{
+  uint32_t upper, lower;
+  BtorBitVector *bits;
+  BtorNode *slice, *val, *eq;
+
+  upper = btor_bv_get_width (lo);
+  while (upper > 0)
+  {
+    upper--;
+    if (get_bit (lo, hi, upper) == KB_UNKNOWN) continue;
+    lower = upper;
+    while (lower > 0 && get_bit (lo, hi, lower - 1) != KB_UNKNOWN) lower--;
+    bits  = btor_bv_slice (btor->mm, lo, upper, lower);
+    val   = btor_exp_bv_const (btor, bits);
+    slice = btor_exp_bv_slice (btor, var, upper, lower);
+    eq    = btor_exp_eq (btor, slice, val);
+    btor_assert_exp (btor, eq);
+    btor_node_release (btor, eq);
+    btor_node_release (btor, slice);
+    btor_node_release (btor, val);
+    btor_bv_free (btor->mm, bits);
+    upper = lower;
+  }
+}
+
+/* Get an equivalent term for 'exp' based on its known bits, or 0. Fixed terms
+ * are replaced by constants, and/ite by the concatenation of their known and
+ * narrowed unknown bits, add/mul with known low zero bits of an operand by
+ * the narrower operation on the remaining bits. */
+static BtorNode *
+mk_subst (BtorKBContext *ctx, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t width, k, tz0, tz1;
+  BtorBitVector *lo, *hi, *lo0, *hi0, *lo1, *hi1;
+  BtorNode *res, *a, *b, *ahi, *bhi, *blo, *op;
+  BtorSortId sort;
+  Btor *btor;
+
+  btor  = ctx->btor;
+  width = btor_node_bv_get_width (btor, exp);
+  res   = 0;
+  get_bits (ctx, exp, &lo, &hi);
+
+  if (is_fixed (lo, hi))
+  {
+    res = btor_exp_bv_const (btor, lo);
+  }
+  else if (btor_node_is_bv_and (exp) || btor_node_is_bv_cond (exp))
+  {
+    if (has_fixed_bits (ctx, lo, hi))
+      res = mk_runs (btor, lo, hi, mk_narrow_exp, exp);
+  }
+  else if ((btor_node_is_bv_add (exp) || btor_node_is_bv_mul (exp))
+           && width > 1)
+  {
+    get_bits (ctx, exp->e[0], &lo0, &hi0);
+    get_bits (ctx, exp->e[1], &lo1, &hi1);
+    tz0 = btor_bv_get_num_trailing_zeros (hi0);
+    tz1 = btor_bv_get_num_trailing_zeros (hi1);
+    a   = tz0 >= tz1 ? exp->e[0] : exp->e[1];
+    b   = tz0 >= tz1 ? exp->e[1] : exp->e[0];
+    k   = tz0 >= tz1 ? tz0 : tz1;
+    if (k > 0 && k < width)
+    {
+      ahi = btor_exp_bv_slice (btor, a, width - 1, k);
+      if (btor_node_is_bv_add (exp))
+      {
+        /* a[k-1:0] = 0: a + b = (a[w-1:k] + b[w-1:k]) :: b[k-1:0] */
+        bhi = btor_exp_bv_slice (btor, b, width - 1, k);
+        blo = btor_exp_bv_slice (btor, b, k - 1, 0);
+        op  = btor_exp_bv_add (btor, ahi, bhi);
+        res = btor_exp_bv_concat (btor, op, blo);
+      }
+      else
+      {
+        /* a[k-1:0] = 0: a * b = (a[w-1:k] * b[w-k-1:0]) :: 0 */
+        bhi  = btor_exp_bv_slice (btor, b, width - k - 1, 0);
+        sort = btor_sort_bv (btor, k);
+        blo  = btor_exp_bv_zero (btor, sort);
+        btor_sort_release (btor, sort);
+        op   = btor_exp_bv_mul (btor, ahi, bhi);
+        res  = btor_exp_bv_concat (btor, op, blo);
+      }
+      btor_node_release (btor, op);
+      btor_node_release (btor, blo);
+      btor_node_release (btor, bhi);
+      btor_node_release (btor, ahi);
+    }
+    free_bits (ctx, lo0, hi0);
+    free_bits (ctx, lo1, hi1);
+  }
+
+  free_bits (ctx, lo, hi);
+  if (res == exp)
+  {
+    btor_node_release (btor, res);
+    res = 0;
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+BtorKBContext *
+btor_known_bits_new_context (Btor *btor)
+{
+  assert (btor);
+
+  BtorKBContext *res;
+
+  BTOR_NEW (btor->mm, res);
+  init_context (res, btor);
+  return res;
+}
+
+void
+btor_known_bits_delete_context (BtorKBContext *ctx)
+{
+  assert (ctx);
+
+  BtorMemMgr *mm;
+
+  mm = ctx->mm;
+  release_context (ctx);
+  BTOR_DELETE (mm, ctx);
+}
+
+void
+btor_known_bits_get (BtorKBContext *ctx,
+                     BtorNode *exp,
+                     BtorBitVector **lo,
+                     BtorBitVector **hi)
+{
+  assert (ctx);
+  assert (exp);
+  assert (lo);
+  assert (hi);
+
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *mark;
+
+  mark = btor_hashint_table_new (ctx->mm);
+  BTOR_INIT_STACK (ctx->mm, visit);
+  BTOR_PUSH_STACK (visit, btor_node_real_addr (exp));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_map_contains (ctx->bits, cur->id)) continue;
+    if (!btor_hashint_table_contains (mark, cur->id))
+    {
+      btor_hashint_table_add (mark, cur->id);
+      BTOR_PUSH_STACK (visit, cur);
+      if (!is_kb_exp (cur)) continue;
+      for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+    }
+    else if (is_kb_exp (cur))
+      forward (ctx, cur);
+    else
+      (void) get_known_bits (ctx, cur);
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (mark);
+
+  get_bits (ctx, exp, lo, hi);
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_propagate_known_bits (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, rounds, max_rounds, num_vars, num_substs;
+  double start, delta;
+  bool opt_simp_const;
+  BtorNodePtrStack roots, nodes, vars;
+  BtorKBContext ctx, fwd;
+  BtorKnownBits *kb;
+  BtorBitVector *lo, *hi;
+  BtorNode *cur, *subst, *eq;
+
+  if (btor->unsynthesized_constraints->count == 0) return;
+  if (btor->quantifiers->count) return;
+
+  BTORLOG (1, "start known bits propagation");
+
+  start      = btor_util_time_stamp ();
+  max_rounds = btor_opt_get (btor, BTOR_OPT_KNOWN_BITS);
+  num_vars   = 0;
+  num_substs = 0;
+
+  BTOR_INIT_STACK (btor->mm, roots);
+  BTOR_INIT_STACK (btor->mm, nodes);
+  BTOR_INIT_STACK (btor->mm, vars);
+  collect_cone (btor, &roots, &nodes);
+
+  /* Compute the bits implied by the constraints. These only hold in the
+   * models of the constraints, hence terms must not be substituted based on
+   * them (this would allow to simplify a constraint by means of itself). */
+  init_context (&ctx, btor);
+  for (i = 0; i < BTOR_COUNT_STACK (roots); i++)
+  {
+    cur = BTOR_PEEK_STACK (roots, i);
+    meet (&ctx, cur, btor_bv_one (btor->mm, 1), btor_bv_one (btor->mm, 1));
+  }
+  rounds      = 0;
+  ctx.changed = true;
+  while (ctx.changed && !ctx.conflict && rounds < max_rounds)
+  {
+    rounds++;
+    ctx.changed = false;
+    for (i = 0; i < BTOR_COUNT_STACK (nodes) && !ctx.conflict; i++)
+    {
+      cur = BTOR_PEEK_STACK (nodes, i);
+      if (is_kb_exp (cur)) forward (&ctx, cur);
+    }
+    for (i = BTOR_COUNT_STACK (nodes); i > 0 && !ctx.conflict; i--)
+    {
+      cur = BTOR_PEEK_STACK (nodes, i - 1);
+      if (is_kb_exp (cur)) backward (&ctx, cur);
+    }
+  }
+
+  if (ctx.conflict)
+  {
+    BTORLOG (1, "formula inconsistent after known bits propagation");
+    btor->inconsistent = true;
+    goto DONE;
+  }
+
+  /* Bits of variables implied by the constraints are fixed by splitting the
+   * variables into constants and fresh variables. Based on these, the bits
+   * of all terms are computed bottom-up, which hold independently of the
+   * constraints. Variables that are already encoded into the SAT solver are
+   * not split (see btorelimslices.c), their known bits are added as
+   * constraints on slices instead. */
+  init_context (&fwd, btor);
+  for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (nodes, i);
+    if (is_kb_exp (cur))
+      forward (&fwd, cur);
+    else if (btor_node_is_bv_var (cur))
+    {
+      get_bits (&ctx, cur, &lo, &hi);
+      if (has_fixed_bits (&ctx, lo, hi))
+      {
+        BTOR_PUSH_STACK (vars, cur);
+        if (!btor_node_is_synth (cur))
+        {
+          meet (&fwd, cur, lo, hi);
+          continue;
+        }
+      }
+      free_bits (&ctx, lo, hi);
+    }
+  }
+
+  /* Embedded constraints must not be rewritten to true while terms are
+   * built, since the substituted terms must not depend on the constraints
+   * (see btoregraph.c). */
+  opt_simp_const = btor_opt_get (btor, BTOR_OPT_SIMPLIFY_CONSTRAINTS);
+  btor_opt_set (btor, BTOR_OPT_SIMPLIFY_CONSTRAINTS, 0);
+
+  btor_init_substitutions (btor);
+  for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (nodes, i);
+    if (!is_kb_exp (cur) || btor_node_is_synth (cur)) continue;
+    if (!(subst = mk_subst (&fwd, cur))) continue;
+    BTORLOG (2,
+             "known bits: %s -> %s",
+             btor_util_node2string (cur),
+             btor_util_node2string (subst));
+    btor_insert_substitution (btor, cur, subst, false);
+    btor_node_release (btor, subst);
+    num_substs++;
+  }
+  btor_opt_set (btor, BTOR_OPT_SIMPLIFY_CONSTRAINTS, opt_simp_const);
+  btor_substitute_and_rebuild (btor, btor->substitutions);
+  btor_delete_substitutions (btor);
+
+  for (i = 0; i < BTOR_COUNT_STACK (vars) && !btor->inconsistent; i++)
+  {
+    cur = BTOR_PEEK_STACK (vars, i);
+    kb  = get_known_bits (&ctx, cur);
+    if (btor_node_is_synth (cur))
+      assert_known_slices (btor, cur, kb->lo, kb->hi);
+    else
+    {
+      subst = mk_runs (btor, kb->lo, kb->hi, mk_fresh_var, 0);
+      eq    = btor_exp_eq (btor, cur, subst);
+      btor_assert_exp (btor, eq);
+      btor_node_release (btor, eq);
+      btor_node_release (btor, subst);
+      num_vars++;
+    }
+  }
+  release_context (&fwd);
+
+DONE:
+  release_context (&ctx);
+  BTOR_RELEASE_STACK (vars);
+  BTOR_RELEASE_STACK (nodes);
+  BTOR_RELEASE_STACK (roots);
+
+  btor->stats.known_bits_vars += num_vars;
+  btor->stats.known_bits_substs += num_substs;
+  delta = btor_util_time_stamp () - start;
+  btor->time.known_bits += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "known bits: %u rounds, %u variables split, %u terms substituted "
+            "in %.1f seconds",
+            rounds,
+            num_vars,
+            num_substs,
+            delta);
+  BTORLOG (1, "end known bits propagation");
+}
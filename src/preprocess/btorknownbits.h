@@ -0,0 +1,37 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORKNOWNBITS_H_INCLUDED
+#define BTORKNOWNBITS_H_INCLUDED
+
+#include "btorbv.h"
+#include "btortypes.h"
+
+/* Forward/backward propagation of bits known to be 0 or 1 over the cone of
+ * the unsynthesized constraints. Variables with bits implied by the
+ * constraints are split into constants and fresh variables (as in slice
+ * elimination), terms with fixed bits are substituted by constants or
+ * narrowed to their unknown bits. */
+void btor_propagate_known_bits (Btor* btor);
+
+typedef struct BtorKBContext BtorKBContext;
+
+BtorKBContext* btor_known_bits_new_context (Btor* btor);
+
+void btor_known_bits_delete_context (BtorKBContext* ctx);
+
+/* Get the bits of 'exp' that are known for any assignment of its inputs,
+ * i.e., independently of the constraints. Bits set in 'lo' are known to be 1,
+ * bits not set in 'hi' are known to be 0. The known bits of the cone of 'exp'
+ * are cached in 'ctx'. */
+void btor_known_bits_get (BtorKBContext* ctx,
+                          BtorNode* exp,
+                          BtorBitVector** lo,
+                          BtorBitVector** hi);
+
+#endif
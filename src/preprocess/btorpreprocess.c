@@ -17,22 +17,58 @@
 #include "btorlog.h"
 #include "btorsubst.h"
 #include "preprocess/btorack.h"
+#include "preprocess/btorbvreduce.h"
 #include "preprocess/btorder.h"
+#include "preprocess/btoregraph.h"
 #include "preprocess/btorelimapplies.h"
 #include "preprocess/btorelimslices.h"
 #include "preprocess/btorembed.h"
 #include "preprocess/btorextract.h"
+#include "preprocess/btorknownbits.h"
 #include "preprocess/btormerge.h"
 #include "preprocess/btornormadd.h"
+#include "preprocess/btorrwdeferred.h"
 #include "preprocess/btorunconstrained.h"
 #include "preprocess/btorvarsubst.h"
 #ifndef BTOR_DO_NOT_PROCESS_SKELETON
 #include "preprocess/btorskel.h"
 #endif
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+/* Returns true if the set of unsynthesized constraints differs from the set
+ * of node ids 'ids' recorded via 'record_constraints'. */
+static bool
+constraints_changed (Btor *btor, BtorIntHashTable *ids)
+{
+  BtorPtrHashTableIterator it;
+
+  if (!ids || ids->count != btor->unsynthesized_constraints->count)
+    return true;
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+    if (!btor_hashint_table_contains (
+            ids, btor_node_get_id (btor_iter_hashptr_next (&it))))
+      return true;
+  return false;
+}
+
+static BtorIntHashTable *
+record_constraints (Btor *btor, BtorIntHashTable *ids)
+{
+  BtorPtrHashTableIterator it;
+
+  if (ids) btor_hashint_table_delete (ids);
+  ids = btor_hashint_table_new (btor->mm);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+    btor_hashint_table_add (ids,
+                            btor_node_get_id (btor_iter_hashptr_next (&it)));
+  return ids;
+}
+
 int32_t
 btor_simplify (Btor *btor)
 {
@@ -41,17 +77,26 @@ btor_simplify (Btor *btor)
   BtorSolverResult result;
   uint32_t rounds;
   double start, delta;
+  BtorIntHashTable *egraph_constraints;
 #ifndef BTOR_DO_NOT_PROCESS_SKELETON
   uint32_t skelrounds = 0;
+  bool incremental_preproc;
 #endif
 
-  rounds = 0;
-  start  = btor_util_time_stamp ();
+  rounds             = 0;
+  start              = btor_util_time_stamp ();
+  egraph_constraints = 0;
+#ifndef BTOR_DO_NOT_PROCESS_SKELETON
+  incremental_preproc = btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+                        && btor_opt_get (btor, BTOR_OPT_INCREMENTAL_PREPROC);
+#endif
 
   if (btor->valid_assignments) btor_reset_incremental_usage (btor);
 
   if (btor->inconsistent) goto DONE;
 
+  if (BTOR_COUNT_STACK (btor->ucdefs) > 0) btor_restore_unconstrained (btor);
+
   /* empty varsubst_constraints table if variable substitution was disabled
    * after adding variable substitution constraints (they are still in
    * unsynthesized_constraints).
@@ -103,11 +148,52 @@ btor_simplify (Btor *btor)
       }
 
       if (btor->varsubst_constraints->count) continue;
+
+      if (btor_opt_get (btor, BTOR_OPT_RW_DEFERRED)
+          && btor->rw_deferred->count > 0)
+      {
+        btor_rewrite_deferred (btor);
+
+        if (btor->inconsistent)
+        {
+          BTORLOG (1, "formula inconsistent after deferred rewriting");
+          break;
+        }
+
+        if (btor->varsubst_constraints->count
+            || btor->embedded_constraints->count)
+          continue;
+      }
     }
 
+    /* As slice elimination, known bits propagation only splits variables
+     * that are not frozen in incremental mode. */
+    if (btor_opt_get (btor, BTOR_OPT_KNOWN_BITS)
+        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
+        && (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+            || btor_opt_get (btor, BTOR_OPT_INCREMENTAL_PREPROC)))
+    {
+      btor_propagate_known_bits (btor);
+      if (btor->inconsistent)
+      {
+        BTORLOG (1, "formula inconsistent after known bits propagation");
+        break;
+      }
+
+      if (btor->varsubst_constraints->count
+          || btor->embedded_constraints->count)
+        continue;
+    }
+
+    /* In incremental mode, slice elimination only splits variables that are
+     * not frozen, i.e., not yet encoded into the SAT solver (see
+     * btorelimslices.c). Splitting a variable into fresh variables is a
+     * definitional substitution, which is preserved by any constraint and
+     * assumption added later on and thus safe under push/pop. */
     if (btor_opt_get (btor, BTOR_OPT_ELIMINATE_SLICES)
         && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+        && (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+            || btor_opt_get (btor, BTOR_OPT_INCREMENTAL_PREPROC)))
     {
       btor_eliminate_slices_on_bv_vars (btor);
       if (btor->inconsistent)
@@ -126,7 +212,14 @@ btor_simplify (Btor *btor)
         && btor_opt_get (btor, BTOR_OPT_SKELETON_PREPROC))
     {
       skelrounds++;
-      if (skelrounds <= 1)  // TODO only one?
+      /* Skeleton preprocessing only derives facts from the permanent
+       * constraints (assumptions and assertions of pushed contexts are not
+       * included), which is safe in incremental mode. If all constraints
+       * have already been processed in a previous call, nothing new can be
+       * derived. */
+      if (skelrounds <= 1  // TODO only one?
+          && (!incremental_preproc
+              || btor->unsynthesized_constraints->count > 0))
       {
         btor_process_skeleton (btor);
         if (btor->inconsistent)
@@ -146,9 +239,7 @@ btor_simplify (Btor *btor)
       continue;
 
     if (btor_opt_get (btor, BTOR_OPT_UCOPT)
-        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
-        && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
+        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2)
     {
       btor_optimize_unconstrained (btor);
       if (btor->inconsistent)
@@ -196,10 +287,24 @@ btor_simplify (Btor *btor)
         && btor_opt_get (btor, BTOR_OPT_SIMP_NORMAMLIZE_ADDERS))
       btor_normalize_adds (btor);
 
+    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
+        && btor_opt_get (btor, BTOR_OPT_BV_REDUCE))
+      btor_reduce_bv_widths (btor);
+
+    /* only rerun equality saturation if the constraints changed */
+    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
+        && btor_opt_get (btor, BTOR_OPT_EGRAPH)
+        && constraints_changed (btor, egraph_constraints))
+    {
+      btor_egraph_saturate (btor);
+      egraph_constraints = record_constraints (btor, egraph_constraints);
+    }
+
   } while (btor->varsubst_constraints->count
            || btor->embedded_constraints->count);
 
 DONE:
+  if (egraph_constraints) btor_hashint_table_delete (egraph_constraints);
   delta = btor_util_time_stamp () - start;
   btor->time.simplify += delta;
   BTOR_MSG (btor->msg, 1, "%u rewriting rounds in %.1f seconds", rounds, delta);
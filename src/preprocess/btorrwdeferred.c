@@ -0,0 +1,92 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorrwdeferred.h"
+
+#include "btorcore.h"
+#include "btordbg.h"
+#include "btorlog.h"
+#include "btorsubst.h"
+#include "utils/btorhashint.h"
+#include "utils/btorhashptr.h"
+#include "utils/btorutil.h"
+
+void
+btor_rewrite_deferred (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t rounds, max_rounds;
+  uint_least64_t count;
+  double start, delta;
+  BtorIntHashTable *deferred;
+  BtorIntHashTableIterator it;
+  BtorPtrHashTable *substs;
+  BtorNodePtrStack nodes;
+  BtorNode *cur;
+  BtorMemMgr *mm;
+
+  max_rounds = btor_opt_get (btor, BTOR_OPT_RW_DEFERRED);
+  if (!max_rounds || btor->rw_deferred->count == 0) return;
+
+  BTORLOG (1, "start deferred rewriting");
+
+  start  = btor_util_time_stamp ();
+  mm     = btor->mm;
+  rounds = 0;
+  count  = 0;
+  BTOR_INIT_STACK (mm, nodes);
+
+  /* Every round starts at recursion depth 0. Nodes that hit the bound again
+   * while being rebuilt are recorded in a fresh table for the next round. */
+  while (btor->rw_deferred->count > 0 && rounds < max_rounds
+         && !btor->inconsistent)
+  {
+    rounds++;
+    deferred          = btor->rw_deferred;
+    btor->rw_deferred = btor_hashint_table_new (mm);
+
+    substs = btor_hashptr_table_new (mm,
+                                     (BtorHashPtr) btor_node_hash_by_id,
+                                     (BtorCmpPtr) btor_node_compare_by_id);
+    btor_iter_hashint_init (&it, deferred);
+    while (btor_iter_hashint_has_next (&it))
+    {
+      cur = btor_node_get_by_id (btor, btor_iter_hashint_next (&it));
+      if (!cur || btor_node_is_simplified (cur) || cur->parameterized)
+        continue;
+      BTOR_PUSH_STACK (nodes, btor_node_copy (btor, cur));
+      btor_hashptr_table_add (substs, cur);
+    }
+    btor_hashint_table_delete (deferred);
+
+    if (substs->count > 0) btor_substitute_and_rebuild (btor, substs);
+    btor_hashptr_table_delete (substs);
+
+    count += BTOR_COUNT_STACK (nodes);
+    while (!BTOR_EMPTY_STACK (nodes))
+      btor_node_release (btor, BTOR_POP_STACK (nodes));
+  }
+  BTOR_RELEASE_STACK (nodes);
+
+  btor->stats.rw_deferred_rounds += rounds;
+  btor->stats.rw_deferred_nodes += count;
+  delta = btor_util_time_stamp () - start;
+  btor->time.rw_deferred += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "re-rewrote %llu nodes in %u rounds in %.1f seconds (%.0f nodes/s)",
+            count,
+            rounds,
+            delta,
+            delta > 0 ? count / delta : 0);
+  assert (btor_dbg_check_all_hash_tables_proxy_free (btor));
+  assert (btor_dbg_check_all_hash_tables_simp_free (btor));
+  assert (btor_dbg_check_unique_table_children_proxy_free (btor));
+  BTORLOG (1, "end deferred rewriting");
+}
@@ -0,0 +1,20 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORRWDEFERRED_H_INCLUDED
+#define BTORRWDEFERRED_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Rewrite nodes again that were created without rewriting since the
+ * recursive rewriting bound was hit, until no such nodes are left or the
+ * maximum number of rounds (option rw-deferred) is reached. This does not
+ * compute a rewriting fixpoint, each round is again subject to the bound. */
+void btor_rewrite_deferred (Btor* btor);
+
+#endif
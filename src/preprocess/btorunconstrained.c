@@ -11,10 +11,12 @@
 
 #include "preprocess/btorunconstrained.h"
 
+#include "btorbv.h"
 #include "btorcore.h"
 #include "btordbg.h"
 #include "btorexp.h"
 #include "btorlog.h"
+#include "btormodel.h"
 #include "btormsg.h"
 #include "btorsubst.h"
 #include "utils/btorhashint.h"
@@ -38,8 +40,107 @@ is_uc_write (BtorNode *cond)
   return btor_node_lambda_get_static_rho (lambda) != 0;
 }
 
+/* In incremental mode and with model generation enabled, eliminated terms
+ * are recorded in 'btor->ucdefs' (see BtorUCDef). Their definition is
+ * restored as constraint as soon as one of their unconstrained inputs is
+ * used again (btor_restore_unconstrained), otherwise the values of the
+ * eliminated inputs are computed from the value of the fresh variable
+ * (btor_extend_model_unconstrained). */
+static bool
+is_record_mode (Btor *btor)
+{
+  return btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+         || btor_opt_get (btor, BTOR_OPT_MODEL_GEN);
+}
+
+/* Collect the ids of the assumptions and of the assertions of context
+ * levels > 0. These are not flagged as constraints. */
+static BtorIntHashTable *
+collect_assumed (Btor *btor)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorIntHashTable *res;
+  BtorPtrHashTableIterator it;
+
+  res = btor_hashint_table_new (btor->mm);
+  btor_iter_hashptr_init (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_node_get_simplified (btor, btor_iter_hashptr_next (&it));
+    if (!btor_hashint_table_contains (res, btor_node_real_addr (cur)->id))
+      btor_hashint_table_add (res, btor_node_real_addr (cur)->id);
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions); i++)
+  {
+    cur = BTOR_PEEK_STACK (btor->assertions, i);
+    cur = btor_node_get_simplified (btor, cur);
+    if (!btor_hashint_table_contains (res, btor_node_real_addr (cur)->id))
+      btor_hashint_table_add (res, btor_node_real_addr (cur)->id);
+  }
+  return res;
+}
+
+static bool
+is_constrained (BtorIntHashTable *assumed, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+  return exp->constraint || btor_hashint_table_contains (assumed, exp->id);
+}
+
+static bool
+is_uc_kind (BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_CONCAT_NODE:
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE: return true;
+    case BTOR_COND_NODE: return btor_node_is_bv_cond (exp);
+    default: return false;
+  }
+}
+
 static void
-mark_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp)
+record_uc (Btor *btor, BtorNode *exp, BtorNode *var, bool uc[])
+{
+  assert (btor_node_is_regular (exp));
+  assert (is_uc_kind (exp));
+
+  uint32_t i;
+  BtorUCDef def;
+
+  def.var   = btor_node_copy (btor, var);
+  def.kind  = exp->kind;
+  def.upper = 0;
+  def.lower = 0;
+  if (btor_node_is_bv_slice (exp))
+  {
+    def.upper = btor_node_bv_slice_get_upper (exp);
+    def.lower = btor_node_bv_slice_get_lower (exp);
+  }
+  def.arity = exp->arity;
+  for (i = 0; i < 3; i++)
+  {
+    def.e[i]  = i < exp->arity ? btor_node_copy (btor, exp->e[i]) : 0;
+    def.uc[i] = i < exp->arity && uc[i];
+  }
+  def.restored = false;
+  BTOR_PUSH_STACK (btor->ucdefs, def);
+}
+
+static void
+mark_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp, bool uc_child[])
 {
   assert (btor_node_is_regular (exp));
   /* no inputs allowed here */
@@ -76,6 +177,8 @@ mark_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp)
   else
     subst = btor_exp_var (btor, btor_node_get_sort_id (exp), 0);
 
+  if (is_record_mode (btor)) record_uc (btor, exp, subst, uc_child);
+
   btor_insert_substitution (btor, exp, subst, false);
   btor_node_release (btor, subst);
 }
@@ -85,12 +188,10 @@ btor_optimize_unconstrained (Btor *btor)
 {
   assert (btor);
   assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2);
-  assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
-  assert (!btor_opt_get (btor, BTOR_OPT_MODEL_GEN));
 
   double start, delta;
   uint32_t i, num_ucs;
-  bool uc[3], ucp[3];
+  bool uc[3], ucp[3], record;
   BtorNode *cur, *cur_parent;
   BtorNodePtrStack stack, roots;
   BtorPtrHashTableIterator it;
@@ -99,6 +200,7 @@ btor_optimize_unconstrained (Btor *btor)
   BtorIntHashTable *ucs;  /* unconstrained candidate nodes */
   BtorIntHashTable *ucsp; /* parameterized unconstrained candidate nodes */
   BtorIntHashTable *mark;
+  BtorIntHashTable *assumed;
   BtorHashTableData *d;
 
   if (btor->bv_vars->count == 0 && btor->ufs->count == 0) return;
@@ -111,21 +213,30 @@ btor_optimize_unconstrained (Btor *btor)
   BTOR_INIT_STACK (mm, roots);
   uc[0] = uc[1] = uc[2] = ucp[0] = ucp[1] = ucp[2] = false;
 
-  mark = btor_hashint_map_new (mm);
-  ucs  = btor_hashint_table_new (mm);
-  ucsp = btor_hashint_table_new (mm);
+  mark    = btor_hashint_map_new (mm);
+  ucs     = btor_hashint_table_new (mm);
+  ucsp    = btor_hashint_table_new (mm);
+  assumed = collect_assumed (btor);
   btor_init_substitutions (btor);
 
+  /* In incremental mode and with model generation enabled, only bit-vector
+   * terms over bit-vector variables are eliminated (their definitions are
+   * recorded). Inputs and terms that are already encoded into the SAT
+   * solver are frozen. */
+  record = is_record_mode (btor);
+
   /* collect nodes that might contribute to a unconstrained candidate
    * propagation */
   btor_iter_hashptr_init (&it, btor->bv_vars);
-  btor_iter_hashptr_queue (&it, btor->ufs);
+  if (!record) btor_iter_hashptr_queue (&it, btor->ufs);
   while (btor_iter_hashptr_has_next (&it))
   {
     cur = btor_iter_hashptr_next (&it);
     assert (btor_node_is_regular (cur));
 
     if (btor_node_is_simplified (cur)) continue;
+    if (is_constrained (assumed, cur)) continue;
+    if (record && btor_node_is_synth (cur)) continue;
 
     if (cur->parents == 1)
     {
@@ -191,7 +302,11 @@ btor_optimize_unconstrained (Btor *btor)
       btor_hashint_map_remove (mark, cur->id, 0);
 
       /* propagate unconstrained candidates */
-      if (cur->parents == 0 || (cur->parents == 1 && !cur->constraint))
+      if ((cur->parents == 0
+           || (cur->parents == 1 && !is_constrained (assumed, cur)))
+          && (!record
+              || (!cur->parameterized && !btor_node_is_synth (cur)
+                  && is_uc_kind (cur))))
       {
         for (i = 0; i < cur->arity; i++)
         {
@@ -212,17 +327,17 @@ btor_optimize_unconstrained (Btor *btor)
             {
               if (cur->parameterized)
               {
-                if (btor_node_is_apply (cur)) mark_uc (btor, ucsp, cur);
+                if (btor_node_is_apply (cur)) mark_uc (btor, ucsp, cur, uc);
               }
               else
-                mark_uc (btor, ucs, cur);
+                mark_uc (btor, ucs, cur, uc);
             }
             break;
           case BTOR_BV_ADD_NODE:
           case BTOR_BV_EQ_NODE:
           case BTOR_FUN_EQ_NODE:
             if (!cur->parameterized && (uc[0] || uc[1]))
-              mark_uc (btor, ucs, cur);
+              mark_uc (btor, ucs, cur, uc);
             break;
           case BTOR_BV_ULT_NODE:
           case BTOR_BV_CONCAT_NODE:
@@ -232,19 +347,20 @@ btor_optimize_unconstrained (Btor *btor)
           case BTOR_BV_SRL_NODE:
           case BTOR_BV_UDIV_NODE:
           case BTOR_BV_UREM_NODE:
-            if (!cur->parameterized && uc[0] && uc[1]) mark_uc (btor, ucs, cur);
+            if (!cur->parameterized && uc[0] && uc[1])
+              mark_uc (btor, ucs, cur, uc);
             break;
           case BTOR_COND_NODE:
             if ((uc[1] && uc[2]) || (uc[0] && (uc[1] || uc[2])))
-              mark_uc (btor, ucs, cur);
+              mark_uc (btor, ucs, cur, uc);
             else if (uc[1] && ucp[2])
             {
               /* case: x = t ? uc : ucp */
-              if (is_uc_write (cur)) mark_uc (btor, ucsp, cur);
+              if (is_uc_write (cur)) mark_uc (btor, ucsp, cur, uc);
             }
             break;
           case BTOR_UPDATE_NODE:
-            if (uc[0] && uc[2]) mark_uc (btor, ucs, cur);
+            if (uc[0] && uc[2]) mark_uc (btor, ucs, cur, uc);
             break;
           // TODO (ma): functions with parents > 1 can still be
           //            handled as unconstrained, but the applications
@@ -256,7 +372,7 @@ btor_optimize_unconstrained (Btor *btor)
                 /* only consider head lambda of curried lambdas */
                 && (!cur->first_parent
                     || !btor_node_is_lambda (cur->first_parent)))
-              mark_uc (btor, ucs, cur);
+              mark_uc (btor, ucs, cur, uc);
             break;
           default: break;
         }
@@ -272,6 +388,7 @@ btor_optimize_unconstrained (Btor *btor)
   btor_delete_substitutions (btor);
   btor_hashint_table_delete (ucs);
   btor_hashint_table_delete (ucsp);
+  btor_hashint_table_delete (assumed);
   BTOR_RELEASE_STACK (stack);
   BTOR_RELEASE_STACK (roots);
 
@@ -287,3 +404,240 @@ btor_optimize_unconstrained (Btor *btor)
   assert (btor_dbg_check_all_hash_tables_simp_free (btor));
   assert (btor_dbg_check_unique_table_children_proxy_free (btor));
 }
+
+/*------------------------------------------------------------------------*/
+
+/* Check if the unconstrained input 'exp' of an eliminated term is used again,
+ * i.e., if it occurs in terms, constraints or assumptions added after its
+ * elimination (or has been substituted in the meantime). */
+static bool
+is_used (Btor *btor, BtorIntHashTable *assumed, BtorNode *exp)
+{
+  exp = btor_node_real_addr (btor_node_get_simplified (btor, exp));
+  return !btor_node_is_bv_var (exp) || exp->parents > 0
+         || is_constrained (assumed, exp);
+}
+
+static void
+restore_uc (Btor *btor, BtorUCDef *def)
+{
+  assert (!def->restored);
+
+  uint32_t i;
+  BtorNode *e[3], *term, *eq;
+
+  for (i = 0; i < def->arity; i++) e[i] = btor_simplify_exp (btor, def->e[i]);
+
+  if (def->kind == BTOR_BV_SLICE_NODE)
+    term = btor_exp_bv_slice (btor, e[0], def->upper, def->lower);
+  else
+    term = btor_exp_create (btor, def->kind, e, def->arity);
+
+  eq = btor_exp_eq (btor, def->var, term);
+  BTORLOG (2, "restore uc term %s", btor_util_node2string (eq));
+  btor_assert_exp (btor, eq);
+  btor_node_release (btor, eq);
+  btor_node_release (btor, term);
+
+  def->restored = true;
+  btor->stats.uc_restored++;
+}
+
+void
+btor_restore_unconstrained (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, j;
+  bool changed;
+  BtorUCDef *def;
+  BtorIntHashTable *assumed;
+
+  assumed = collect_assumed (btor);
+  /* restoring a definition adds a parent to its variable, which may be an
+   * unconstrained input of a term eliminated later on */
+  do
+  {
+    changed = false;
+    for (i = 0; i < BTOR_COUNT_STACK (btor->ucdefs); i++)
+    {
+      def = btor->ucdefs.start + i;
+      if (def->restored) continue;
+      for (j = 0; j < def->arity; j++)
+      {
+        if (def->uc[j] && is_used (btor, assumed, def->e[j]))
+        {
+          restore_uc (btor, def);
+          changed = true;
+          break;
+        }
+      }
+    }
+  } while (changed);
+  btor_hashint_table_delete (assumed);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+set_model_value (Btor *btor, BtorNode *exp, BtorBitVector *value)
+{
+  BtorBitVector *inv;
+
+  exp = btor_node_get_simplified (btor, exp);
+  /* the input has been substituted in the meantime, in which case the
+   * definition was restored */
+  if (!btor_node_is_bv_var (exp)) return;
+
+  if (btor_hashint_map_contains (btor->bv_model, btor_node_real_addr (exp)->id))
+    btor_model_remove_from_bv (
+        btor, btor->bv_model, btor_node_real_addr (exp));
+  if (btor_node_is_inverted (exp))
+  {
+    inv = btor_bv_not (btor->mm, value);
+    btor_model_add_to_bv (btor, btor->bv_model, btor_node_real_addr (exp), inv);
+    btor_bv_free (btor->mm, inv);
+  }
+  else
+    btor_model_add_to_bv (btor, btor->bv_model, exp, value);
+}
+
+/* Compute values of the unconstrained inputs of 'def' such that the term
+ * evaluates to 'value'. */
+static void
+compute_uc_values (BtorMemMgr *mm,
+                   BtorUCDef *def,
+                   const BtorBitVector *value,
+                   BtorBitVector *values[])
+{
+  uint32_t i, w;
+
+#define BTOR_UC_SET(i, bv)              \
+  do                                    \
+  {                                     \
+    btor_bv_free (mm, values[i]);       \
+    values[i] = (bv);                   \
+  } while (0)
+
+  switch (def->kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+      assert (def->uc[0]);
+      w = btor_bv_get_width (values[0]);
+      BTOR_UC_SET (0, btor_bv_new (mm, w));
+      for (i = def->lower; i <= def->upper; i++)
+        btor_bv_set_bit (values[0], i, btor_bv_get_bit (value, i - def->lower));
+      break;
+    case BTOR_BV_ADD_NODE:
+      if (def->uc[0])
+        BTOR_UC_SET (0, btor_bv_sub (mm, value, values[1]));
+      else
+        BTOR_UC_SET (1, btor_bv_sub (mm, value, values[0]));
+      break;
+    case BTOR_BV_EQ_NODE:
+      i = def->uc[0] ? 0 : 1;
+      BTOR_UC_SET (i,
+                   btor_bv_get_bit (value, 0)
+                       ? btor_bv_copy (mm, values[1 - i])
+                       : btor_bv_not (mm, values[1 - i]));
+      break;
+    case BTOR_BV_ULT_NODE:
+      assert (def->uc[0] && def->uc[1]);
+      w = btor_bv_get_width (values[0]);
+      BTOR_UC_SET (0, btor_bv_new (mm, w));
+      BTOR_UC_SET (1,
+                   btor_bv_get_bit (value, 0) ? btor_bv_one (mm, w)
+                                              : btor_bv_new (mm, w));
+      break;
+    case BTOR_BV_CONCAT_NODE:
+      assert (def->uc[0] && def->uc[1]);
+      w = btor_bv_get_width (values[1]);
+      BTOR_UC_SET (
+          0, btor_bv_slice (mm, value, btor_bv_get_width (value) - 1, w));
+      BTOR_UC_SET (1, btor_bv_slice (mm, value, w - 1, 0));
+      break;
+    case BTOR_BV_AND_NODE:
+      assert (def->uc[0] && def->uc[1]);
+      w = btor_bv_get_width (values[1]);
+      BTOR_UC_SET (0, btor_bv_copy (mm, value));
+      BTOR_UC_SET (1, btor_bv_ones (mm, w));
+      break;
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_UDIV_NODE:
+      assert (def->uc[0] && def->uc[1]);
+      w = btor_bv_get_width (values[1]);
+      BTOR_UC_SET (0, btor_bv_copy (mm, value));
+      BTOR_UC_SET (1, btor_bv_one (mm, w));
+      break;
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UREM_NODE:
+      assert (def->uc[0] && def->uc[1]);
+      w = btor_bv_get_width (values[1]);
+      BTOR_UC_SET (0, btor_bv_copy (mm, value));
+      BTOR_UC_SET (1, btor_bv_new (mm, w));
+      break;
+    default:
+      assert (def->kind == BTOR_COND_NODE);
+      if (def->uc[1] && def->uc[2])
+      {
+        BTOR_UC_SET (1, btor_bv_copy (mm, value));
+        BTOR_UC_SET (2, btor_bv_copy (mm, value));
+      }
+      else
+      {
+        assert (def->uc[0]);
+        i = def->uc[1] ? 1 : 2;
+        BTOR_UC_SET (0, i == 1 ? btor_bv_one (mm, 1) : btor_bv_new (mm, 1));
+        BTOR_UC_SET (i, btor_bv_copy (mm, value));
+      }
+  }
+#undef BTOR_UC_SET
+}
+
+void
+btor_extend_model_unconstrained (Btor *btor)
+{
+  assert (btor);
+  assert (btor->bv_model);
+
+  uint32_t i, j;
+  BtorUCDef *def;
+  BtorBitVector *value, *values[3];
+
+  /* definitions are recorded bottom-up, eliminated terms may be inputs of
+   * terms eliminated later on */
+  for (i = BTOR_COUNT_STACK (btor->ucdefs); i > 0; i--)
+  {
+    def = btor->ucdefs.start + i - 1;
+    if (def->restored) continue;
+
+    value = btor_bv_copy (btor->mm, btor_model_get_bv (btor, def->var));
+    for (j = 0; j < def->arity; j++)
+      values[j] = btor_bv_copy (btor->mm, btor_model_get_bv (btor, def->e[j]));
+    compute_uc_values (btor->mm, def, value, values);
+    for (j = 0; j < def->arity; j++)
+    {
+      if (def->uc[j]) set_model_value (btor, def->e[j], values[j]);
+      btor_bv_free (btor->mm, values[j]);
+    }
+    btor_bv_free (btor->mm, value);
+  }
+}
+
+void
+btor_delete_unconstrained_defs (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, j;
+  BtorUCDef *def;
+
+  for (i = 0; i < BTOR_COUNT_STACK (btor->ucdefs); i++)
+  {
+    def = btor->ucdefs.start + i;
+    btor_node_release (btor, def->var);
+    for (j = 0; j < def->arity; j++) btor_node_release (btor, def->e[j]);
+  }
+  BTOR_RELEASE_STACK (btor->ucdefs);
+}
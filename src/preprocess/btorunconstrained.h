@@ -13,4 +13,14 @@
 
 void btor_optimize_unconstrained (Btor* btor);
 
+/* Assert the definitions of terms eliminated in previous calls if any of
+ * their unconstrained inputs is used again. */
+void btor_restore_unconstrained (Btor* btor);
+
+/* Compute the values of the unconstrained inputs of eliminated terms from the
+ * values of the fresh variables substituted for them. */
+void btor_extend_model_unconstrained (Btor* btor);
+
+void btor_delete_unconstrained_defs (Btor* btor);
+
 #endif
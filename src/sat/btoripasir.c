@@ -0,0 +1,191 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "sat/btoripasir.h"
+#include "btorabort.h"
+
+/*------------------------------------------------------------------------*/
+#ifdef BTOR_USE_IPASIR
+/*------------------------------------------------------------------------*/
+
+#include <dlfcn.h>
+#include <stdlib.h>
+
+#include "btorcore.h"
+
+/*------------------------------------------------------------------------*/
+
+static const char *
+get_lib_path (void)
+{
+  return getenv (BTOR_IPASIR_LIB_ENV);
+}
+
+static void *
+load_sym (BtorIPASIR *ipasir, const char *path, const char *name, bool required)
+{
+  void *res;
+
+  res = dlsym (ipasir->handle, name);
+  BTOR_ABORT (required && !res,
+              "IPASIR library '%s' does not provide '%s'",
+              path,
+              name);
+  return res;
+}
+
+static void *
+init (BtorSATMgr *smgr)
+{
+  BtorIPASIR *res;
+  const char *path;
+
+  path = get_lib_path ();
+  BTOR_ABORT (!path,
+              "IPASIR library not specified, set environment variable '%s'",
+              BTOR_IPASIR_LIB_ENV);
+
+  BTOR_CNEW (smgr->btor->mm, res);
+  res->handle = dlopen (path, RTLD_NOW | RTLD_LOCAL);
+  BTOR_ABORT (!res->handle,
+              "failed to load IPASIR library '%s': %s",
+              path,
+              dlerror ());
+
+  /* Note: ISO C does not allow to convert between object and function
+   *       pointers, hence the detour via memcpy. */
+#define BTOR_IPASIR_LOAD(field, name, required)      \
+  do                                                 \
+  {                                                  \
+    void *sym = load_sym (res, path, name, required); \
+    memcpy (&res->field, &sym, sizeof (sym));        \
+  } while (0)
+
+  BTOR_IPASIR_LOAD (signature, "ipasir_signature", true);
+  BTOR_IPASIR_LOAD (init, "ipasir_init", true);
+  BTOR_IPASIR_LOAD (release, "ipasir_release", true);
+  BTOR_IPASIR_LOAD (add, "ipasir_add", true);
+  BTOR_IPASIR_LOAD (assume, "ipasir_assume", true);
+  BTOR_IPASIR_LOAD (solve, "ipasir_solve", true);
+  BTOR_IPASIR_LOAD (val, "ipasir_val", true);
+  BTOR_IPASIR_LOAD (failed, "ipasir_failed", true);
+  BTOR_IPASIR_LOAD (set_terminate, "ipasir_set_terminate", false);
+#undef BTOR_IPASIR_LOAD
+
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "IPASIR library '%s' (%s)",
+            path,
+            res->signature ());
+
+  res->solver = res->init ();
+  BTOR_ABORT (!res->solver, "IPASIR library '%s' failed to initialize", path);
+
+  return res;
+}
+
+static void
+add (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorIPASIR *ipasir = smgr->solver;
+  ipasir->add (ipasir->solver, lit);
+}
+
+static void
+assume (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorIPASIR *ipasir = smgr->solver;
+  ipasir->assume (ipasir->solver, lit);
+}
+
+static int32_t
+deref (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorIPASIR *ipasir = smgr->solver;
+  int32_t val;
+
+  /* IPASIR returns the literal itself (true), its negation (false) or 0
+   * (don't care), values are relative to the variable of 'lit'. */
+  val = ipasir->val (ipasir->solver, abs (lit));
+  if (lit < 0) val = -val;
+  if (val > 0) return 1;
+  if (val < 0) return -1;
+  return 0;
+}
+
+static int32_t
+failed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorIPASIR *ipasir = smgr->solver;
+  return ipasir->failed (ipasir->solver, lit);
+}
+
+static void
+reset (BtorSATMgr *smgr)
+{
+  BtorIPASIR *ipasir = smgr->solver;
+  ipasir->release (ipasir->solver);
+  dlclose (ipasir->handle);
+  BTOR_DELETE (smgr->btor->mm, ipasir);
+  smgr->solver = 0;
+}
+
+static int32_t
+sat (BtorSATMgr *smgr, int32_t limit)
+{
+  BtorIPASIR *ipasir = smgr->solver;
+  (void) limit;
+  return ipasir->solve (ipasir->solver);
+}
+
+static void
+setterm (BtorSATMgr *smgr)
+{
+  BtorIPASIR *ipasir = smgr->solver;
+  if (ipasir->set_terminate)
+    ipasir->set_terminate (ipasir->solver, smgr->term.state, smgr->term.fun);
+}
+
+/*------------------------------------------------------------------------*/
+
+bool
+btor_sat_enable_ipasir (BtorSATMgr *smgr)
+{
+  assert (smgr != NULL);
+
+  BTOR_ABORT (smgr->initialized,
+              "'btor_sat_init' called before 'btor_sat_enable_ipasir'");
+  BTOR_ABORT (!get_lib_path (),
+              "IPASIR library not specified, set environment variable '%s'",
+              BTOR_IPASIR_LIB_ENV);
+
+  smgr->name = "IPASIR";
+
+  BTOR_CLR (&smgr->api);
+  smgr->api.add              = add;
+  smgr->api.assume           = assume;
+  smgr->api.deref            = deref;
+  smgr->api.enable_verbosity = 0;
+  smgr->api.failed           = failed;
+  smgr->api.fixed            = 0;
+  smgr->api.inc_max_var      = 0;
+  smgr->api.init             = init;
+  smgr->api.melt             = 0;
+  smgr->api.repr             = 0;
+  smgr->api.reset            = reset;
+  smgr->api.sat              = sat;
+  smgr->api.set_output       = 0;
+  smgr->api.set_prefix       = 0;
+  smgr->api.stats            = 0;
+  smgr->api.setterm          = setterm;
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+#endif
+/*------------------------------------------------------------------------*/
@@ -0,0 +1,46 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORIPASIR_H_INCLUDED
+#define BTORIPASIR_H_INCLUDED
+
+/*------------------------------------------------------------------------*/
+#ifdef BTOR_USE_IPASIR
+/*------------------------------------------------------------------------*/
+
+#include "btorsat.h"
+
+/* Environment variable holding the path to the IPASIR shared library that is
+ * loaded at runtime if BTOR_SAT_ENGINE_IPASIR is selected. */
+#define BTOR_IPASIR_LIB_ENV "BTORIPASIRLIB"
+
+typedef struct BtorIPASIR BtorIPASIR;
+
+struct BtorIPASIR
+{
+  void *handle; /* shared library handle (dlopen) */
+  void *solver; /* IPASIR solver instance */
+
+  const char *(*signature) (void);
+  void *(*init) (void);
+  void (*release) (void *);
+  void (*add) (void *, int32_t);
+  void (*assume) (void *, int32_t);
+  int32_t (*solve) (void *);
+  int32_t (*val) (void *, int32_t);
+  int32_t (*failed) (void *, int32_t);
+  void (*set_terminate) (void *, void *, int32_t (*) (void *));
+};
+
+bool btor_sat_enable_ipasir (BtorSATMgr *smgr);
+
+/*------------------------------------------------------------------------*/
+#endif
+/*------------------------------------------------------------------------*/
+
+#endif
@@ -498,6 +498,9 @@ btor_util_check_hex_to_bv (BtorMemMgr *mm, const char *str, uint32_t bw)
 #include <sys/resource.h>
 #include <sys/time.h>
 #include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 double
 btor_util_time_stamp (void)
@@ -535,6 +538,18 @@ btor_util_current_time (void)
   return res;
 }
 
+uint64_t
+btor_util_cycle_count (void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc ();
+#else
+  struct timespec ts;
+  if (clock_gettime (CLOCK_MONOTONIC, &ts)) return 0;
+  return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec;
+#endif
+}
+
 #else
 
 double
@@ -555,6 +570,12 @@ btor_util_current_time (void)
   return 0;
 }
 
+uint64_t
+btor_util_cycle_count (void)
+{
+  return 0;
+}
+
 #endif
 
 /*------------------------------------------------------------------------*/
@@ -77,6 +77,9 @@ double btor_util_time_stamp (void);
 double btor_util_process_time_thread (void);
 double btor_util_current_time (void);
 
+/* Cheap monotonic cycle counter (time stamp counter if available). */
+uint64_t btor_util_cycle_count (void);
+
 /*------------------------------------------------------------------------*/
 
 int32_t btor_util_file_exists (const char *);
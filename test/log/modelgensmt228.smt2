@@ -0,0 +1,30 @@
+(set-logic QF_ABV)
+(declare-fun a () (Array (_ BitVec 8) (_ BitVec 8)))
+(declare-fun i () (_ BitVec 8))
+(assert (= (select a (_ bv10 8)) (_ bv5 8)))
+(assert (= (select a (_ bv11 8)) (_ bv5 8)))
+(assert (= (select a (_ bv12 8)) (_ bv5 8)))
+(assert (= (select a (_ bv13 8)) (_ bv5 8)))
+(assert (= (select a (_ bv14 8)) (_ bv5 8)))
+(assert (= (select a (_ bv15 8)) (_ bv5 8)))
+(assert (= (select a (_ bv16 8)) (_ bv5 8)))
+(assert (= (select a (_ bv17 8)) (_ bv5 8)))
+(assert (= (select a (_ bv18 8)) (_ bv5 8)))
+(assert (= (select a (_ bv19 8)) (_ bv5 8)))
+(assert (= (select a (_ bv20 8)) (_ bv5 8)))
+(assert (= (select a (_ bv40 8)) (_ bv6 8)))
+(assert (= (select a (_ bv41 8)) (_ bv6 8)))
+(assert (= (select a (_ bv42 8)) (_ bv6 8)))
+(assert (= (select a (_ bv43 8)) (_ bv6 8)))
+(assert (= (select a (_ bv44 8)) (_ bv6 8)))
+(assert (= (select a (_ bv45 8)) (_ bv6 8)))
+(assert (= (select a (_ bv46 8)) (_ bv6 8)))
+(assert (= (select a (_ bv47 8)) (_ bv6 8)))
+(assert (= (select a (_ bv48 8)) (_ bv6 8)))
+(assert (= (select a (_ bv49 8)) (_ bv6 8)))
+(assert (= (select a (_ bv50 8)) (_ bv6 8)))
+(assert (= (select a (_ bv60 8)) (_ bv7 8)))
+(assert (bvugt i (_ bv60 8)))
+(assert (= (select a i) (_ bv9 8)))
+(check-sat)
+(exit)
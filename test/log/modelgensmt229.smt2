@@ -0,0 +1,17 @@
+(set-logic QF_AUFBV)
+(declare-fun a () (Array (_ BitVec 4) (_ BitVec 4)))
+(declare-fun f ((_ BitVec 4)) (_ BitVec 4))
+(assert (= (select a #x1) #x5))
+(assert (= (select a #x2) #x5))
+(assert (= (select a #x3) #x5))
+(assert (= (select a #x4) #x5))
+(assert (= (select a #x6) #x3))
+(assert (= (select a #x7) #x3))
+(assert (= (select a #x8) #x3))
+(assert (= (select a #xa) #x7))
+(assert (= (select a #xc) #x5))
+(assert (= (f #x2) #x1))
+(assert (= (f #x3) #x1))
+(assert (= (f #x9) #x0))
+(check-sat)
+(exit)
@@ -145,3 +145,31 @@ TEST_F (TestAig, aig_to_sat)
   btor_aig_release (amgr, and3);
   btor_aig_mgr_delete (amgr);
 }
+
+TEST_F (TestAig, eval_unassigned)
+{
+  btor_opt_set (d_btor, BTOR_OPT_LAZY_ENCODE, 1);
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorSATMgr *smgr = btor_aig_get_sat_mgr (amgr);
+  BtorAIG *var1    = btor_aig_var (amgr);
+  BtorAIG *var2    = btor_aig_var (amgr);
+  BtorAIG *var3    = btor_aig_var (amgr);
+  BtorAIG *and1    = btor_aig_and (amgr, var1, var2);
+  BtorAIG *and2    = btor_aig_and (amgr, and1, BTOR_INVERT_AIG (var3));
+  btor_sat_enable_solver (smgr);
+  btor_sat_init (smgr);
+  btor_aig_add_toplevel_to_sat (amgr, and1);
+  ASSERT_EQ (btor_sat_check_sat (smgr, -1), BTOR_RESULT_SAT);
+  /* 'and2' and 'var3' are not encoded, 'var3' defaults to false */
+  ASSERT_EQ (btor_aig_get_cnf_id (and2), 0);
+  ASSERT_EQ (btor_aig_get_assignment (amgr, var3), -1);
+  ASSERT_EQ (btor_aig_get_assignment (amgr, and2), 1);
+  ASSERT_EQ (btor_aig_get_assignment (amgr, BTOR_INVERT_AIG (and2)), -1);
+  btor_sat_reset (smgr);
+  btor_aig_release (amgr, var1);
+  btor_aig_release (amgr, var2);
+  btor_aig_release (amgr, var3);
+  btor_aig_release (amgr, and1);
+  btor_aig_release (amgr, and2);
+  btor_aig_mgr_delete (amgr);
+}
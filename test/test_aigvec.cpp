@@ -13,6 +13,8 @@
 extern "C" {
 #include "btoraigvec.h"
 #include "btorbv.h"
+#include "btorcore.h"
+#include "btorexp.h"
 }
 
 class TestAigvec : public TestBtor
@@ -266,6 +268,68 @@ TEST_F (TestAigvec, urem)
   btor_aigvec_mgr_delete (avmgr);
 }
 
+TEST_F (TestAigvec, udiv_urem)
+{
+  BtorAIGVecMgr *avmgr = btor_aigvec_mgr_new (d_btor);
+  BtorAIGVec *av1      = btor_aigvec_var (avmgr, 32);
+  BtorAIGVec *av2      = btor_aigvec_var (avmgr, 32);
+  BtorAIGVec *av3, *av4, *av5;
+  btor_aigvec_udiv_urem (avmgr, av1, av2, &av3, &av4);
+  ASSERT_TRUE (av3->width == 32);
+  ASSERT_TRUE (av4->width == 32);
+  /* structural hashing yields the same quotient */
+  av5 = btor_aigvec_udiv (avmgr, av1, av2);
+  for (uint32_t i = 0; i < 32; i++) ASSERT_EQ (av3->aigs[i], av5->aigs[i]);
+  btor_aigvec_release_delete (avmgr, av1);
+  btor_aigvec_release_delete (avmgr, av2);
+  btor_aigvec_release_delete (avmgr, av3);
+  btor_aigvec_release_delete (avmgr, av4);
+  btor_aigvec_release_delete (avmgr, av5);
+  btor_aigvec_mgr_delete (avmgr);
+}
+
+TEST_F (TestAigvec, udiv_urem_synthesize)
+{
+  BtorAIGVecMgr *avmgr = d_btor->avmgr;
+  BtorAIGMgr *amgr     = btor_get_aig_mgr (d_btor);
+  BtorAIGVec *av1, *av2, *av3, *av4;
+  BtorSortId sort;
+  BtorNode *x, *y, *udiv, *urem;
+  uint64_t num_aigs, num_aigs_divider;
+
+  btor_opt_set (d_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+  btor_opt_set (d_btor, BTOR_OPT_LAZY_ENCODE, 1);
+  sort = btor_sort_bv (d_btor, 16);
+  x    = btor_exp_var (d_btor, sort, "x");
+  y    = btor_exp_var (d_btor, sort, "y");
+  udiv = btor_exp_bv_udiv (d_btor, x, y);
+  urem = btor_exp_bv_urem (d_btor, x, y);
+  btor_sort_release (d_btor, sort);
+
+  /* baseline: a single divider circuit */
+  av1      = btor_aigvec_var (avmgr, 16);
+  av2      = btor_aigvec_var (avmgr, 16);
+  num_aigs = amgr->cur_num_aigs;
+  btor_aigvec_udiv_urem (avmgr, av1, av2, &av3, &av4);
+  num_aigs_divider = amgr->cur_num_aigs - num_aigs;
+  btor_aigvec_release_delete (avmgr, av1);
+  btor_aigvec_release_delete (avmgr, av2);
+  btor_aigvec_release_delete (avmgr, av3);
+  btor_aigvec_release_delete (avmgr, av4);
+  ASSERT_EQ (amgr->cur_num_aigs, num_aigs);
+
+  /* synthesizing udiv also synthesizes its urem sibling */
+  btor_synthesize_exp (d_btor, udiv, 0);
+  ASSERT_TRUE (btor_node_is_synth (urem));
+  btor_synthesize_exp (d_btor, urem, 0);
+  ASSERT_EQ (amgr->cur_num_aigs - num_aigs, num_aigs_divider);
+
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, udiv);
+  btor_node_release (d_btor, urem);
+}
+
 TEST_F (TestAigvec, concat)
 {
   BtorAIGVecMgr *avmgr = btor_aigvec_mgr_new (d_btor);
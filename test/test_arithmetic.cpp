@@ -136,6 +136,74 @@ class TestArith : public TestBoolector
     }
   }
 
+  void udiv_urem_test (int32_t low, int32_t high, bool mul_encode)
+  {
+    assert (low > 0);
+    assert (low <= high);
+
+    int32_t i, j, max, num_bits;
+
+    for (num_bits = low; num_bits <= high; num_bits++)
+    {
+      max = btor_util_pow_2 (num_bits);
+      for (i = 0; i < max; i++)
+      {
+        for (j = 0; j < max; j++)
+        {
+          if (d_btor) boolector_delete (d_btor);
+          d_btor = boolector_new ();
+          boolector_set_opt (d_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+          boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+          boolector_set_opt (d_btor, BTOR_OPT_UDIV_MUL_ENCODE, mul_encode);
+
+          BoolectorSort sort = boolector_bitvec_sort (d_btor, num_bits);
+          BoolectorNode *x, *y, *cx, *cy, *cq, *cr, *q, *r;
+          BoolectorNode *eqx, *eqy, *eqq, *eqr, *eqqr, *neqqr;
+
+          x   = boolector_var (d_btor, sort, "x");
+          y   = boolector_var (d_btor, sort, "y");
+          cx  = boolector_unsigned_int (d_btor, i, sort);
+          cy  = boolector_unsigned_int (d_btor, j, sort);
+          cq  = boolector_unsigned_int (d_btor, j ? i / j : max - 1, sort);
+          cr  = boolector_unsigned_int (d_btor, j ? i % j : i, sort);
+          q   = boolector_udiv (d_btor, x, y);
+          r   = boolector_urem (d_btor, x, y);
+          eqx = boolector_eq (d_btor, x, cx);
+          eqy = boolector_eq (d_btor, y, cy);
+          eqq = boolector_eq (d_btor, q, cq);
+          eqr = boolector_eq (d_btor, r, cr);
+          eqqr  = boolector_and (d_btor, eqq, eqr);
+          neqqr = boolector_not (d_btor, eqqr);
+          boolector_assert (d_btor, eqx);
+          boolector_assert (d_btor, eqy);
+
+          boolector_assume (d_btor, eqqr);
+          ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+          boolector_assume (d_btor, neqqr);
+          ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+          boolector_release_sort (d_btor, sort);
+          boolector_release (d_btor, x);
+          boolector_release (d_btor, y);
+          boolector_release (d_btor, cx);
+          boolector_release (d_btor, cy);
+          boolector_release (d_btor, cq);
+          boolector_release (d_btor, cr);
+          boolector_release (d_btor, q);
+          boolector_release (d_btor, r);
+          boolector_release (d_btor, eqx);
+          boolector_release (d_btor, eqy);
+          boolector_release (d_btor, eqq);
+          boolector_release (d_btor, eqr);
+          boolector_release (d_btor, eqqr);
+          boolector_release (d_btor, neqqr);
+          boolector_delete (d_btor);
+          d_btor = nullptr;
+        }
+      }
+    }
+  }
+
   static int32_t add (int32_t x, int32_t y) { return x + y; }
 
   static int32_t sub (int32_t x, int32_t y) { return x - y; }
@@ -230,6 +298,12 @@ TEST_F (TestArith, urem_u)
                      0);
 }
 
+TEST_F (TestArith, udiv_urem_u)
+{
+  udiv_urem_test (BTOR_TEST_ARITHMETIC_LOW, BTOR_TEST_ARITHMETIC_HIGH, false);
+  udiv_urem_test (BTOR_TEST_ARITHMETIC_LOW, BTOR_TEST_ARITHMETIC_HIGH, true);
+}
+
 TEST_F (TestArith, add_s)
 {
   s_arithmetic_test (add,
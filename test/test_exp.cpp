@@ -13,7 +13,9 @@
 extern "C" {
 #include "btorcore.h"
 #include "btorexp.h"
+#include "btormodel.h"
 #include "dumper/btordumpbtor.h"
+#include "preprocess/btorpreprocess.h"
 }
 
 class TestExp : public TestBtor
@@ -935,3 +937,79 @@ TEST_F (TestExp, dec)
   btor_node_release (d_btor, exp2);
   btor_node_release (d_btor, exp3);
 }
+
+TEST_F (TestExp, rw_profile)
+{
+  BtorNode *exp1, *exp2, *exp3, *exp4;
+  BtorSortId sort;
+  BtorPtrHashBucket *b;
+  BtorRwRuleProfile *p;
+
+  btor_opt_set (d_btor, BTOR_OPT_RW_PROFILE, 1);
+  sort = btor_sort_bv (d_btor, 8);
+
+  exp1 = btor_exp_var (d_btor, sort, "v1");
+  exp2 = btor_exp_bv_slice (d_btor, exp1, 6, 1);
+  exp3 = btor_exp_bv_slice (d_btor, exp2, 3, 2);
+  exp4 = btor_exp_bv_slice (d_btor, exp1, 4, 3);
+
+  ASSERT_EQ (exp3, exp4);
+  b = btor_hashptr_table_get (d_btor->stats.rw_rules_profile, "slice_slice");
+  ASSERT_NE (b, nullptr);
+  p = (BtorRwRuleProfile *) b->data.as_ptr;
+  /* only checked for slices of slices */
+  ASSERT_EQ (p->attempts, 1u);
+  ASSERT_EQ (p->hits, 1u);
+  ASSERT_EQ (p->bound, 0u);
+  b = btor_hashptr_table_get (d_btor->stats.rw_rules_profile, "full_slice");
+  ASSERT_NE (b, nullptr);
+  p = (BtorRwRuleProfile *) b->data.as_ptr;
+  ASSERT_EQ (p->attempts, 4u);
+  ASSERT_EQ (p->hits, 0u);
+
+  btor_reset_stats (d_btor);
+  ASSERT_EQ (d_btor->stats.rw_rules_profile->count, 0u);
+
+  btor_sort_release (d_btor, sort);
+  btor_node_release (d_btor, exp1);
+  btor_node_release (d_btor, exp2);
+  btor_node_release (d_btor, exp3);
+  btor_node_release (d_btor, exp4);
+}
+
+TEST_F (TestExp, rw_deferred)
+{
+  BtorNode *exp, *zero, *eq, *v;
+  BtorSortId sort;
+  uint32_t i;
+
+  btor_opt_set (d_btor, BTOR_OPT_RW_DEFERRED, 10);
+  btor_opt_set (d_btor, BTOR_OPT_VAR_SUBST, 0);
+  sort = btor_sort_bv (d_btor, 2);
+
+  /* 0 == a | b  -->  a == 0 && b == 0 recurses on b, deeper than the
+   * recursive rewriting bound */
+  exp = btor_exp_var (d_btor, sort, 0);
+  for (i = 0; i < 5000; i++)
+  {
+    v   = btor_exp_var (d_btor, sort, 0);
+    eq  = btor_exp_bv_or (d_btor, v, exp);
+    btor_node_release (d_btor, v);
+    btor_node_release (d_btor, exp);
+    exp = eq;
+  }
+  zero = btor_exp_bv_zero (d_btor, sort);
+  eq   = btor_exp_eq (d_btor, zero, exp);
+  ASSERT_GT (d_btor->rw_deferred->count, 0u);
+
+  btor_assert_exp (d_btor, eq);
+  btor_simplify (d_btor);
+  ASSERT_EQ (d_btor->rw_deferred->count, 0u);
+  ASSERT_GT (d_btor->stats.rw_deferred_nodes, 0u);
+  ASSERT_GT (d_btor->stats.rw_deferred_rounds, 0u);
+
+  btor_sort_release (d_btor, sort);
+  btor_node_release (d_btor, zero);
+  btor_node_release (d_btor, exp);
+  btor_node_release (d_btor, eq);
+}
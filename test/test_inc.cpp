@@ -11,14 +11,18 @@
 
 #include "test.h"
 
+#include <vector>
+
 extern "C" {
+#include "btoraig.h"
 #include "btoropt.h"
+#include "btorslvfun.h"
 }
 
 class TestInc : public TestBoolector
 {
  protected:
-  void test_inc_counter (uint32_t w, bool nondet)
+  void test_inc_counter (uint32_t w, bool nondet, bool lazy_encode = false)
   {
     assert (w > 0);
 
@@ -30,6 +34,11 @@ class TestInc : public TestBoolector
     int32_t res;
 
     boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+    if (lazy_encode)
+    {
+      boolector_set_opt (d_btor, BTOR_OPT_LAZY_ENCODE, 1);
+      boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    }
     s       = boolector_bitvec_sort (d_btor, w);
     one     = boolector_one (d_btor, s);
     current = boolector_zero (d_btor, s);
@@ -74,6 +83,13 @@ class TestInc : public TestBoolector
       res = boolector_sat (d_btor);
       if (res == BOOLECTOR_SAT)
       {
+        if (lazy_encode)
+        {
+          /* not encoded AIGs are evaluated */
+          const char *bits = boolector_bv_assignment (d_btor, current);
+          ASSERT_EQ (std::string (bits), std::string (w, '0'));
+          boolector_free_bv_assignment (d_btor, bits);
+        }
         boolector_release (d_btor, allzero);
         break;
       }
@@ -133,6 +149,72 @@ class TestInc : public TestBoolector
 
     boolector_release (d_btor, prev);
   }
+
+  /* Reads at 2^bw + 1 indices of width 'bw' cannot be pairwise distinct,
+   * but any 2^bw of them can. */
+  void test_inc_distinct_reads (BtorOption opt, uint32_t bw)
+  {
+    BoolectorNode *array;
+    BoolectorSort is, es, as;
+    uint32_t i, j, n;
+
+    n = (1u << bw) + 1;
+    std::vector<BoolectorNode *> index (n), read (n), ne;
+
+    boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    boolector_set_opt (d_btor, opt, 1);
+    is    = boolector_bitvec_sort (d_btor, bw);
+    es    = boolector_bitvec_sort (d_btor, bw + 2);
+    as    = boolector_array_sort (d_btor, is, es);
+    array = boolector_array (d_btor, as, "array");
+    for (i = 0; i < n; i++)
+    {
+      index[i] = boolector_var (d_btor, is, 0);
+      read[i]  = boolector_read (d_btor, array, index[i]);
+      for (j = 0; j < i; j++)
+        ne.push_back (boolector_ne (d_btor, read[i], read[j]));
+    }
+
+    for (BoolectorNode *e : ne) boolector_assume (d_btor, e);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+    /* 'ne' holds the constraints over the first n - 1 reads first */
+    for (i = 0; i < (n - 1) * (n - 2) / 2; i++)
+      boolector_assume (d_btor, ne[i]);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    for (i = 0; i < n - 1; i++)
+      for (j = 0; j < i; j++)
+      {
+        const char *a = boolector_bv_assignment (d_btor, index[i]);
+        const char *b = boolector_bv_assignment (d_btor, index[j]);
+        ASSERT_NE (std::string (a), std::string (b));
+        boolector_free_bv_assignment (d_btor, a);
+        boolector_free_bv_assignment (d_btor, b);
+      }
+
+    for (BoolectorNode *e : ne) boolector_release (d_btor, e);
+    for (i = 0; i < n; i++)
+    {
+      boolector_release (d_btor, read[i]);
+      boolector_release (d_btor, index[i]);
+    }
+    boolector_release (d_btor, array);
+    boolector_release_sort (d_btor, is);
+    boolector_release_sort (d_btor, es);
+    boolector_release_sort (d_btor, as);
+  }
+
+  uint32_t bv_value (BoolectorNode *exp)
+  {
+    const char *bits;
+    uint32_t res;
+
+    bits = boolector_bv_assignment (d_btor, exp);
+    res  = strtoul (bits, 0, 2);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
 };
 
 TEST_F (TestInc, true_false)
@@ -177,6 +259,57 @@ TEST_F (TestInc, count4nondet) { test_inc_counter (4, true); }
 
 TEST_F (TestInc, count8nondet) { test_inc_counter (8, true); }
 
+TEST_F (TestInc, count4nondetlazy) { test_inc_counter (4, true, true); }
+
+TEST_F (TestInc, lazy_encode)
+{
+  BoolectorNode *x, *y, *c, *mul, *add, *eq_mul, *eq_add;
+  BoolectorSort s;
+  const char *bits;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_LAZY_ENCODE, 1);
+  s      = boolector_bitvec_sort (d_btor, 8);
+  x      = boolector_var (d_btor, s, "x");
+  y      = boolector_var (d_btor, s, "y");
+  c      = boolector_unsigned_int (d_btor, 143, s);
+  mul    = boolector_mul (d_btor, x, y);
+  add    = boolector_add (d_btor, x, y);
+  eq_mul = boolector_eq (d_btor, mul, c);
+  eq_add = boolector_eq (d_btor, add, c);
+
+  boolector_assume (d_btor, eq_mul);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  bits = boolector_bv_assignment (d_btor, mul);
+  ASSERT_EQ (std::string (bits), "10001111");
+  boolector_free_bv_assignment (d_btor, bits);
+
+  /* the cone of 'eq_mul' is not needed anymore */
+  boolector_assume (d_btor, eq_add);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (btor_get_aig_mgr (d_btor)->num_cnf_vars_retired, 0u);
+  bits = boolector_bv_assignment (d_btor, add);
+  ASSERT_EQ (std::string (bits), "10001111");
+  boolector_free_bv_assignment (d_btor, bits);
+
+  /* re-encode retired cone */
+  boolector_assume (d_btor, eq_mul);
+  boolector_assume (d_btor, eq_add);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_TRUE (boolector_failed (d_btor, eq_mul)
+               || boolector_failed (d_btor, eq_add));
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, add);
+  boolector_release (d_btor, eq_mul);
+  boolector_release (d_btor, eq_add);
+  boolector_release_sort (d_btor, s);
+}
+
 TEST_F (TestInc, lt1) { test_inc_lt (1); }
 
 TEST_F (TestInc, lt2) { test_inc_lt (2); }
@@ -258,3 +391,565 @@ TEST_F (TestInc, lemmas_on_demand1)
   boolector_release_sort (d_btor, s);
   boolector_release_sort (d_btor, as);
 }
+
+TEST_F (TestInc, inc_check)
+{
+  test_inc_distinct_reads (BTOR_OPT_FUN_INC_CHECK, 3);
+  ASSERT_GT (BTOR_FUN_SOLVER (d_btor)->stats.apps_replayed, 0u);
+}
+
+TEST_F (TestInc, store_chains)
+{
+  BoolectorNode *array, *stores, *index, *read, *val, *tmp, *c16, *lt, *ne;
+  BoolectorSort s, as;
+  uint32_t i;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_STORE_CHAINS, 1);
+  /* keep the stores below from being turned into a lambda */
+  boolector_set_opt (d_btor, BTOR_OPT_EXTRACT_LAMBDAS, 0);
+  s      = boolector_bitvec_sort (d_btor, 5);
+  as     = boolector_array_sort (d_btor, s, s);
+  array  = boolector_array (d_btor, as, "array");
+  stores = boolector_copy (d_btor, array);
+  for (i = 0; i < 16; i++)
+  {
+    index = boolector_unsigned_int (d_btor, i, s);
+    val   = boolector_unsigned_int (d_btor, i + 1, s);
+    tmp   = boolector_write (d_btor, stores, index, val);
+    boolector_release (d_btor, stores);
+    boolector_release (d_btor, index);
+    boolector_release (d_btor, val);
+    stores = tmp;
+  }
+  index = boolector_var (d_btor, s, "index");
+  read  = boolector_read (d_btor, stores, index);
+  tmp   = boolector_inc (d_btor, index);
+  ne    = boolector_ne (d_btor, read, tmp);
+  boolector_release (d_btor, tmp);
+  c16 = boolector_unsigned_int (d_btor, 16, s);
+  lt  = boolector_ult (d_btor, index, c16);
+
+  /* reads beyond the stored indices skip the whole chain */
+  boolector_assume (d_btor, ne);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (BTOR_FUN_SOLVER (d_btor)->stats.store_chain_skips, 0u);
+
+  boolector_assume (d_btor, ne);
+  boolector_assume (d_btor, lt);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+  boolector_release (d_btor, lt);
+  boolector_release (d_btor, c16);
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, read);
+  boolector_release (d_btor, index);
+  boolector_release (d_btor, stores);
+  boolector_release (d_btor, array);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, as);
+}
+
+TEST_F (TestInc, betap_cache)
+{
+  BoolectorNode *array, *c, *nc, *i, *j, *param, *one, *read, *add, *ite, *fun;
+  BoolectorNode *fi, *fj, *ne_ij, *eq_f, *ne_f;
+  BoolectorSort s, bs, as;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_BETAP_CACHE, 1);
+  s     = boolector_bitvec_sort (d_btor, 3);
+  bs    = boolector_bool_sort (d_btor);
+  as    = boolector_array_sort (d_btor, s, s);
+  array = boolector_array (d_btor, as, "array");
+  c     = boolector_var (d_btor, bs, "c");
+  nc    = boolector_not (d_btor, c);
+  i     = boolector_var (d_btor, s, "i");
+  j     = boolector_var (d_btor, s, "j");
+  param = boolector_param (d_btor, s, "x");
+  one   = boolector_one (d_btor, s);
+  read  = boolector_read (d_btor, array, param);
+  add   = boolector_add (d_btor, param, one);
+  ite   = boolector_cond (d_btor, c, read, add);
+  fun   = boolector_fun (d_btor, &param, 1, ite);
+  fi    = boolector_apply (d_btor, &i, 1, fun);
+  fj    = boolector_apply (d_btor, &j, 1, fun);
+  ne_ij = boolector_ne (d_btor, i, j);
+  eq_f  = boolector_eq (d_btor, fi, fj);
+  ne_f  = boolector_ne (d_btor, fi, fj);
+
+  /* f reduces to a read of 'array' if c is true */
+  boolector_assume (d_btor, c);
+  boolector_assume (d_btor, ne_f);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_NE (bv_value (i), bv_value (j));
+
+  /* the results cached for c = true must not be reused for c = false */
+  boolector_assume (d_btor, nc);
+  boolector_assume (d_btor, ne_ij);
+  boolector_assume (d_btor, eq_f);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+  boolector_assume (d_btor, nc);
+  boolector_assume (d_btor, ne_f);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (bv_value (fi), (bv_value (i) + 1) % 8);
+  ASSERT_EQ (bv_value (fj), (bv_value (j) + 1) % 8);
+
+  /* and vice versa */
+  boolector_assume (d_btor, c);
+  boolector_assume (d_btor, ne_ij);
+  boolector_assume (d_btor, eq_f);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_NE (bv_value (i), bv_value (j));
+  ASSERT_EQ (bv_value (fi), bv_value (fj));
+  ASSERT_GT (BTOR_FUN_SOLVER (d_btor)->stats.betap_cache_hits, 0u);
+
+  boolector_release (d_btor, ne_f);
+  boolector_release (d_btor, eq_f);
+  boolector_release (d_btor, ne_ij);
+  boolector_release (d_btor, fj);
+  boolector_release (d_btor, fi);
+  boolector_release (d_btor, fun);
+  boolector_release (d_btor, ite);
+  boolector_release (d_btor, add);
+  boolector_release (d_btor, read);
+  boolector_release (d_btor, one);
+  boolector_release (d_btor, param);
+  boolector_release (d_btor, j);
+  boolector_release (d_btor, i);
+  boolector_release (d_btor, nc);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, array);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, bs);
+  boolector_release_sort (d_btor, as);
+}
+
+TEST_F (TestInc, lemma_min)
+{
+  BoolectorNode *array, *x, *y, *i, *j, *v, *c, *d, *nd, *w;
+  BoolectorNode *f, *g, *r, *s_r, *eq, *ne, *ne_s;
+  BoolectorSort s, bs, as;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_LEMMA_MIN, 1);
+  s     = boolector_bitvec_sort (d_btor, 4);
+  bs    = boolector_bool_sort (d_btor);
+  as    = boolector_array_sort (d_btor, s, s);
+  array = boolector_array (d_btor, as, "array");
+  x     = boolector_var (d_btor, s, "x");
+  y     = boolector_var (d_btor, s, "y");
+  i     = boolector_var (d_btor, s, "i");
+  j     = boolector_var (d_btor, s, "j");
+  v     = boolector_var (d_btor, s, "v");
+  d     = boolector_var (d_btor, bs, "d");
+  nd    = boolector_not (d_btor, d);
+  c     = boolector_ult (d_btor, x, y);
+  w     = boolector_write (d_btor, array, i, v);
+  f     = boolector_cond (d_btor, c, w, array);
+  g     = boolector_cond (d_btor, d, w, array);
+  r     = boolector_read (d_btor, f, j);
+  s_r   = boolector_read (d_btor, g, j);
+  eq    = boolector_eq (d_btor, i, j);
+  ne    = boolector_ne (d_btor, r, v);
+  ne_s  = boolector_ne (d_btor, s_r, v);
+
+  /* condition 'c' is a constraint and not needed in the lemma premise */
+  boolector_assert (d_btor, c);
+  boolector_assume (d_btor, eq);
+  boolector_assume (d_btor, ne);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_GT (BTOR_FUN_SOLVER (d_btor)->stats.lemma_prems_dropped, 0u);
+  boolector_assume (d_btor, ne);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_NE (bv_value (i), bv_value (j));
+  boolector_assume (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (bv_value (r), bv_value (v));
+
+  /* condition 'd' is only assumed and must stay in the lemma premise */
+  boolector_assume (d_btor, d);
+  boolector_assume (d_btor, eq);
+  boolector_assume (d_btor, ne_s);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  boolector_assume (d_btor, nd);
+  boolector_assume (d_btor, eq);
+  boolector_assume (d_btor, ne_s);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (bv_value (i), bv_value (j));
+  ASSERT_NE (bv_value (s_r), bv_value (v));
+
+  boolector_release (d_btor, ne_s);
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, eq);
+  boolector_release (d_btor, s_r);
+  boolector_release (d_btor, r);
+  boolector_release (d_btor, g);
+  boolector_release (d_btor, f);
+  boolector_release (d_btor, w);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, nd);
+  boolector_release (d_btor, d);
+  boolector_release (d_btor, v);
+  boolector_release (d_btor, j);
+  boolector_release (d_btor, i);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, array);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, bs);
+  boolector_release_sort (d_btor, as);
+}
+
+TEST_F (TestInc, dual_prop_aig)
+{
+  BoolectorNode *array, *x, *y, *c, *nc, *zero, *rx, *ry, *eq, *ne, *ite;
+  BoolectorNode *eq_xy;
+  BoolectorSort s, bs, as;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_DUAL_PROP_AIG, 1);
+  s     = boolector_bitvec_sort (d_btor, 4);
+  bs    = boolector_bool_sort (d_btor);
+  as    = boolector_array_sort (d_btor, s, s);
+  array = boolector_array (d_btor, as, "array");
+  x     = boolector_var (d_btor, s, "x");
+  y     = boolector_var (d_btor, s, "y");
+  c     = boolector_var (d_btor, bs, "c");
+  nc    = boolector_not (d_btor, c);
+  zero  = boolector_zero (d_btor, s);
+  rx    = boolector_read (d_btor, array, x);
+  ry    = boolector_read (d_btor, array, y);
+  eq    = boolector_eq (d_btor, x, zero);
+  ne    = boolector_ne (d_btor, rx, ry);
+  ite   = boolector_cond (d_btor, c, eq, ne);
+  eq_xy = boolector_eq (d_btor, x, y);
+  boolector_assert (d_btor, ite);
+
+  /* the reads are don't cares if c is true */
+  boolector_assume (d_btor, c);
+  boolector_assume (d_btor, eq_xy);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (BTOR_FUN_SOLVER (d_btor)->stats.dp_assumed_applies, 2u);
+  ASSERT_EQ (BTOR_FUN_SOLVER (d_btor)->stats.dp_failed_applies, 0u);
+  ASSERT_EQ (bv_value (x), 0u);
+  ASSERT_EQ (bv_value (y), 0u);
+
+  /* the reads are needed if c is false */
+  boolector_assume (d_btor, nc);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (BTOR_FUN_SOLVER (d_btor)->stats.dp_failed_applies, 2u);
+  ASSERT_NE (bv_value (x), bv_value (y));
+  ASSERT_NE (bv_value (rx), bv_value (ry));
+
+  boolector_assume (d_btor, nc);
+  boolector_assume (d_btor, eq_xy);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+  boolector_release (d_btor, eq_xy);
+  boolector_release (d_btor, ite);
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, eq);
+  boolector_release (d_btor, ry);
+  boolector_release (d_btor, rx);
+  boolector_release (d_btor, zero);
+  boolector_release (d_btor, nc);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, array);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, bs);
+  boolector_release_sort (d_btor, as);
+}
+
+TEST_F (TestInc, model_lazy)
+{
+  BoolectorNode *array, *f, *x, *y, *rx, *ry, *fx, *ne, *eq, *ult;
+  BoolectorSort s, as, fs;
+  const char *bx, *bfx, *bry;
+  char **args, **vals;
+  uint32_t k, size;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_LAZY, 1);
+  /* model checking queries the model right after each call */
+  boolector_set_opt (d_btor, BTOR_OPT_CHK_MODEL, 0);
+  s     = boolector_bitvec_sort (d_btor, 4);
+  as    = boolector_array_sort (d_btor, s, s);
+  fs    = boolector_fun_sort (d_btor, &s, 1, s);
+  array = boolector_array (d_btor, as, "array");
+  f     = boolector_uf (d_btor, fs, "f");
+  x     = boolector_var (d_btor, s, "x");
+  y     = boolector_var (d_btor, s, "y");
+  rx    = boolector_read (d_btor, array, x);
+  ry    = boolector_read (d_btor, array, y);
+  fx    = boolector_apply (d_btor, &x, 1, f);
+  ne    = boolector_ne (d_btor, rx, ry);
+  eq    = boolector_eq (d_btor, fx, ry);
+  boolector_assert (d_btor, ne);
+  boolector_assert (d_btor, eq);
+
+  for (k = 0; k < 3; k++)
+  {
+    if (k == 1)
+      ult = boolector_ugt (d_btor, x, y);
+    else
+      ult = boolector_ult (d_btor, x, y);
+    boolector_assume (d_btor, ult);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    /* nothing is computed until the model is queried */
+    ASSERT_EQ (d_btor->fun_model->count, 0u);
+
+    bx  = boolector_bv_assignment (d_btor, x);
+    bfx = boolector_bv_assignment (d_btor, fx);
+    bry = boolector_bv_assignment (d_btor, ry);
+    ASSERT_STREQ (bfx, bry);
+
+    /* the model of f is complete although f(x) was queried first */
+    boolector_uf_assignment (d_btor, f, &args, &vals, &size);
+    ASSERT_EQ (size, 1u);
+    ASSERT_STREQ (args[0], bx);
+    ASSERT_STREQ (vals[0], bfx);
+    boolector_free_uf_assignment (d_btor, args, vals, size);
+
+    boolector_array_assignment (d_btor, array, &args, &vals, &size);
+    ASSERT_EQ (size, 2u);
+    ASSERT_STRNE (args[0], args[1]);
+    boolector_free_array_assignment (d_btor, args, vals, size);
+
+    boolector_free_bv_assignment (d_btor, bx);
+    boolector_free_bv_assignment (d_btor, bfx);
+    boolector_free_bv_assignment (d_btor, bry);
+    boolector_release (d_btor, ult);
+  }
+
+  boolector_release (d_btor, eq);
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, fx);
+  boolector_release (d_btor, ry);
+  boolector_release (d_btor, rx);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, f);
+  boolector_release (d_btor, array);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, as);
+  boolector_release_sort (d_btor, fs);
+}
+
+TEST_F (TestInc, args_interning)
+{
+  BoolectorNode *array, *x, *y, *z, *rx, *ry, *rz, *le_xy, *le_yx, *ne_xz;
+  BoolectorNode *ne_xy;
+  BoolectorSort s, as;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  s     = boolector_bitvec_sort (d_btor, 4);
+  as    = boolector_array_sort (d_btor, s, s);
+  array = boolector_array (d_btor, as, "array");
+  x     = boolector_var (d_btor, s, "x");
+  y     = boolector_var (d_btor, s, "y");
+  z     = boolector_var (d_btor, s, "z");
+  rx    = boolector_read (d_btor, array, x);
+  ry    = boolector_read (d_btor, array, y);
+  rz    = boolector_read (d_btor, array, z);
+  le_xy = boolector_ulte (d_btor, x, y);
+  le_yx = boolector_ulte (d_btor, y, x);
+  ne_xz = boolector_ne (d_btor, rx, rz);
+  ne_xy = boolector_ne (d_btor, rx, ry);
+  boolector_assert (d_btor, le_xy);
+  boolector_assert (d_btor, le_yx);
+  boolector_assert (d_btor, ne_xz);
+
+  /* the args of both reads are interned to the same assignment */
+  boolector_assume (d_btor, ne_xy);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_GT (BTOR_FUN_SOLVER (d_btor)->stats.args_interned, 0u);
+
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (bv_value (x), bv_value (y));
+  ASSERT_NE (bv_value (x), bv_value (z));
+  ASSERT_EQ (bv_value (rx), bv_value (ry));
+  ASSERT_NE (bv_value (rx), bv_value (rz));
+
+  boolector_release (d_btor, ne_xy);
+  boolector_release (d_btor, ne_xz);
+  boolector_release (d_btor, le_yx);
+  boolector_release (d_btor, le_xy);
+  boolector_release (d_btor, rz);
+  boolector_release (d_btor, ry);
+  boolector_release (d_btor, rx);
+  boolector_release (d_btor, z);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, array);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, as);
+}
+
+TEST_F (TestInc, components)
+{
+  BoolectorNode *a, *b, *c, *d, *zero, *c15, *c16, *mul, *add, *eq1, *eq2, *ult;
+  BoolectorNode *eqa, *eqcd;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_COMPONENTS, 2);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  s = boolector_bitvec_sort (d_btor, 8);
+
+  a    = boolector_var (d_btor, s, "a");
+  b    = boolector_var (d_btor, s, "b");
+  c    = boolector_var (d_btor, s, "c");
+  d    = boolector_var (d_btor, s, "d");
+  zero = boolector_zero (d_btor, s);
+  c15  = boolector_unsigned_int (d_btor, 15, s);
+  c16  = boolector_unsigned_int (d_btor, 16, s);
+  mul  = boolector_mul (d_btor, a, b);
+  add  = boolector_add (d_btor, c, d);
+  eq1  = boolector_eq (d_btor, mul, c15);
+  eq2  = boolector_eq (d_btor, add, c16);
+  ult  = boolector_ult (d_btor, c, d);
+  eqa  = boolector_eq (d_btor, a, zero);
+  eqcd = boolector_eq (d_btor, c, d);
+
+  boolector_assert (d_btor, eq1);
+  boolector_assert (d_btor, eq2);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.components_cached, 0u);
+
+  /* component of a * b = 15 is reused */
+  boolector_assert (d_btor, ult);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.components_cached, 1u);
+  ASSERT_EQ (bv_value (mul), 15u);
+  ASSERT_LT (bv_value (c), bv_value (d));
+
+  /* component of c + d = 16 /\ c < d is reused */
+  boolector_assert (d_btor, eqa);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_EQ (d_btor->stats.components_cached, 2u);
+
+  /* cached unsatisfiable component of a decides the call */
+  boolector_assert (d_btor, eqcd);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_EQ (d_btor->stats.components_cached, 3u);
+
+  boolector_release (d_btor, a);
+  boolector_release (d_btor, b);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, d);
+  boolector_release (d_btor, zero);
+  boolector_release (d_btor, c15);
+  boolector_release (d_btor, c16);
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, add);
+  boolector_release (d_btor, eq1);
+  boolector_release (d_btor, eq2);
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, eqa);
+  boolector_release (d_btor, eqcd);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, incremental_preproc)
+{
+  BoolectorNode *x, *y, *zero, *c5, *ne, *slx, *sly, *eqx, *eqy;
+  BoolectorSort s, s4;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL_PREPROC, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  s  = boolector_bitvec_sort (d_btor, 8);
+  s4 = boolector_bitvec_sort (d_btor, 4);
+
+  x    = boolector_var (d_btor, s, "x");
+  y    = boolector_var (d_btor, s, "y");
+  zero = boolector_zero (d_btor, s);
+  c5   = boolector_unsigned_int (d_btor, 5, s4);
+  ne   = boolector_ne (d_btor, y, zero);
+
+  boolector_assert (d_btor, ne);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.eliminated_slices, 0u);
+
+  /* x is not encoded yet and is split */
+  slx = boolector_slice (d_btor, x, 3, 0);
+  eqx = boolector_eq (d_btor, slx, c5);
+  boolector_assert (d_btor, eqx);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.eliminated_slices, 1u);
+  ASSERT_EQ (bv_value (slx), 5u);
+
+  /* y is frozen, its encoding is kept */
+  sly = boolector_slice (d_btor, y, 3, 0);
+  eqy = boolector_eq (d_btor, sly, c5);
+  boolector_assume (d_btor, eqy);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.eliminated_slices, 1u);
+  ASSERT_EQ (d_btor->stats.rewrite_synth, 0u);
+  ASSERT_EQ (bv_value (sly), 5u);
+  ASSERT_NE (bv_value (y), 0u);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, zero);
+  boolector_release (d_btor, c5);
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, slx);
+  boolector_release (d_btor, sly);
+  boolector_release (d_btor, eqx);
+  boolector_release (d_btor, eqy);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, s4);
+}
+
+TEST_F (TestInc, ucopt)
+{
+  BoolectorNode *x, *y, *mul, *six, *three, *eq1, *eq2;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_UCOPT, 1);
+  s = boolector_bitvec_sort (d_btor, 8);
+
+  x     = boolector_var (d_btor, s, "x");
+  y     = boolector_var (d_btor, s, "y");
+  mul   = boolector_mul (d_btor, x, y);
+  six   = boolector_unsigned_int (d_btor, 6, s);
+  three = boolector_unsigned_int (d_btor, 3, s);
+  eq1   = boolector_eq (d_btor, mul, six);
+
+  /* x * y = 6 is eliminated, x and y are computed from the model */
+  boolector_assert (d_btor, eq1);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GE (d_btor->stats.bv_uc_props, 2u);
+  ASSERT_EQ (d_btor->stats.uc_restored, 0u);
+  ASSERT_EQ ((bv_value (x) * bv_value (y)) & 0xffu, 6u);
+
+  /* x is used again, the definitions of x * y = 6 are restored */
+  eq2 = boolector_eq (d_btor, x, three);
+  boolector_assert (d_btor, eq2);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.uc_restored, 2u);
+  ASSERT_EQ (bv_value (x), 3u);
+  ASSERT_EQ (bv_value (y), 2u);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, six);
+  boolector_release (d_btor, three);
+  boolector_release (d_btor, eq1);
+  boolector_release (d_btor, eq2);
+  boolector_release_sort (d_btor, s);
+}
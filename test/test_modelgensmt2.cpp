@@ -186,3 +186,16 @@ TEST_F (TestModelGenSMT2, modelgensmt227)
 {
   run_modelgen_smt2_test ("modelgensmt227", ".smt2", 3);
 }
+
+TEST_F (TestModelGenSMT2, modelgensmt228)
+{
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_RANGES, 1);
+  run_modelgen_smt2_test ("modelgensmt228", ".smt2", 3);
+}
+
+TEST_F (TestModelGenSMT2, modelgensmt229)
+{
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_RANGES, 1);
+  run_modelgen_smt2_test ("modelgensmt229", ".smt2", 3);
+  check_log_file ();
+}
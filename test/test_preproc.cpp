@@ -0,0 +1,450 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btormodel.h"
+#include "preprocess/btorpreprocess.h"
+}
+
+class TestPreproc : public TestBtor
+{
+};
+
+TEST_F (TestPreproc, egraph)
+{
+  BtorNode *a, *b, *c, *x, *ac, *bc, *xc, *add, *eq;
+  BtorSortId sort;
+
+  btor_opt_set (d_btor, BTOR_OPT_EGRAPH, 5);
+  sort = btor_sort_bv (d_btor, 8);
+
+  /* x * c = a * c + b * c  -->  x * c = (a + b) * c */
+  a   = btor_exp_var (d_btor, sort, "a");
+  b   = btor_exp_var (d_btor, sort, "b");
+  c   = btor_exp_var (d_btor, sort, "c");
+  x   = btor_exp_var (d_btor, sort, "x");
+  ac  = btor_exp_bv_mul (d_btor, a, c);
+  bc  = btor_exp_bv_mul (d_btor, b, c);
+  xc  = btor_exp_bv_mul (d_btor, x, c);
+  add = btor_exp_bv_add (d_btor, ac, bc);
+  eq  = btor_exp_eq (d_btor, xc, add);
+
+  btor_assert_exp (d_btor, eq);
+  btor_simplify (d_btor);
+  ASSERT_EQ (d_btor->stats.egraph_substitutions, 1u);
+  ASSERT_TRUE (btor_node_is_simplified (eq));
+
+  btor_sort_release (d_btor, sort);
+  btor_node_release (d_btor, a);
+  btor_node_release (d_btor, b);
+  btor_node_release (d_btor, c);
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, ac);
+  btor_node_release (d_btor, bc);
+  btor_node_release (d_btor, xc);
+  btor_node_release (d_btor, add);
+  btor_node_release (d_btor, eq);
+}
+
+TEST_F (TestPreproc, egraph_sat)
+{
+  BtorNode *a, *b, *c, *x, *one, *ac, *bc, *xc, *add, *ab, *eq, *ne, *ult;
+  BtorSortId sort;
+  uint64_t va, vb, vc, vx;
+
+  btor_opt_set (d_btor, BTOR_OPT_EGRAPH, 5);
+  btor_opt_set (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  sort = btor_sort_bv (d_btor, 8);
+
+  /* x * c = a * c + b * c  /\  x != a + b  /\  1 < c */
+  a   = btor_exp_var (d_btor, sort, "a");
+  b   = btor_exp_var (d_btor, sort, "b");
+  c   = btor_exp_var (d_btor, sort, "c");
+  x   = btor_exp_var (d_btor, sort, "x");
+  one = btor_exp_bv_one (d_btor, sort);
+  ac  = btor_exp_bv_mul (d_btor, a, c);
+  bc  = btor_exp_bv_mul (d_btor, b, c);
+  xc  = btor_exp_bv_mul (d_btor, x, c);
+  add = btor_exp_bv_add (d_btor, ac, bc);
+  ab  = btor_exp_bv_add (d_btor, a, b);
+  eq  = btor_exp_eq (d_btor, xc, add);
+  ne  = btor_exp_ne (d_btor, x, ab);
+  ult = btor_exp_bv_ult (d_btor, one, c);
+
+  /* the clone for model checking copies all references to 'sort' */
+  btor_sort_release (d_btor, sort);
+
+  btor_assert_exp (d_btor, eq);
+  btor_assert_exp (d_btor, ne);
+  btor_assert_exp (d_btor, ult);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_GE (d_btor->stats.egraph_substitutions, 1u);
+  ASSERT_FALSE (d_btor->inconsistent);
+
+  va = btor_bv_to_uint64 (btor_model_get_bv (d_btor, a));
+  vb = btor_bv_to_uint64 (btor_model_get_bv (d_btor, b));
+  vc = btor_bv_to_uint64 (btor_model_get_bv (d_btor, c));
+  vx = btor_bv_to_uint64 (btor_model_get_bv (d_btor, x));
+  ASSERT_EQ ((vx * vc) & 0xffu, (va * vc + vb * vc) & 0xffu);
+  ASSERT_NE (vx, (va + vb) & 0xffu);
+  ASSERT_GT (vc, 1u);
+
+  btor_node_release (d_btor, a);
+  btor_node_release (d_btor, b);
+  btor_node_release (d_btor, c);
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, one);
+  btor_node_release (d_btor, ac);
+  btor_node_release (d_btor, bc);
+  btor_node_release (d_btor, xc);
+  btor_node_release (d_btor, add);
+  btor_node_release (d_btor, ab);
+  btor_node_release (d_btor, eq);
+  btor_node_release (d_btor, ne);
+  btor_node_release (d_btor, ult);
+}
+
+TEST_F (TestPreproc, components)
+{
+  BtorNode *a, *b, *c, *d, *c15, *c16, *mul, *add, *eq1, *eq2, *ult;
+  BtorSortId sort;
+
+  btor_opt_set (d_btor, BTOR_OPT_COMPONENTS, 2);
+  btor_opt_set (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  sort = btor_sort_bv (d_btor, 8);
+
+  /* a * b = 15  and  c + d = 16 /\ c < d */
+  a   = btor_exp_var (d_btor, sort, "a");
+  b   = btor_exp_var (d_btor, sort, "b");
+  c   = btor_exp_var (d_btor, sort, "c");
+  d   = btor_exp_var (d_btor, sort, "d");
+  c15 = btor_exp_bv_unsigned (d_btor, 15, sort);
+  c16 = btor_exp_bv_unsigned (d_btor, 16, sort);
+  mul = btor_exp_bv_mul (d_btor, a, b);
+  add = btor_exp_bv_add (d_btor, c, d);
+  eq1 = btor_exp_eq (d_btor, mul, c15);
+  eq2 = btor_exp_eq (d_btor, add, c16);
+  ult = btor_exp_bv_ult (d_btor, c, d);
+
+  /* the clone for model checking copies all references to 'sort' */
+  btor_sort_release (d_btor, sort);
+
+  btor_assert_exp (d_btor, eq1);
+  btor_assert_exp (d_btor, eq2);
+  btor_assert_exp (d_btor, ult);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (d_btor->stats.components, 2u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, mul)), 15u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, add)), 16u);
+  ASSERT_TRUE (btor_bv_is_true (btor_model_get_bv (d_btor, ult)));
+
+  btor_node_release (d_btor, a);
+  btor_node_release (d_btor, b);
+  btor_node_release (d_btor, c);
+  btor_node_release (d_btor, d);
+  btor_node_release (d_btor, c15);
+  btor_node_release (d_btor, c16);
+  btor_node_release (d_btor, mul);
+  btor_node_release (d_btor, add);
+  btor_node_release (d_btor, eq1);
+  btor_node_release (d_btor, eq2);
+  btor_node_release (d_btor, ult);
+}
+
+TEST_F (TestPreproc, known_bits)
+{
+  BtorNode *x, *y, *mask, *c3, *band, *eq, *add, *ult, *sl;
+  BtorSortId sort;
+
+  btor_opt_set (d_btor, BTOR_OPT_KNOWN_BITS, 4);
+  btor_opt_set (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  sort = btor_sort_bv (d_btor, 8);
+
+  /* x & 0xf0 = 0x30 fixes x[7:4], x is split into 0x3 :: x[3:0] */
+  x    = btor_exp_var (d_btor, sort, "x");
+  y    = btor_exp_var (d_btor, sort, "y");
+  mask = btor_exp_bv_unsigned (d_btor, 0xf0, sort);
+  c3   = btor_exp_bv_unsigned (d_btor, 0x30, sort);
+  band = btor_exp_bv_and (d_btor, x, mask);
+  eq   = btor_exp_eq (d_btor, band, c3);
+  add  = btor_exp_bv_add (d_btor, x, y);
+  ult  = btor_exp_bv_ult (d_btor, add, x);
+  sl   = btor_exp_bv_slice (d_btor, x, 7, 4);
+
+  btor_sort_release (d_btor, sort);
+
+  btor_assert_exp (d_btor, eq);
+  btor_assert_exp (d_btor, ult);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_GE (d_btor->stats.known_bits_vars, 1u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, sl)), 3u);
+
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, mask);
+  btor_node_release (d_btor, c3);
+  btor_node_release (d_btor, band);
+  btor_node_release (d_btor, eq);
+  btor_node_release (d_btor, add);
+  btor_node_release (d_btor, ult);
+  btor_node_release (d_btor, sl);
+}
+
+TEST_F (TestPreproc, known_bits_and)
+{
+  BtorNode *x, *y, *z, *mask, *band, *zand, *eq1, *eq2;
+  BtorSortId sort;
+
+  btor_opt_set (d_btor, BTOR_OPT_KNOWN_BITS, 4);
+  btor_opt_set (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  /* x & y = z would be solved for z otherwise */
+  btor_opt_set (d_btor, BTOR_OPT_VAR_SUBST, 0);
+  sort = btor_sort_bv (d_btor, 8);
+
+  /* z[3:0] = 0xf and x & y = z fix x[3:0] and y[3:0] to 1 */
+  x    = btor_exp_var (d_btor, sort, "x");
+  y    = btor_exp_var (d_btor, sort, "y");
+  z    = btor_exp_var (d_btor, sort, "z");
+  mask = btor_exp_bv_unsigned (d_btor, 0x0f, sort);
+  band = btor_exp_bv_and (d_btor, x, y);
+  zand = btor_exp_bv_and (d_btor, z, mask);
+  eq1  = btor_exp_eq (d_btor, band, z);
+  eq2  = btor_exp_eq (d_btor, zand, mask);
+
+  btor_sort_release (d_btor, sort);
+
+  btor_assert_exp (d_btor, eq1);
+  btor_assert_exp (d_btor, eq2);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (d_btor->stats.known_bits_vars, 3u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, x)) & 0x0f, 0x0fu);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, y)) & 0x0f, 0x0fu);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, band)),
+             btor_bv_to_uint64 (btor_model_get_bv (d_btor, z)));
+
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, z);
+  btor_node_release (d_btor, mask);
+  btor_node_release (d_btor, band);
+  btor_node_release (d_btor, zand);
+  btor_node_release (d_btor, eq1);
+  btor_node_release (d_btor, eq2);
+}
+
+TEST_F (TestPreproc, known_bits_ite)
+{
+  BtorNode *c, *x, *y, *mask, *c4, *band, *eq1, *cond, *eq2;
+  BtorSortId sort, sort1;
+
+  btor_opt_set (d_btor, BTOR_OPT_KNOWN_BITS, 4);
+  btor_opt_set (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  sort  = btor_sort_bv (d_btor, 8);
+  sort1 = btor_sort_bool (d_btor);
+
+  /* x & 3 = 3 contradicts (c ? x : y) = 4, hence c = 0 and y = 4 */
+  c    = btor_exp_var (d_btor, sort1, "c");
+  x    = btor_exp_var (d_btor, sort, "x");
+  y    = btor_exp_var (d_btor, sort, "y");
+  mask = btor_exp_bv_unsigned (d_btor, 3, sort);
+  c4   = btor_exp_bv_unsigned (d_btor, 4, sort);
+  band = btor_exp_bv_and (d_btor, x, mask);
+  eq1  = btor_exp_eq (d_btor, band, mask);
+  cond = btor_exp_cond (d_btor, c, x, y);
+  eq2  = btor_exp_eq (d_btor, cond, c4);
+
+  btor_sort_release (d_btor, sort);
+  btor_sort_release (d_btor, sort1);
+
+  btor_assert_exp (d_btor, eq1);
+  btor_assert_exp (d_btor, eq2);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (d_btor->stats.known_bits_vars, 3u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, c)), 0u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, y)), 4u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, band)), 3u);
+
+  btor_node_release (d_btor, c);
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, mask);
+  btor_node_release (d_btor, c4);
+  btor_node_release (d_btor, band);
+  btor_node_release (d_btor, eq1);
+  btor_node_release (d_btor, cond);
+  btor_node_release (d_btor, eq2);
+}
+
+TEST_F (TestPreproc, known_bits_add)
+{
+  BtorNode *x, *y, *mask, *c3, *c35, *band, *add, *eq1, *eq2;
+  BtorSortId sort;
+
+  btor_opt_set (d_btor, BTOR_OPT_KNOWN_BITS, 4);
+  btor_opt_set (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  /* x + y = 0x35 would be solved for x otherwise */
+  btor_opt_set (d_btor, BTOR_OPT_VAR_SUBST, 0);
+  sort = btor_sort_bv (d_btor, 8);
+
+  /* y[3:0] = 3 and x + y = 0x35 imply x[3:0] = 2 */
+  x    = btor_exp_var (d_btor, sort, "x");
+  y    = btor_exp_var (d_btor, sort, "y");
+  mask = btor_exp_bv_unsigned (d_btor, 0x0f, sort);
+  c3   = btor_exp_bv_unsigned (d_btor, 3, sort);
+  c35  = btor_exp_bv_unsigned (d_btor, 0x35, sort);
+  band = btor_exp_bv_and (d_btor, y, mask);
+  add  = btor_exp_bv_add (d_btor, x, y);
+  eq1  = btor_exp_eq (d_btor, band, c3);
+  eq2  = btor_exp_eq (d_btor, add, c35);
+
+  btor_sort_release (d_btor, sort);
+
+  btor_assert_exp (d_btor, eq1);
+  btor_assert_exp (d_btor, eq2);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_GE (d_btor->stats.known_bits_vars, 2u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, x)) & 0x0f, 2u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, add)), 0x35u);
+
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, mask);
+  btor_node_release (d_btor, c3);
+  btor_node_release (d_btor, c35);
+  btor_node_release (d_btor, band);
+  btor_node_release (d_btor, add);
+  btor_node_release (d_btor, eq1);
+  btor_node_release (d_btor, eq2);
+}
+
+TEST_F (TestPreproc, known_bits_mul)
+{
+  BtorNode *x, *y, *c15, *mul, *eq;
+  BtorSortId sort;
+
+  btor_opt_set (d_btor, BTOR_OPT_KNOWN_BITS, 4);
+  btor_opt_set (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  sort = btor_sort_bv (d_btor, 8);
+
+  /* the odd product x * y = 15 implies that x and y are odd */
+  x   = btor_exp_var (d_btor, sort, "x");
+  y   = btor_exp_var (d_btor, sort, "y");
+  c15 = btor_exp_bv_unsigned (d_btor, 15, sort);
+  mul = btor_exp_bv_mul (d_btor, x, y);
+  eq  = btor_exp_eq (d_btor, mul, c15);
+
+  btor_sort_release (d_btor, sort);
+
+  btor_assert_exp (d_btor, eq);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (d_btor->stats.known_bits_vars, 2u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, x)) & 1, 1u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, y)) & 1, 1u);
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, mul)), 15u);
+
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, c15);
+  btor_node_release (d_btor, mul);
+  btor_node_release (d_btor, eq);
+}
+
+TEST_F (TestPreproc, known_bits_frozen)
+{
+  BtorNode *x, *zero, *mask, *c3, *ne, *band, *eq, *sl;
+  BtorSortId sort;
+
+  btor_opt_set (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  btor_opt_set (d_btor, BTOR_OPT_INCREMENTAL_PREPROC, 1);
+  btor_opt_set (d_btor, BTOR_OPT_KNOWN_BITS, 4);
+  btor_opt_set (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  sort = btor_sort_bv (d_btor, 8);
+
+  x    = btor_exp_var (d_btor, sort, "x");
+  zero = btor_exp_bv_zero (d_btor, sort);
+  mask = btor_exp_bv_unsigned (d_btor, 0xf0, sort);
+  c3   = btor_exp_bv_unsigned (d_btor, 0x30, sort);
+  ne   = btor_exp_ne (d_btor, x, zero);
+
+  btor_sort_release (d_btor, sort);
+
+  btor_assert_exp (d_btor, ne);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_TRUE (btor_node_is_synth (x));
+
+  /* x is encoded, its known bits are asserted on slices instead of
+   * splitting x */
+  band = btor_exp_bv_and (d_btor, x, mask);
+  eq   = btor_exp_eq (d_btor, band, c3);
+  sl   = btor_exp_bv_slice (d_btor, x, 7, 4);
+  btor_assert_exp (d_btor, eq);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (d_btor->stats.known_bits_vars, 0u);
+  ASSERT_FALSE (btor_node_is_simplified (x));
+  ASSERT_EQ (btor_bv_to_uint64 (btor_model_get_bv (d_btor, sl)), 3u);
+
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, zero);
+  btor_node_release (d_btor, mask);
+  btor_node_release (d_btor, c3);
+  btor_node_release (d_btor, ne);
+  btor_node_release (d_btor, band);
+  btor_node_release (d_btor, eq);
+  btor_node_release (d_btor, sl);
+}
+
+TEST_F (TestPreproc, bv_reduce)
+{
+  BtorNode *x, *y, *z, *sx, *sy, *mul, *eq, *ult;
+  BtorSortId sort8, sort32;
+  uint64_t vx, vy, vz;
+
+  btor_opt_set (d_btor, BTOR_OPT_BV_REDUCE, 1);
+  btor_opt_set (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  sort8  = btor_sort_bv (d_btor, 8);
+  sort32 = btor_sort_bv (d_btor, 32);
+
+  /* sext (x) * sext (y) = z  -->  sext (sext (x) * sext (y) [15:0]) = z */
+  x   = btor_exp_var (d_btor, sort8, "x");
+  y   = btor_exp_var (d_btor, sort8, "y");
+  z   = btor_exp_var (d_btor, sort32, "z");
+  sx  = btor_exp_bv_sext (d_btor, x, 24);
+  sy  = btor_exp_bv_sext (d_btor, y, 24);
+  mul = btor_exp_bv_mul (d_btor, sx, sy);
+  eq  = btor_exp_eq (d_btor, mul, z);
+  ult = btor_exp_bv_ult (d_btor, sx, sy);
+
+  btor_sort_release (d_btor, sort8);
+  btor_sort_release (d_btor, sort32);
+
+  btor_assert_exp (d_btor, eq);
+  btor_assert_exp (d_btor, ult);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+  ASSERT_GE (d_btor->stats.bv_reduced, 1u);
+  ASSERT_GT (d_btor->stats.bv_reduce_aigs, 0u);
+
+  vx = btor_bv_to_uint64 (btor_model_get_bv (d_btor, sx));
+  vy = btor_bv_to_uint64 (btor_model_get_bv (d_btor, sy));
+  vz = btor_bv_to_uint64 (btor_model_get_bv (d_btor, z));
+  ASSERT_EQ ((vx * vy) & 0xffffffffu, vz);
+  ASSERT_LT (vx, vy);
+
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, z);
+  btor_node_release (d_btor, sx);
+  btor_node_release (d_btor, sy);
+  btor_node_release (d_btor, mul);
+  btor_node_release (d_btor, eq);
+  btor_node_release (d_btor, ult);
+}
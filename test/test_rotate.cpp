@@ -9,6 +9,7 @@
 #include "test.h"
 
 extern "C" {
+#include "btorcore.h"
 #include "utils/btorutil.h"
 }
 
@@ -75,8 +76,73 @@ class TestRotate : public TestBoolector
     boolector_release (d_btor, e0);
     boolector_release_sort (d_btor, sort);
   }
+
+  /* Number of AIG ANDs of a rotation of width 'bw', either encoded directly
+   * or via shifts: (e0 << n) | (e0 >> (bw - n)) with n = e1 % bw. */
+  uint64_t count_rot_aigs (uint32_t bw, bool is_left, bool via_shifts)
+  {
+    uint64_t res;
+    Btor *btor;
+    BoolectorSort sort;
+    BoolectorNode *e0, *e1, *rot, *w, *nbits, *dbits, *lshift, *rshift, *tmp;
+    BoolectorNode *zero, *eq;
+
+    btor = boolector_new ();
+    sort = boolector_bitvec_sort (btor, bw);
+    e0   = boolector_var (btor, sort, "e0");
+    e1   = boolector_var (btor, sort, "e1");
+    if (via_shifts)
+    {
+      w      = boolector_unsigned_int (btor, bw, sort);
+      nbits  = boolector_urem (btor, e1, w);
+      dbits  = boolector_sub (btor, w, nbits);
+      lshift = boolector_sll (btor, e0, is_left ? nbits : dbits);
+      rshift = boolector_srl (btor, e0, is_left ? dbits : nbits);
+      tmp    = boolector_or (btor, lshift, rshift);
+      zero   = boolector_zero (btor, sort);
+      eq     = boolector_eq (btor, nbits, zero);
+      rot    = boolector_cond (btor, eq, e0, tmp);
+      boolector_release (btor, eq);
+      boolector_release (btor, zero);
+      boolector_release (btor, tmp);
+      boolector_release (btor, rshift);
+      boolector_release (btor, lshift);
+      boolector_release (btor, dbits);
+      boolector_release (btor, nbits);
+      boolector_release (btor, w);
+    }
+    else
+    {
+      rot = is_left ? boolector_rol (btor, e0, e1)
+                    : boolector_ror (btor, e0, e1);
+    }
+    res = btor_get_aig_mgr (btor)->cur_num_aigs;
+    btor_synthesize_exp (btor, BTOR_IMPORT_BOOLECTOR_NODE (rot), 0);
+    res = btor_get_aig_mgr (btor)->cur_num_aigs - res;
+    boolector_release (btor, rot);
+    boolector_release (btor, e1);
+    boolector_release (btor, e0);
+    boolector_release_sort (btor, sort);
+    boolector_delete (btor);
+    return res;
+  }
 };
 
+TEST_F (TestRotate, aig_count)
+{
+  uint32_t widths[] = {5, 12, 32, 33, 48, 64, 65};
+  for (uint32_t bw : widths)
+  {
+    ASSERT_LT (count_rot_aigs (bw, true, false),
+               count_rot_aigs (bw, true, true));
+    ASSERT_LT (count_rot_aigs (bw, false, false),
+               count_rot_aigs (bw, false, true));
+  }
+  /* power of 2 widths: log2(bw) stages of one multiplexer per bit */
+  ASSERT_LE (count_rot_aigs (32, true, false), 5 * 3 * 32u);
+  ASSERT_LE (count_rot_aigs (64, false, false), 6 * 3 * 64u);
+}
+
 TEST_F (TestRotate, rol_1_0) { test_rot (1, 0, true); }
 
 TEST_F (TestRotate, rol_2_0) { test_rot (2, 0, true); }
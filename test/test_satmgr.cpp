@@ -13,6 +13,7 @@
 extern "C" {
 #include "btoraig.h"
 #include "dumper/btordumpaig.h"
+#include "sat/btoripasir.h"
 }
 
 class TestSatMgr : public TestBtor
@@ -42,3 +43,82 @@ TEST_F (TestSatMgr, next_cnf_id)
   ASSERT_EQ (btor_sat_mgr_next_cnf_id (d_smgr), 4);
   btor_sat_reset (d_smgr);
 }
+
+TEST_F (TestSatMgr, cubes)
+{
+  BtorCubeSolver *cs;
+  int32_t a, b, c;
+
+  btor_opt_set (d_btor, BTOR_OPT_SAT_ENGINE_CUBES, 2);
+  btor_opt_set (d_btor, BTOR_OPT_SAT_ENGINE_N_THREADS, 2);
+  btor_sat_enable_solver (d_smgr);
+  btor_sat_init (d_smgr);
+
+  a = btor_sat_mgr_next_cnf_id (d_smgr);
+  b = btor_sat_mgr_next_cnf_id (d_smgr);
+  c = btor_sat_mgr_next_cnf_id (d_smgr);
+  btor_sat_add (d_smgr, a);
+  btor_sat_add (d_smgr, b);
+  btor_sat_add (d_smgr, 0);
+  btor_sat_add (d_smgr, -a);
+  btor_sat_add (d_smgr, c);
+  btor_sat_add (d_smgr, 0);
+  btor_sat_add (d_smgr, -b);
+  btor_sat_add (d_smgr, c);
+  btor_sat_add (d_smgr, 0);
+
+  /* the wrapped SAT manager only receives the CNF on SAT calls */
+  cs = (BtorCubeSolver *) d_smgr->solver;
+  ASSERT_EQ (cs->nclauses, 0u);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (cs->nclauses, BTOR_COUNT_STACK (cs->clauses));
+  ASSERT_EQ (btor_sat_deref (d_smgr, c), 1);
+  ASSERT_TRUE (btor_sat_deref (d_smgr, a) == 1
+               || btor_sat_deref (d_smgr, b) == 1);
+
+  btor_sat_assume (d_smgr, -c);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_UNSAT);
+  ASSERT_TRUE (btor_sat_failed (d_smgr, -c));
+
+  btor_sat_assume (d_smgr, -a);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_sat_deref (d_smgr, a), -1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, b), 1);
+
+  btor_sat_reset (d_smgr);
+}
+
+#ifdef BTOR_USE_IPASIR
+TEST_F (TestSatMgr, ipasir)
+{
+  int32_t a, b;
+
+  if (!getenv (BTOR_IPASIR_LIB_ENV))
+    GTEST_SKIP () << "environment variable " << BTOR_IPASIR_LIB_ENV
+                  << " not set";
+
+  btor_opt_set (d_btor, BTOR_OPT_SAT_ENGINE, BTOR_SAT_ENGINE_IPASIR);
+  btor_sat_enable_solver (d_smgr);
+  btor_sat_init (d_smgr);
+  ASSERT_TRUE (btor_sat_mgr_has_incremental_support (d_smgr));
+
+  a = btor_sat_mgr_next_cnf_id (d_smgr);
+  b = btor_sat_mgr_next_cnf_id (d_smgr);
+  btor_sat_add (d_smgr, a);
+  btor_sat_add (d_smgr, b);
+  btor_sat_add (d_smgr, 0);
+
+  btor_sat_assume (d_smgr, -a);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_sat_deref (d_smgr, a), -1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, b), 1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, -b), -1);
+
+  btor_sat_assume (d_smgr, -a);
+  btor_sat_assume (d_smgr, -b);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_UNSAT);
+  ASSERT_TRUE (btor_sat_failed (d_smgr, -a) || btor_sat_failed (d_smgr, -b));
+
+  btor_sat_reset (d_smgr);
+}
+#endif
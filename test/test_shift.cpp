@@ -11,7 +11,9 @@
 #include "test.h"
 
 extern "C" {
+#include "btoraigvec.h"
 #include "btorbv.h"
+#include "btorcore.h"
 #include "utils/btorutil.h"
 }
 
@@ -138,8 +140,69 @@ class TestShift : public TestCommon
 
     boolector_delete (btor);
   }
+
+  /* Number of AIG ANDs of a shift of width 'bw'. */
+  uint64_t count_shift_aigs (uint32_t bw, bool is_left)
+  {
+    uint64_t res;
+    Btor *btor;
+    BtorAIGMgr *amgr;
+    BtorAIGVecMgr *avmgr;
+    BtorAIGVec *av1, *av2, *shift;
+
+    btor  = btor_new ();
+    amgr  = btor_get_aig_mgr (btor);
+    avmgr = btor->avmgr;
+    av1   = btor_aigvec_var (avmgr, bw);
+    av2   = btor_aigvec_var (avmgr, bw);
+    res   = amgr->cur_num_aigs;
+    shift = is_left ? btor_aigvec_sll (avmgr, av1, av2)
+                    : btor_aigvec_srl (avmgr, av1, av2);
+    res   = amgr->cur_num_aigs - res;
+    btor_aigvec_release_delete (avmgr, shift);
+    btor_aigvec_release_delete (avmgr, av1);
+    btor_aigvec_release_delete (avmgr, av2);
+    btor_delete (btor);
+    return res;
+  }
 };
 
+TEST_F (TestShift, aig_count)
+{
+  uint32_t widths[] = {3, 32, 33, 48, 64, 65};
+  for (uint32_t bw : widths)
+  {
+    /* k stages, where stage i (shift by n = 2^i) requires 3 ANDs per muxed
+     * bit and 1 AND per zero-filled bit, plus 2 ANDs to fold over-shifting
+     * into the last stage, plus one comparator on the upper bw - k bits */
+    uint64_t n, k, expected = 0;
+    for (k = 0, n = 1; n < bw; k++, n *= 2) expected += 3 * (bw - n) + n;
+    expected += 2 + (bw - k - 1);
+
+    ASSERT_LE (count_shift_aigs (bw, true), expected);
+    ASSERT_LE (count_shift_aigs (bw, false), expected);
+  }
+}
+
+TEST_F (TestShift, aig_count_non_pow2)
+{
+  /* width, number of ANDs and number of ANDs of the previous encoding, which
+   * shifted operands zero-extended to the next power of 2 width by the lower
+   * log2 bits of the shift amount and selected 0 if any upper bit was set */
+  uint64_t counts[][3] = {{3, 14, 15},
+                          {5, 34, 37},
+                          {12, 123, 133},
+                          {33, 496, 527},
+                          {48, 781, 827},
+                          {65, 1170, 1233}};
+  for (auto &c : counts)
+  {
+    ASSERT_EQ (count_shift_aigs (c[0], true), c[1]);
+    ASSERT_EQ (count_shift_aigs (c[0], false), c[1]);
+    ASSERT_LT (c[1], c[2]);
+  }
+}
+
 TEST_F (TestShift, sll_2)
 {
   for (uint32_t i = 0; i < (1u << 2); ++i)